@@ -0,0 +1,273 @@
+// Allocation and I/O accounting for the logging path: allocations, bytes
+// allocated, stdio calls and write syscalls per logged event, for each output
+// type. Fails when an event allocates, so it doubles as a regression check for
+// "no allocations per event".
+//
+// The program defines malloc/calloc/realloc/free and the stdio functions ulog
+// uses itself, which interposes them for the whole process the same way an
+// LD_PRELOAD shim would. Output streams are fopencookie streams whose write
+// callback counts the write syscalls stdio would issue. glibc only.
+//
+// Build (see `zig build bench-alloc` or `just cc-bench-alloc`):
+//   cc -std=c23 -O2 -DULOG_BUILD_DYNAMIC_CONFIG=1 -Iinclude src/ulog.c
+//      bench/ulog_bench_alloc.c -ldl -o ulog_bench_alloc
+
+#define _GNU_SOURCE
+
+#include <dlfcn.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "ulog/ulog.h"
+
+enum {
+    BENCH_EVENTS = 10000,  // Events logged per measurement
+    BENCH_WARMUP = 100,    // First events may set up stdio buffers, tz data
+};
+
+typedef struct {
+    uint64_t allocs;
+    uint64_t bytes;
+    uint64_t frees;
+    uint64_t stdio_calls;
+    uint64_t writes;
+    uint64_t written;
+} bench_counters;
+
+static bench_counters counters;
+static bool counting;
+
+// Interposed allocator
+// ================
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+void *malloc(size_t size) {
+    if (counting) {
+        counters.allocs++;
+        counters.bytes += size;
+    }
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    if (counting) {
+        counters.allocs++;
+        counters.bytes += count * size;
+    }
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    if (counting) {
+        counters.allocs++;
+        counters.bytes += size;
+    }
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+    if (counting && ptr != nullptr) {
+        counters.frees++;
+    }
+    __libc_free(ptr);
+}
+
+// Interposed stdio
+// ================
+
+#define BENCH_REAL(NAME) ((__typeof__(&NAME))dlsym(RTLD_NEXT, #NAME))
+
+size_t fwrite(const void *restrict data, size_t size, size_t count,
+              FILE *restrict stream) {
+    static __typeof__(&fwrite) real;
+    real = real != nullptr ? real : BENCH_REAL(fwrite);
+    counters.stdio_calls += counting;
+    return real(data, size, count, stream);
+}
+
+int fputs(const char *restrict str, FILE *restrict stream) {
+    static __typeof__(&fputs) real;
+    real = real != nullptr ? real : BENCH_REAL(fputs);
+    counters.stdio_calls += counting;
+    return real(str, stream);
+}
+
+int fputc(int c, FILE *stream) {
+    static __typeof__(&fputc) real;
+    real = real != nullptr ? real : BENCH_REAL(fputc);
+    counters.stdio_calls += counting;
+    return real(c, stream);
+}
+
+int vfprintf(FILE *restrict stream, const char *restrict format,
+             va_list args) {
+    static __typeof__(&vfprintf) real;
+    real = real != nullptr ? real : BENCH_REAL(vfprintf);
+    counters.stdio_calls += counting;
+    return real(stream, format, args);
+}
+
+int fflush(FILE *stream) {
+    static __typeof__(&fflush) real;
+    real = real != nullptr ? real : BENCH_REAL(fflush);
+    counters.stdio_calls += counting;
+    return real(stream);
+}
+
+// Counting streams
+// ================
+
+static ssize_t counting_write(void *cookie, const char *data, size_t size) {
+    (void)cookie;
+    (void)data;
+    if (counting) {
+        counters.writes++;
+        counters.written += size;
+    }
+    return (ssize_t)size;  // Discard, like /dev/null
+}
+
+static FILE *counting_stream(int buffering) {
+    auto stream = fopencookie(nullptr, "w",
+                              (cookie_io_functions_t){.write = counting_write});
+    if (stream != nullptr) {
+        setvbuf(stream, nullptr, buffering, BUFSIZ);
+    }
+    return stream;
+}
+
+// Cases
+// ================
+
+typedef enum {
+    CASE_STDOUT,
+    CASE_FILE,
+    CASE_JSON,
+    CASE_BINARY,
+    CASE_HANDLER,
+    CASE_TOTAL,
+} bench_case;
+
+static const char *const case_names[CASE_TOTAL] = {
+    "stdout (line buffered)", "file", "json file", "binary file",
+    "no-op handler"};
+
+static void null_handler(ulog_event *ev, void *arg) {
+    (void)ev;
+    (void)arg;
+}
+
+static void log_events(int count) {
+    for (auto i = 0; i < count; i++) {
+        ulog_info("request %d took %.3f ms", i, 1.5);
+        ulog_topic_warn("net", "retry %d of %s", i, "upstream");
+        ulog_kv(ULOG_LEVEL_INFO, "served", "user", "jane", "status", 200);
+    }
+}
+
+static bool run_case(FILE *out, bench_case c, FILE *stream) {
+    auto id = ULOG_OUTPUT_INVALID;
+    switch (c) {
+    case CASE_FILE:
+        id = ulog_output_add_file(stream, ULOG_LEVEL_TRACE);
+        break;
+    case CASE_JSON:
+        id = ulog_output_add_json_file(stream, ULOG_LEVEL_TRACE);
+        break;
+    case CASE_BINARY:
+        id = ulog_output_add_binary_file(stream, ULOG_LEVEL_TRACE);
+        break;
+    case CASE_HANDLER:
+        id = ulog_output_add(null_handler, nullptr, ULOG_LEVEL_TRACE);
+        break;
+    default:
+        break;
+    }
+    if (c != CASE_STDOUT && id == ULOG_OUTPUT_INVALID) {
+        fprintf(stderr, "cannot add output for %s\n", case_names[c]);
+        return false;
+    }
+    (void)ulog_output_level_set(ULOG_OUTPUT_STDOUT, c == CASE_STDOUT
+                                                        ? ULOG_LEVEL_TRACE
+                                                        : ULOG_LEVEL_FATAL);
+
+    log_events(BENCH_WARMUP);
+    counters = (bench_counters){0};
+    counting = true;
+    log_events(BENCH_EVENTS);
+    counting = false;
+    auto events = (double)BENCH_EVENTS * 3;
+
+    if (id != ULOG_OUTPUT_INVALID) {
+        (void)ulog_output_remove(id);
+    }
+    fprintf(out, "| %-22s | %9.3f | %9.1f | %9.3f | %9.3f | %9.1f |\n",
+            case_names[c], (double)counters.allocs / events,
+            (double)counters.bytes / events,
+            (double)counters.stdio_calls / events,
+            (double)counters.writes / events,
+            (double)counters.written / events);
+    return counters.allocs == 0;
+}
+
+int main() {
+    // Results go to the real stdout, the stdout output to a counting stream
+    auto out        = stdout;
+    auto log_stdout = counting_stream(_IOLBF);
+    auto log_file   = counting_stream(_IOFBF);
+    if (log_stdout == nullptr || log_file == nullptr) {
+        fprintf(stderr, "cannot create counting streams\n");
+        return 1;
+    }
+    stdout = log_stdout;
+
+    (void)ulog_time_config(true);
+    (void)ulog_topic_config(true);
+
+    // Topic registration: the topic and its name share one allocation
+    counters = (bench_counters){0};
+    counting = true;
+    auto topic = ulog_topic_add("net", ULOG_OUTPUT_ALL, ULOG_LEVEL_TRACE);
+    counting   = false;
+    auto topic_allocs = counters.allocs;
+
+    fprintf(out, "Per event, %d events of 3 kinds (text, topic, fields)\n\n",
+            BENCH_EVENTS);
+    static constexpr char row[] =
+        "| %-22s | %9s | %9s | %9s | %9s | %9s |\n";
+    fprintf(out, row, "output", "allocs", "bytes", "stdio", "writes",
+            "written");
+    fprintf(out, row, "----------------------", "---------", "---------",
+            "---------", "---------", "---------");
+
+    auto ok = topic >= 0;
+    for (auto c = 0; c < CASE_TOTAL; c++) {
+        if (!run_case(out, (bench_case)c, c == CASE_STDOUT ? nullptr
+                                                           : log_file)) {
+            fprintf(out, "FAIL: %s allocates per event\n", case_names[c]);
+            ok = false;
+        }
+    }
+
+    fprintf(out, "\nulog_topic_add: %llu allocation(s)\n",
+            (unsigned long long)topic_allocs);
+    if (topic_allocs != 1) {
+        fprintf(out, "FAIL: expected one allocation per topic\n");
+        ok = false;
+    }
+
+    (void)ulog_cleanup();
+    stdout = out;
+    fclose(log_stdout);
+    fclose(log_file);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+// Filtered-call cost benchmark: ns per rejected `ulog_trace` /
+// `ulog_topic_trace` and per accepted call to a no-op output, with and without
+// a lock function. Built once per `ULOG_BUILD_*` combination; each binary
+// prints its rows of one comparison table.
+//
+// Build (see `zig build bench-disabled` or `just cc-bench-disabled`):
+//   cc -std=c23 -O2 -DBENCH_CONFIG='"default"' -DULOG_BUILD_EXTRA_OUTPUTS=1
+//      -Iinclude src/ulog.c bench/ulog_bench_disabled.c -lpthread
+//      -o ulog_bench_disabled
+//
+// Usage: ulog_bench_disabled [--header]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "ulog/ulog.h"
+
+#ifndef BENCH_CONFIG
+#define BENCH_CONFIG "custom"
+#endif
+
+// Whether topic calls are compiled in for this configuration
+#if defined(ULOG_BUILD_DISABLED) && ULOG_BUILD_DISABLED == 1
+#define BENCH_TOPICS 1
+#elif defined(ULOG_BUILD_DYNAMIC_CONFIG) && ULOG_BUILD_DYNAMIC_CONFIG == 1
+#define BENCH_TOPICS 1
+#elif defined(ULOG_BUILD_TOPICS_MODE) && ULOG_BUILD_TOPICS_MODE != 0
+#define BENCH_TOPICS 1
+#else
+#define BENCH_TOPICS 0
+#endif
+
+enum {
+    BENCH_REJECTED_CALLS = 4000000,
+    BENCH_ACCEPTED_CALLS = 1000000,
+};
+
+static volatile int bench_value = 42;
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+[[maybe_unused]] static void null_handler(ulog_event *ev, void *arg) {
+    (void)ev;
+    (void)arg;
+}
+
+static ulog_status mutex_lock_fn(bool lock, void *arg) {
+    auto mutex = (pthread_mutex_t *)arg;
+    auto rc    = lock ? pthread_mutex_lock(mutex) : pthread_mutex_unlock(mutex);
+    return rc == 0 ? ULOG_STATUS_OK : ULOG_STATUS_ERROR;
+}
+
+static double bench_rejected() {
+    auto start = now_sec();
+    for (auto i = 0; i < BENCH_REJECTED_CALLS; i++) {
+        ulog_trace("rejected %d", bench_value);
+    }
+    return (now_sec() - start) * 1e9 / BENCH_REJECTED_CALLS;
+}
+
+static double bench_topic_rejected() {
+    auto start = now_sec();
+    for (auto i = 0; i < BENCH_REJECTED_CALLS; i++) {
+        ulog_topic_trace("bench", "rejected %d", bench_value);
+    }
+    return (now_sec() - start) * 1e9 / BENCH_REJECTED_CALLS;
+}
+
+static double bench_accepted() {
+    auto start = now_sec();
+    for (auto i = 0; i < BENCH_ACCEPTED_CALLS; i++) {
+        ulog_info("accepted %d", bench_value);
+    }
+    return (now_sec() - start) * 1e9 / BENCH_ACCEPTED_CALLS;
+}
+
+static void print_row(const char *lock) {
+    char topic[16] = "-";
+    if (BENCH_TOPICS) {
+        snprintf(topic, sizeof(topic), "%.1f", bench_topic_rejected());
+    }
+    auto rejected = bench_rejected();
+    auto accepted = bench_accepted();
+    printf("| %-16s | %-4s | %12.1f | %12s | %12.1f |\n", BENCH_CONFIG, lock,
+           rejected, topic, accepted);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--header") == 0) {
+        static constexpr char row[] = "| %-16s | %-4s | %12s | %12s | %12s |\n";
+        printf(row, "config", "lock", "rejected ns", "topic rej ns",
+               "accepted ns");
+        printf(row, "----------------", "----", "------------", "------------",
+               "------------");
+    }
+
+    // Only the no-op output accepts INFO; TRACE is filtered everywhere
+#if defined(ULOG_BUILD_EXTRA_OUTPUTS) && ULOG_BUILD_EXTRA_OUTPUTS > 0 ||     \
+    defined(ULOG_BUILD_DYNAMIC_CONFIG) && ULOG_BUILD_DYNAMIC_CONFIG == 1
+    if (ulog_output_add(null_handler, nullptr, ULOG_LEVEL_INFO) ==
+        ULOG_OUTPUT_INVALID) {
+        fprintf(stderr, "cannot add output\n");
+        return 1;
+    }
+#endif
+    (void)ulog_output_level_set(ULOG_OUTPUT_STDOUT, ULOG_LEVEL_FATAL);
+#if BENCH_TOPICS
+    (void)ulog_topic_add("bench", ULOG_OUTPUT_ALL, ULOG_LEVEL_INFO);
+#endif
+#if defined(ULOG_BUILD_CALLSITE_REGISTRY) && ULOG_BUILD_CALLSITE_REGISTRY == 1
+    // TRACE sites switched off: a rejected call is one load at the call site
+    if (ulog_callsite_disable("*", ULOG_LEVEL_TRACE) != ULOG_STATUS_OK) {
+        fprintf(stderr, "no registered call sites\n");
+        return 1;
+    }
+#endif
+
+    print_row("no");
+
+    static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    (void)ulog_lock_set_fn(mutex_lock_fn, &mutex);
+    print_row("yes");
+    (void)ulog_lock_set_fn(nullptr, nullptr);
+
+    (void)ulog_cleanup();
+    return 0;
+}
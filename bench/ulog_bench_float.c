@@ -0,0 +1,227 @@
+// Floating point formatting benchmark: ulog built-in %f/%e/%g conversions
+// vs libc snprintf. Random doubles (bit patterns, decimals, rounding ties,
+// powers of ten) are checked to produce identical output at every precision
+// before timing.
+//
+// Build (see `zig build bench-float` or `just cc-bench-float`):
+//   cc -std=c23 -O2 -DULOG_TESTING -DULOG_BUILD_FAST_FORMAT=1 -Iinclude
+//      src/ulog.c bench/ulog_bench_float.c -o ulog_bench_float
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "ulog/ulog.h"
+
+// Exported from src/ulog.c when built with ULOG_TESTING
+int fmt_vformat(char *out, size_t size, const char *format, va_list *args);
+
+enum {
+    BENCH_BUF_SIZE      = 512,
+    BENCH_CHECKS        = 300000,   // Random values compared with libc
+    BENCH_ITERATIONS    = 1000000,  // Calls per measurement
+    BENCH_PRECISION_MAX = 20,
+};
+
+static int fast_format(char *out, size_t size, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    auto written = fmt_vformat(out, size, format, &args);
+    va_end(args);
+    return written;
+}
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t rng_next() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double from_bits(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static double rng_double() {
+    static const double specials[] = {0.0,    -0.0,   0.5,    0.125,  2.5,
+                                      0.0625, 1e-5,   9.5,    99.95,  1e21,
+                                      1e22,   1e-300, 5e-324, 1.5e308};
+    // Exponents near zero are what logs print; the rest covers the edges
+    auto exponent = (uint64_t)(1023 - 40 + rng_next() % 100);
+    switch (rng_next() % 8) {
+    case 0:
+        return from_bits(rng_next());  // Any pattern, including inf and nan
+    case 1:
+        return from_bits((exponent << 52) | (rng_next() >> 12));
+    case 2: {
+        // Short decimals such as 12.345
+        auto scale = (double)(1ULL << (rng_next() % 4 * 3));
+        return (double)(int64_t)(rng_next() % 2000001 - 1000000) / scale;
+    }
+    case 3:
+        // Exact binary fractions hit rounding ties
+        return (double)(int64_t)(rng_next() % 20001 - 10000) / 64.0;
+    case 4: {
+        // Values right next to powers of ten
+        auto value = 1.0;
+        for (auto i = rng_next() % 25; i > 0; i--) {
+            value *= 10.0;
+        }
+        if (rng_next() % 2) {
+            value = 1.0 / value;
+        }
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return from_bits(bits + rng_next() % 3 - 1);
+    }
+    case 5:
+        return (double)(int64_t)rng_next();
+    case 6:
+        return -from_bits((exponent << 52) | (rng_next() >> 12));
+    default:
+        return specials[rng_next() % (sizeof(specials) / sizeof(specials[0]))];
+    }
+}
+
+/// @brief Builds a random conversion such as "%-+012.3e"
+static void random_spec(char *spec, size_t size) {
+    static constexpr char convs[]    = "fFeEgG";
+    static const char *const flags[] = {"", "-", "0", "+", " ", "-0", "+0",
+                                        "- ", "0 "};
+
+    auto conv = convs[rng_next() % (sizeof(convs) - 1)];
+    auto flag = flags[rng_next() % (sizeof(flags) / sizeof(flags[0]))];
+    auto len  = rng_next() % 4 == 0 ? "l" : "";
+    char width[8]     = "";
+    char precision[8] = "";
+    if (rng_next() % 3 == 0) {
+        snprintf(width, sizeof(width), "%d", (int)(rng_next() % 30));
+    }
+    if (rng_next() % 4 != 0) {
+        snprintf(precision, sizeof(precision), ".%d",
+                 (int)(rng_next() % (BENCH_PRECISION_MAX + 1)));
+    }
+    snprintf(spec, size, "<%%%s%s%s%s%c>", flag, width, precision, len, conv);
+}
+
+static bool check_one(const char *format, double value, size_t size) {
+    char fast[BENCH_BUF_SIZE];
+    char libc[BENCH_BUF_SIZE];
+    memset(fast, 'F', sizeof(fast));
+    memset(libc, 'F', sizeof(libc));
+    auto a = fast_format(fast, size, format, value);
+    auto b = snprintf(libc, size, format, value);
+    if (a == b && (size == 0 || strcmp(fast, libc) == 0)) {
+        return true;
+    }
+    fprintf(stderr, "mismatch: format \"%s\" value %a size %zu\n", format,
+            value, size);
+    fprintf(stderr, "  ulog: %d \"%s\"\n  libc: %d \"%s\"\n", a,
+            size > 0 ? fast : "", b, size > 0 ? libc : "");
+    return false;
+}
+
+static bool differential_check() {
+    char spec[32];
+    char format[64];
+
+    // Every conversion and precision on the same value set
+    static constexpr char convs[] = "fFeEgG";
+    for (auto i = 0; i < BENCH_CHECKS / 10; i++) {
+        auto value = rng_double();
+        for (size_t c = 0; c < sizeof(convs) - 1; c++) {
+            for (auto precision = 0; precision <= BENCH_PRECISION_MAX;
+                 precision++) {
+                snprintf(format, sizeof(format), "%%.%d%c", precision,
+                         convs[c]);
+                if (!check_one(format, value, BENCH_BUF_SIZE)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Random flags, widths and truncating sizes
+    for (auto i = 0; i < BENCH_CHECKS; i++) {
+        random_spec(spec, sizeof(spec));
+        snprintf(format, sizeof(format), "v=%s;", spec);
+        auto value   = rng_double();
+        size_t sizes[] = {BENCH_BUF_SIZE, 1 + rng_next() % 24, 0};
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            if (!check_one(format, value, sizes[s])) {
+                return false;
+            }
+        }
+    }
+
+    // Star width and precision mixed with other conversions
+    char fast[BENCH_BUF_SIZE];
+    char libc[BENCH_BUF_SIZE];
+    auto a = fast_format(fast, sizeof(fast), "%s=%*.*f %d %-8.3g|%Le", "t", 10,
+                         2, 3.14159, 7, 1e-7, (long double)2.5);
+    auto b = snprintf(libc, sizeof(libc), "%s=%*.*f %d %-8.3g|%Le", "t", 10, 2,
+                      3.14159, 7, 1e-7, (long double)2.5);
+    if (a != b || strcmp(fast, libc) != 0) {
+        fprintf(stderr, "mixed mismatch: \"%s\" vs \"%s\"\n", fast, libc);
+        return false;
+    }
+    return true;
+}
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static volatile int bench_sink;
+
+#define BENCH_CASE(NAME, FORMAT, ...)                                          \
+    do {                                                                       \
+        char buf[BENCH_BUF_SIZE];                                              \
+        auto start = now_sec();                                                \
+        for (auto i = 0; i < BENCH_ITERATIONS; i++) {                          \
+            bench_sink += snprintf(buf, sizeof(buf), FORMAT, __VA_ARGS__);     \
+        }                                                                      \
+        auto libc_ns = (now_sec() - start) * 1e9 / BENCH_ITERATIONS;           \
+        start        = now_sec();                                              \
+        for (auto i = 0; i < BENCH_ITERATIONS; i++) {                          \
+            bench_sink += fast_format(buf, sizeof(buf), FORMAT, __VA_ARGS__);  \
+        }                                                                      \
+        auto ulog_ns = (now_sec() - start) * 1e9 / BENCH_ITERATIONS;           \
+        printf("| %-14s | %9.1f | %9.1f | %6.2fx |\n", NAME, libc_ns, ulog_ns, \
+               libc_ns / ulog_ns);                                             \
+    } while (0)
+
+int main() {
+    if (!differential_check()) {
+        return 1;
+    }
+
+    printf("| %-14s | %9s | %9s | %7s |\n", "case", "libc ns", "ulog ns",
+           "speedup");
+    printf("| %-14s | %9s | %9s | %7s |\n", "--------------", "---------",
+           "---------", "-------");
+
+    BENCH_CASE("default %f", "%f", 3.14159265358979);
+    BENCH_CASE("latency ms", "took %.3f ms", 12.3456);
+    BENCH_CASE("percent", "cpu %5.1f%%", 87.25);
+    BENCH_CASE("large %f", "%.2f", 123456789.125);
+    BENCH_CASE("scientific", "%.6e", 6.02214076e23);
+    BENCH_CASE("small %e", "%e", 1.602176634e-19);
+    BENCH_CASE("default %g", "%g", 0.000123456);
+    BENCH_CASE("precise %g", "%.17g", 0.1);
+    BENCH_CASE("telemetry", "t=%.3f x=%.4f y=%.4f v=%g", 1712.25, -0.5,
+               42.125, 9.81);
+
+    return 0;
+}
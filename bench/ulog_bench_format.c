@@ -0,0 +1,256 @@
+// printf engine benchmark: ulog built-in formatter, with and without a
+// per-call-site format cache, vs libc vsnprintf. Random conversions are
+// checked to produce identical output (including truncation and return
+// values) before timing.
+//
+// Build (see `zig build bench-format` or `just cc-bench-format`):
+//   cc -std=c23 -O2 -DULOG_TESTING -DULOG_BUILD_FAST_FORMAT=1
+//      -DULOG_BUILD_FORMAT_CACHE=1 -Iinclude src/ulog.c
+//      bench/ulog_bench_format.c -o ulog_bench_format
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "ulog/ulog.h"
+
+// Exported from src/ulog.c when built with ULOG_TESTING
+int fmt_vformat(char *out, size_t size, const char *format, va_list *args);
+int fmt_cache_vsnprintf(ulog_format_cache *cache, char *out, size_t size,
+                        const char *format, va_list args);
+
+enum {
+    BENCH_BUF_SIZE   = 256,
+    BENCH_CHECKS     = 200000,   // Random conversions compared with libc
+    BENCH_ITERATIONS = 2000000,  // Calls per measurement
+};
+
+static int fast_format(char *out, size_t size, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    auto written = fmt_vformat(out, size, format, &args);
+    va_end(args);
+    return written;
+}
+
+static int cached_format(ulog_format_cache *cache, char *out, size_t size,
+                         const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    auto written = fmt_cache_vsnprintf(cache, out, size, format, args);
+    va_end(args);
+    return written;
+}
+
+/// @brief Runs `format` through the plain engine, a fresh cache (compile and
+/// run) and the compiled cache, and compares each result with libc
+#define CHECK_FORMATS(FAST, LIBC, SIZE, FORMAT, ARG)                           \
+    do {                                                                       \
+        ulog_format_cache cache = {0};                                         \
+        char cached[BENCH_BUF_SIZE];                                           \
+        b = snprintf(LIBC, SIZE, FORMAT, ARG);                                 \
+        a = fast_format(FAST, SIZE, FORMAT, ARG);                              \
+        for (auto run = 0; run < 2 && a == b; run++) {                         \
+            memset(cached, 'F', sizeof(cached));                               \
+            auto c = cached_format(&cache, cached, SIZE, FORMAT, ARG);         \
+            if (c != b || (SIZE > 0 && strcmp(cached, LIBC) != 0)) {           \
+                a = -2;                                                        \
+            }                                                                  \
+        }                                                                      \
+    } while (0)
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t rng_next() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static uint64_t rng_value() {
+    // Mix of small, boundary and full range values
+    switch (rng_next() % 4) {
+    case 0:
+        return rng_next() % 200;
+    case 1:
+        return 0 - (rng_next() % 200);
+    case 2:
+        return (uint64_t)1 << (rng_next() % 64);
+    default:
+        return rng_next();
+    }
+}
+
+/// @brief Builds a random conversion such as "%-08.3llx"
+static char random_spec(char *spec, size_t size) {
+    static constexpr char convs[]    = "diuxXocsp";
+    static const char *const lens[]  = {"", "hh", "h", "l", "ll", "z", "j", "t"};
+    static const char *const flags[] = {"", "-", "0", "+", " ", "-0", "+0",
+                                        "- ", "+ ", "-+"};
+
+    auto conv   = convs[rng_next() % (sizeof(convs) - 1)];
+    auto len    = (conv == 'c' || conv == 's' || conv == 'p')
+                      ? ""
+                      : lens[rng_next() % (sizeof(lens) / sizeof(lens[0]))];
+    auto flag   = flags[rng_next() % (sizeof(flags) / sizeof(flags[0]))];
+    char width[8]     = "";
+    char precision[8] = "";
+    if (rng_next() % 2) {
+        snprintf(width, sizeof(width), "%d", (int)(rng_next() % 25));
+    }
+    if (rng_next() % 3 == 0) {
+        snprintf(precision, sizeof(precision), ".%d", (int)(rng_next() % 25));
+    }
+    snprintf(spec, size, "<%%%s%s%s%s%c>", flag, width, precision, len,
+             conv);
+    return conv;
+}
+
+static bool check_one(char *fast, char *libc, size_t size, const char *format,
+                      char conv, uint64_t value, const char *str) {
+    int a = 0;
+    int b = 0;
+    switch (conv) {
+    case 's':
+        CHECK_FORMATS(fast, libc, size, format, str);
+        break;
+    case 'p':
+        CHECK_FORMATS(fast, libc, size, format, (void *)(uintptr_t)value);
+        break;
+    default:
+        // Integers are passed as 64-bit values; the length modifier picks
+        // how many bits are read, so only use it for 64-bit lengths.
+        if (strpbrk(format, "lzjt") != nullptr) {
+            CHECK_FORMATS(fast, libc, size, format, (long long)value);
+        } else {
+            CHECK_FORMATS(fast, libc, size, format, (int)value);
+        }
+        break;
+    }
+    return a == b && (size == 0 || strcmp(fast, libc) == 0);
+}
+
+static bool differential_check() {
+    static const char *const strings[] = {"", "a", "hello", "hello world",
+                                          "tab\tand\nnewline", nullptr};
+    char format[64];
+    char spec[32];
+    char fast[BENCH_BUF_SIZE];
+    char libc[BENCH_BUF_SIZE];
+
+    for (auto i = 0; i < BENCH_CHECKS; i++) {
+        auto conv = random_spec(spec, sizeof(spec));
+        snprintf(format, sizeof(format), "x=%s%%y", spec);
+        auto value = rng_value();
+        auto str   = strings[rng_next() % (sizeof(strings) / sizeof(strings[0]))];
+#ifndef __GLIBC__
+        str = (str == nullptr) ? "(null)" : str;  // Only glibc defines it
+#endif
+        // Full buffer and a few truncating sizes
+        const size_t sizes[] = {sizeof(fast), 1 + rng_next() % 16, 0};
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            memset(fast, 'F', sizeof(fast));
+            memset(libc, 'F', sizeof(libc));
+            if (!check_one(fast, libc, sizes[s], format, conv, value, str)) {
+                fprintf(stderr, "mismatch: format \"%s\" size %zu\n", format,
+                        sizes[s]);
+                fprintf(stderr, "  ulog: \"%s\"\n  libc: \"%s\"\n", fast,
+                        libc);
+                return false;
+            }
+        }
+    }
+
+    // Fallback after a partly consumed argument list
+    char fast_fb[BENCH_BUF_SIZE];
+    char libc_fb[BENCH_BUF_SIZE];
+    auto a = fast_format(fast_fb, sizeof(fast_fb), "%d %s %#x %d %5.2f %s", 1,
+                         "two", 3, 4, 5.0, "six");
+    auto b = snprintf(libc_fb, sizeof(libc_fb), "%d %s %#x %d %5.2f %s", 1,
+                      "two", 3, 4, 5.0, "six");
+    if (a != b || strcmp(fast_fb, libc_fb) != 0) {
+        fprintf(stderr, "fallback mismatch: \"%s\" vs \"%s\"\n", fast_fb,
+                libc_fb);
+        return false;
+    }
+
+    // Uncacheable formats: libc conversion and too many conversions
+    ulog_format_cache cache_fb = {0};
+    ulog_format_cache cache_long = {0};
+    for (auto run = 0; run < 2; run++) {
+        a = cached_format(&cache_fb, fast_fb, sizeof(fast_fb), "%d %#x", 7,
+                          255);
+        b = snprintf(libc_fb, sizeof(libc_fb), "%d %#x", 7, 255);
+        if (a != b || strcmp(fast_fb, libc_fb) != 0) {
+            fprintf(stderr, "cache fallback mismatch: \"%s\"\n", fast_fb);
+            return false;
+        }
+        a = cached_format(&cache_long, fast_fb, sizeof(fast_fb),
+                          "%d%d%d%d%d%d%d%d%d%%", 1, 2, 3, 4, 5, 6, 7, 8, 9);
+        if (a != 10 || strcmp(fast_fb, "123456789%") != 0) {
+            fprintf(stderr, "cache long mismatch: \"%s\"\n", fast_fb);
+            return false;
+        }
+    }
+    return true;
+}
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static volatile int bench_sink;
+
+#define BENCH_CASE(NAME, FORMAT, ...)                                          \
+    do {                                                                       \
+        char buf[BENCH_BUF_SIZE];                                              \
+        auto start = now_sec();                                                \
+        for (auto i = 0; i < BENCH_ITERATIONS; i++) {                          \
+            bench_sink += snprintf(buf, sizeof(buf), FORMAT, __VA_ARGS__);     \
+        }                                                                      \
+        auto libc_ns = (now_sec() - start) * 1e9 / BENCH_ITERATIONS;           \
+        start        = now_sec();                                              \
+        for (auto i = 0; i < BENCH_ITERATIONS; i++) {                          \
+            bench_sink += fast_format(buf, sizeof(buf), FORMAT, __VA_ARGS__);  \
+        }                                                                      \
+        auto ulog_ns = (now_sec() - start) * 1e9 / BENCH_ITERATIONS;           \
+        ulog_format_cache cache = {0};                                         \
+        start                   = now_sec();                                   \
+        for (auto i = 0; i < BENCH_ITERATIONS; i++) {                          \
+            bench_sink +=                                                      \
+                cached_format(&cache, buf, sizeof(buf), FORMAT, __VA_ARGS__);  \
+        }                                                                      \
+        auto cached_ns = (now_sec() - start) * 1e9 / BENCH_ITERATIONS;         \
+        printf("| %-14s | %9.1f | %9.1f | %9.1f | %6.2fx |\n", NAME, libc_ns,  \
+               ulog_ns, cached_ns, libc_ns / cached_ns);                       \
+    } while (0)
+
+int main() {
+    if (!differential_check()) {
+        return 1;
+    }
+
+    printf("| %-14s | %9s | %9s | %9s | %7s |\n", "case", "libc ns", "ulog ns",
+           "cached ns", "speedup");
+    printf("| %-14s | %9s | %9s | %9s | %7s |\n", "--------------",
+           "---------", "---------", "---------", "-------");
+
+    BENCH_CASE("int", "value %d", 123456);
+    BENCH_CASE("ints", "%d %d %d %d", -1, 42, 100000, -987654321);
+    BENCH_CASE("uint64 hex", "id=%016llx", 0x1234abcdULL * 0x9e37ULL);
+    BENCH_CASE("string", "user %s logged in", "jane");
+    BENCH_CASE("padded", "[%-10s] %5u%%", "worker", 87U);
+    BENCH_CASE("pointer", "object at %p", (void *)&bench_sink);
+    BENCH_CASE("mixed", "%s:%d req=%u size=%zu ptr=%p", "conn.c", 418, 77U,
+               (size_t)4096, (void *)&bench_sink);
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+// JSON string escaping benchmark: ulog SIMD kernel vs a naive per-byte
+// escaper. Both are checked to produce identical output before timing.
+//
+// Build (see `zig build bench-json` or `just cc-bench-json`):
+//   cc -std=c23 -O2 -march=native -DULOG_TESTING -DULOG_BUILD_EXTRA_OUTPUTS=1
+//      -DULOG_BUILD_JSON_OUTPUT=1 -Iinclude src/ulog.c
+//      bench/ulog_bench_json.c -o ulog_bench_json
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ulog/ulog.h"
+
+// Exported from src/ulog.c when built with ULOG_TESTING
+size_t json_escape(char *out, size_t out_size, const char *str, size_t size,
+                   size_t *consumed);
+
+enum {
+    BENCH_OUT_SIZE   = 6 * 4096,  // Worst case: every byte becomes \u00XX
+    BENCH_TOTAL_SIZE = 256 * 1024 * 1024,  // Bytes escaped per measurement
+};
+
+typedef struct {
+    const char *name;
+    size_t size;
+    unsigned escape_per_mille;  // Share of bytes that need escaping
+} bench_case;
+
+static size_t naive_escape(char *out, size_t out_size, const char *str,
+                           size_t size) {
+    static constexpr char hex[] = "0123456789abcdef";
+    size_t written              = 0;
+    size_t copied               = 0;  // Bytes copied since the last escape
+    for (size_t i = 0; i < size; i++) {
+        auto c   = (unsigned char)str[i];
+        char esc = 0;
+        switch (c) {
+        case '"':
+            esc = '"';
+            break;
+        case '\\':
+            esc = '\\';
+            break;
+        case '\n':
+            esc = 'n';
+            break;
+        case '\r':
+            esc = 'r';
+            break;
+        case '\t':
+            esc = 't';
+            break;
+        case '\b':
+            esc = 'b';
+            break;
+        case '\f':
+            esc = 'f';
+            break;
+        default:
+            break;
+        }
+        if (esc != 0) {
+            if (out_size - written < 2) {
+                break;
+            }
+            out[written++] = '\\';
+            out[written++] = esc;
+            copied         = 0;
+        } else if (c < 0x20) {
+            if (out_size - written < 6) {
+                break;
+            }
+            memcpy(out + written, "\\u00", 4);
+            out[written + 4] = hex[c >> 4];
+            out[written + 5] = hex[c & 0xf];
+            written += 6;
+            copied = 0;
+        } else {
+            if (out_size - written < 1) {
+                // Drop the start of a character that does not fit whole
+                for (size_t k = 0; k < 3 && copied > 0 &&
+                                   ((unsigned char)str[i - k] & 0xC0) == 0x80;
+                     k++) {
+                    written--;
+                    copied--;
+                }
+                break;
+            }
+            out[written++] = (char)c;
+            copied++;
+        }
+    }
+    return written;
+}
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t rng_next() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void fill_input(char *buf, size_t size, unsigned escape_per_mille) {
+    // Bytes of multibyte UTF-8 characters, so that cuts land inside them
+    static constexpr char text[] = "abcdefghijklmnopqrstuvwxyz0123456789 .,:"
+                                   "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80";
+    static constexpr char special[] = "\"\\\n\t\x01\x1f";
+    for (size_t i = 0; i < size; i++) {
+        if (rng_next() % 1000 < escape_per_mille) {
+            buf[i] = special[rng_next() % (sizeof(special) - 1)];
+        } else {
+            buf[i] = text[rng_next() % (sizeof(text) - 1)];
+        }
+    }
+}
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool check_equal(const char *in, size_t size, char *out_a,
+                        char *out_b) {
+    // Full output and a few truncated output sizes
+    const size_t limits[] = {BENCH_OUT_SIZE, size / 2 + 1, 7, 1};
+    for (size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+        auto a = json_escape(out_a, limits[i], in, size, nullptr);
+        auto b = naive_escape(out_b, limits[i], in, size);
+        if (a != b || memcmp(out_a, out_b, a) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static volatile size_t bench_sink;
+
+int main() {
+    static const bench_case cases[] = {
+        {"short clean", 48, 0},   {"short mixed", 48, 20},
+        {"medium clean", 256, 0}, {"medium mixed", 256, 20},
+        {"long clean", 4096, 0},  {"long mixed", 4096, 20},
+        {"long dense", 4096, 200},
+    };
+
+    auto in    = (char *)malloc(4096);
+    auto out_a = (char *)malloc(BENCH_OUT_SIZE);
+    auto out_b = (char *)malloc(BENCH_OUT_SIZE);
+    if (in == nullptr || out_a == nullptr || out_b == nullptr) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    // Differential check on random inputs of every length up to 300 bytes
+    for (size_t len = 0; len <= 300; len++) {
+        for (auto round = 0; round < 50; round++) {
+            fill_input(in, len, (unsigned)(rng_next() % 300));
+            if (!check_equal(in, len, out_a, out_b)) {
+                fprintf(stderr, "mismatch: length %zu\n", len);
+                return 1;
+            }
+        }
+    }
+
+    printf("| %-13s | %6s | %12s | %12s | %7s |\n", "case", "bytes",
+           "naive MB/s", "ulog MB/s", "speedup");
+    printf("| %-13s | %6s | %12s | %12s | %7s |\n", "-------------",
+           "------", "------------", "------------", "-------");
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        auto bc = &cases[c];
+        fill_input(in, bc->size, bc->escape_per_mille);
+        if (!check_equal(in, bc->size, out_a, out_b)) {
+            fprintf(stderr, "mismatch: %s\n", bc->name);
+            return 1;
+        }
+
+        auto iterations = BENCH_TOTAL_SIZE / bc->size;
+
+        auto start = now_sec();
+        for (size_t i = 0; i < iterations; i++) {
+            bench_sink += naive_escape(out_b, BENCH_OUT_SIZE, in, bc->size);
+        }
+        auto naive_sec = now_sec() - start;
+
+        start = now_sec();
+        for (size_t i = 0; i < iterations; i++) {
+            bench_sink +=
+                json_escape(out_a, BENCH_OUT_SIZE, in, bc->size, nullptr);
+        }
+        auto ulog_sec = now_sec() - start;
+
+        auto mb = (double)(iterations * bc->size) / (1024.0 * 1024.0);
+        printf("| %-13s | %6zu | %12.1f | %12.1f | %6.2fx |\n", bc->name,
+               bc->size, mb / naive_sec, mb / ulog_sec, naive_sec / ulog_sec);
+    }
+
+    free(in);
+    free(out_a);
+    free(out_b);
+    return 0;
+}
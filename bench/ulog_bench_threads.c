@@ -0,0 +1,522 @@
+// Multithreaded logging benchmark: `ulog_log` from 1 to N threads behind the
+// pthread lock extension. Covers output mixes, runtime feature toggles,
+// message sizes, per-output locks, isolated outputs and their backpressure
+// policies, logger instances; prints throughput and per-call latency
+// percentiles.
+//
+// Build (see `zig build bench` or `just cc-bench`):
+//   cc -std=c23 -O2 -DULOG_BUILD_DYNAMIC_CONFIG=1 -Iinclude -Iextensions
+//      src/ulog.c extensions/ulog_lock_pthread.c bench/ulog_bench_threads.c
+//      -lpthread -o ulog_bench_threads
+//
+// Usage: ulog_bench_threads [calls per thread] [max threads]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ulog/ulog.h"
+#include "ulog_lock_pthread.h"
+
+enum {
+    BENCH_CALLS_DEFAULT   = 20000,  // Calls per thread per run
+    BENCH_THREADS_DEFAULT = 8,
+    BENCH_THREADS_MAX     = 64,
+    BENCH_MESSAGE_MAX     = 1024,
+    BENCH_LOGGERS_MAX     = 5,  // Default + 4 extra of the dynamic config
+};
+
+typedef enum {
+    OUTPUT_NULL,    // Custom handler that drops the event
+    OUTPUT_FILE,    // File output to a temporary file
+    OUTPUT_STDOUT,  // Built-in stdout output redirected to /dev/null
+    OUTPUT_TOTAL,
+} bench_output;
+
+typedef enum {
+    CONFIG_MINIMAL,  // Everything that can be switched off is off
+    CONFIG_TIME,
+    CONFIG_TOPICS,
+    CONFIG_PREFIX,
+    CONFIG_COLOR,
+    CONFIG_ALL,
+    CONFIG_TOTAL,
+} bench_config;
+
+typedef enum {
+    ISOLATION_GLOBAL,  // Both outputs under the global lock
+    ISOLATION_OWN,     // Each output under its own lock
+    ISOLATION_QUEUE,   // Own locks, the slow output behind a queue
+    ISOLATION_TOTAL,
+} bench_isolation;
+
+static const char *const output_names[OUTPUT_TOTAL] = {"null handler", "file",
+                                                       "stdout"};
+static const char *const config_names[CONFIG_TOTAL] = {
+    "minimal", "time", "topics", "prefix", "color", "all"};
+static const char *const isolation_names[ISOLATION_TOTAL] = {"global", "own",
+                                                             "queue"};
+static const size_t message_sizes[] = {16, 128, 1000};
+
+typedef struct {
+    pthread_t thread;
+    ulog_logger_id logger;  // Instance the worker logs to
+    const char *message;
+    const char *topic;
+    int calls;
+    uint64_t *latencies;  // ns per call
+    uint64_t begin;       // When the first call started
+    uint64_t end;         // When the last call returned
+} bench_worker;
+
+typedef struct {
+    double ops_per_sec;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t max;
+} bench_result;
+
+static pthread_barrier_t bench_barrier;
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void null_handler(ulog_event *ev, void *arg) {
+    (void)ev;
+    (void)arg;
+}
+
+// Stands in for a slow sink: a network or a congested disk
+static void slow_handler(ulog_event *ev, void *arg) {
+    (void)ev;
+    (void)arg;
+    struct timespec delay = {.tv_sec = 0, .tv_nsec = 20000};
+    nanosleep(&delay, nullptr);
+}
+
+static void bench_prefix(ulog_event *ev, char *prefix, size_t prefix_size) {
+    (void)ev;
+    snprintf(prefix, prefix_size, "[bench]");
+}
+
+static void *worker_main(void *arg) {
+    auto worker = (bench_worker *)arg;
+    (void)ulog_logger_use(worker->logger);
+    pthread_barrier_wait(&bench_barrier);
+    worker->begin = now_ns();
+    for (auto i = 0; i < worker->calls; i++) {
+        auto start = now_ns();
+        ulog_log(ULOG_LEVEL_INFO, __FILE__, __LINE__, worker->topic,
+                 "%s %d", worker->message, i);
+        worker->latencies[i] = now_ns() - start;
+    }
+    worker->end = now_ns();
+    return nullptr;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    auto x = *(const uint64_t *)a;
+    auto y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const uint64_t *sorted, size_t count,
+                           double fraction) {
+    auto index = (size_t)(fraction * (double)(count - 1) + 0.5);
+    return sorted[index];
+}
+
+static void apply_config(bench_config config) {
+    auto all = config == CONFIG_ALL;
+    (void)ulog_time_config(all || config == CONFIG_TIME);
+    (void)ulog_topic_config(all || config == CONFIG_TOPICS);
+    (void)ulog_prefix_config(all || config == CONFIG_PREFIX);
+    (void)ulog_color_config(all || config == CONFIG_COLOR);
+    (void)ulog_source_location_config(config != CONFIG_MINIMAL);
+}
+
+/// @brief Routes INFO events to exactly one output
+static ulog_output_id apply_output(bench_output output, FILE *file) {
+    auto id = ULOG_OUTPUT_INVALID;
+    switch (output) {
+    case OUTPUT_NULL:
+        id = ulog_output_add(null_handler, nullptr, ULOG_LEVEL_TRACE);
+        break;
+    case OUTPUT_FILE:
+        id = ulog_output_add_file(file, ULOG_LEVEL_TRACE);
+        break;
+    default:
+        break;
+    }
+    (void)ulog_output_level_set(ULOG_OUTPUT_STDOUT, output == OUTPUT_STDOUT
+                                                        ? ULOG_LEVEL_TRACE
+                                                        : ULOG_LEVEL_FATAL);
+    return id;
+}
+
+/// @param odd_topic Topic of the odd-numbered workers, the others use `topic`.
+/// When the topics differ only the even-numbered workers are measured.
+static bool run_case(bench_worker *workers, int threads, int calls,
+                     const char *message, const char *topic,
+                     const char *odd_topic, bench_result *result) {
+    if (pthread_barrier_init(&bench_barrier, nullptr, (unsigned)threads + 1) !=
+        0) {
+        return false;
+    }
+    // Workers store their samples back to back in one allocation
+    auto samples = workers[0].latencies;
+    for (auto t = 0; t < threads; t++) {
+        workers[t].latencies = samples + (size_t)t * (size_t)calls;
+        workers[t].message   = message;
+        workers[t].topic     = t % 2 == 0 ? topic : odd_topic;
+        workers[t].calls     = calls;
+        if (pthread_create(&workers[t].thread, nullptr, worker_main,
+                           &workers[t]) != 0) {
+            return false;
+        }
+    }
+    pthread_barrier_wait(&bench_barrier);
+    for (auto t = 0; t < threads; t++) {
+        pthread_join(workers[t].thread, nullptr);
+    }
+    pthread_barrier_destroy(&bench_barrier);
+
+    // Move the samples of the measured workers to the front
+    auto step     = odd_topic == topic ? 1 : 2;
+    auto measured = 0;
+    auto start    = workers[0].begin;
+    auto end      = workers[0].end;
+    for (auto t = 0; t < threads; t += step, measured++) {
+        memmove(samples + (size_t)measured * (size_t)calls,
+                workers[t].latencies, (size_t)calls * sizeof(samples[0]));
+        start = workers[t].begin < start ? workers[t].begin : start;
+        end   = workers[t].end > end ? workers[t].end : end;
+    }
+    auto elapsed = end - start;
+    auto count   = (size_t)measured * (size_t)calls;
+    qsort(samples, count, sizeof(samples[0]), compare_u64);
+    result->ops_per_sec = (double)count * 1e9 / (double)elapsed;
+    result->p50         = percentile(samples, count, 0.50);
+    result->p99         = percentile(samples, count, 0.99);
+    result->p999        = percentile(samples, count, 0.999);
+    result->max         = samples[count - 1];
+    return true;
+}
+
+static void print_header(FILE *out, const char *title) {
+    static constexpr char row[] =
+        "| %-12s | %-7s | %5s | %7s | %11s | %7s | %7s | %8s | %8s |\n";
+    fprintf(out, "\n%s\n\n", title);
+    fprintf(out, row, "output", "config", "bytes", "threads", "ops/sec",
+            "p50 ns", "p99 ns", "p99.9 ns", "max ns");
+    fprintf(out, row, "------------", "-------", "-----", "-------",
+            "-----------", "-------", "-------", "--------", "--------");
+}
+
+typedef struct {
+    FILE *out;
+    FILE *file;
+    bench_worker *workers;
+    int calls;
+    char message[BENCH_MESSAGE_MAX + 1];
+} bench_context;
+
+static bool run_row(bench_context *ctx, bench_output output,
+                    bench_config config, size_t size, int threads) {
+    memset(ctx->message, 'm', size);
+    ctx->message[size] = '\0';
+    apply_config(config);
+    auto id = apply_output(output, ctx->file);
+    if (output != OUTPUT_STDOUT && id == ULOG_OUTPUT_INVALID) {
+        return false;
+    }
+
+    bench_result r;
+    auto topic = config == CONFIG_TOPICS || config == CONFIG_ALL ? "bench"
+                                                                 : nullptr;
+    auto ok = run_case(ctx->workers, threads, ctx->calls, ctx->message, topic,
+                       topic, &r);
+    if (id != ULOG_OUTPUT_INVALID) {
+        (void)ulog_output_remove(id);
+    }
+    if (!ok) {
+        return false;
+    }
+    fprintf(ctx->out,
+            "| %-12s | %-7s | %5zu | %7d | %11.0f | %7llu | %7llu | %8llu | "
+            "%8llu |\n",
+            output_names[output], config_names[config], size, threads,
+            r.ops_per_sec, (unsigned long long)r.p50,
+            (unsigned long long)r.p99, (unsigned long long)r.p999,
+            (unsigned long long)r.max);
+    fflush(ctx->out);
+    return true;
+}
+
+/// @brief Even workers log to a file, odd workers to a slow output, with both
+/// outputs under the global lock, each under its own, or the slow one behind a
+/// queue. Measures the file workers.
+static bool run_lock_row(bench_context *ctx, bench_isolation isolation,
+                         int threads) {
+    static pthread_mutex_t file_mutex = PTHREAD_MUTEX_INITIALIZER;
+    static pthread_mutex_t slow_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    memset(ctx->message, 'm', 128);
+    ctx->message[128] = '\0';
+    apply_config(CONFIG_TOPICS);
+    auto file = apply_output(OUTPUT_FILE, ctx->file);
+    auto slow = ulog_output_add(slow_handler, nullptr, ULOG_LEVEL_TRACE);
+    if (file == ULOG_OUTPUT_INVALID || slow == ULOG_OUTPUT_INVALID ||
+        ulog_topic_add("fast", file, ULOG_LEVEL_TRACE) < 0 ||
+        ulog_topic_add("slow", slow, ULOG_LEVEL_TRACE) < 0) {
+        return false;
+    }
+    if (isolation != ISOLATION_GLOBAL) {
+        auto file_locked = ulog_lock_pthread_output_enable(file, &file_mutex);
+        auto slow_locked = ulog_lock_pthread_output_enable(slow, &slow_mutex);
+        if (file_locked != ULOG_STATUS_OK || slow_locked != ULOG_STATUS_OK) {
+            return false;
+        }
+    }
+    if (isolation == ISOLATION_QUEUE &&
+        ulog_output_isolate(slow, 1024) != ULOG_STATUS_OK) {
+        return false;
+    }
+
+    // The slow output sleeps on every call, fewer calls keep the run short
+    bench_result r;
+    auto calls = ctx->calls >= 10 ? ctx->calls / 10 : 1;
+    auto ok    = run_case(ctx->workers, threads, calls, ctx->message, "fast",
+                          "slow", &r);
+    (void)ulog_topic_remove("fast");
+    (void)ulog_topic_remove("slow");
+    (void)ulog_output_remove(file);
+    (void)ulog_output_remove(slow);
+    if (!ok) {
+        return false;
+    }
+    fprintf(ctx->out,
+            "| %-12s | %-7s | %5d | %7d | %11.0f | %7llu | %7llu | %8llu | "
+            "%8llu |\n",
+            "file+slow", isolation_names[isolation], 128, threads,
+            r.ops_per_sec, (unsigned long long)r.p50,
+            (unsigned long long)r.p99, (unsigned long long)r.p999,
+            (unsigned long long)r.max);
+    fflush(ctx->out);
+    return true;
+}
+
+/// @brief All workers log to a slow output behind a small queue that overflows,
+/// with one backpressure policy
+static bool run_policy_row(bench_context *ctx, ulog_queue_policy_config config,
+                           const char *name, int threads) {
+    memset(ctx->message, 'm', 128);
+    ctx->message[128] = '\0';
+    apply_config(CONFIG_TOPICS);
+    auto slow = ulog_output_add(slow_handler, nullptr, ULOG_LEVEL_TRACE);
+    if (slow == ULOG_OUTPUT_INVALID ||
+        ulog_topic_add("slow", slow, ULOG_LEVEL_TRACE) < 0 ||
+        ulog_output_queue_policy_set(slow, config) != ULOG_STATUS_OK ||
+        ulog_output_isolate(slow, 64) != ULOG_STATUS_OK) {
+        return false;
+    }
+
+    bench_result r;
+    auto calls = ctx->calls >= 10 ? ctx->calls / 10 : 1;
+    auto ok    = run_case(ctx->workers, threads, calls, ctx->message, "slow",
+                          "slow", &r);
+    ulog_queue_stats q;
+    ok = ok && ulog_output_queue_get(slow, &q) == ULOG_STATUS_OK;
+    (void)ulog_topic_remove("slow");
+    (void)ulog_output_remove(slow);
+    if (!ok) {
+        return false;
+    }
+    fprintf(ctx->out,
+            "| %-12s | %7d | %7llu | %7llu | %8llu | %8llu | %8llu | %8llu | "
+            "%9llu |\n",
+            name, threads, (unsigned long long)r.p50,
+            (unsigned long long)r.p99, (unsigned long long)r.max,
+            (unsigned long long)q.enqueued, (unsigned long long)q.dropped,
+            (unsigned long long)q.blocked, (unsigned long long)q.timed_out);
+    fflush(ctx->out);
+    return true;
+}
+
+/// @brief Workers share the default instance, or are spread over as many
+/// instances as there are workers (up to BENCH_LOGGERS_MAX), each instance
+/// with its own lock and null output
+static bool run_instance_row(bench_context *ctx, bool spread, int threads) {
+    static pthread_mutex_t mutexes[BENCH_LOGGERS_MAX];
+
+    memset(ctx->message, 'm', 128);
+    ctx->message[128] = '\0';
+    ulog_logger_id loggers[BENCH_LOGGERS_MAX] = {ULOG_LOGGER_DEFAULT};
+    ulog_output_id outputs[BENCH_LOGGERS_MAX];
+    auto count = 1;
+    while (spread && count < threads && count < BENCH_LOGGERS_MAX) {
+        auto logger = ulog_logger_add();
+        if (logger == ULOG_LOGGER_INVALID) {
+            break;
+        }
+        loggers[count++] = logger;
+    }
+    auto ok = true;
+    for (auto i = 0; i < count; i++) {
+        (void)ulog_logger_use(loggers[i]);
+        if (i > 0) {  // The default instance keeps the lock of main
+            pthread_mutex_init(&mutexes[i], nullptr);
+            ok = ok && ulog_lock_pthread_enable(&mutexes[i]) == ULOG_STATUS_OK;
+        }
+        apply_config(CONFIG_MINIMAL);
+        outputs[i] = apply_output(OUTPUT_NULL, nullptr);
+        ok         = ok && outputs[i] != ULOG_OUTPUT_INVALID;
+    }
+    (void)ulog_logger_use(ULOG_LOGGER_DEFAULT);
+
+    bench_result r;
+    for (auto t = 0; t < threads; t++) {
+        ctx->workers[t].logger = loggers[t % count];
+    }
+    ok = ok && run_case(ctx->workers, threads, ctx->calls, ctx->message,
+                        nullptr, nullptr, &r);
+    for (auto t = 0; t < threads; t++) {
+        ctx->workers[t].logger = ULOG_LOGGER_DEFAULT;
+    }
+    (void)ulog_output_remove(outputs[0]);
+    for (auto i = 1; i < count; i++) {
+        (void)ulog_logger_remove(loggers[i]);
+        pthread_mutex_destroy(&mutexes[i]);
+    }
+    if (!ok) {
+        return false;
+    }
+    char instances[16];
+    snprintf(instances, sizeof(instances), "%d inst", count);
+    fprintf(ctx->out,
+            "| %-12s | %-7s | %5d | %7d | %11.0f | %7llu | %7llu | %8llu | "
+            "%8llu |\n",
+            output_names[OUTPUT_NULL], instances, 128, threads, r.ops_per_sec,
+            (unsigned long long)r.p50, (unsigned long long)r.p99,
+            (unsigned long long)r.p999, (unsigned long long)r.max);
+    fflush(ctx->out);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    auto calls       = argc > 1 ? atoi(argv[1]) : BENCH_CALLS_DEFAULT;
+    auto max_threads = argc > 2 ? atoi(argv[2]) : BENCH_THREADS_DEFAULT;
+    if (calls <= 0 || max_threads <= 0 || max_threads > BENCH_THREADS_MAX) {
+        fprintf(stderr, "usage: %s [calls per thread] [max threads <= %d]\n",
+                argv[0], BENCH_THREADS_MAX);
+        return 1;
+    }
+
+    // Results go to the original stdout, log output to /dev/null
+    auto out = fdopen(dup(STDOUT_FILENO), "w");
+    if (out == nullptr || freopen("/dev/null", "w", stdout) == nullptr) {
+        fprintf(stderr, "cannot redirect stdout\n");
+        return 1;
+    }
+
+    static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    bench_worker workers[BENCH_THREADS_MAX] = {0};
+    auto samples = (uint64_t *)malloc((size_t)max_threads * (size_t)calls *
+                                      sizeof(uint64_t));
+    auto file    = tmpfile();
+    if (samples == nullptr || file == nullptr ||
+        ulog_lock_pthread_enable(&mutex) != ULOG_STATUS_OK ||
+        ulog_topic_add("bench", ULOG_OUTPUT_ALL, ULOG_LEVEL_TRACE) < 0 ||
+        ulog_prefix_set_fn(bench_prefix) != ULOG_STATUS_OK) {
+        fprintf(stderr, "setup failed\n");
+        return 1;
+    }
+    workers[0].latencies = samples;  // Room for max_threads * calls samples
+
+    bench_context ctx = {
+        .out = out, .file = file, .workers = workers, .calls = calls};
+    fprintf(out, "ulog_log, %d calls per thread, pthread lock\n", calls);
+
+    // Warm up caches, the file and the thread stacks before measuring
+    auto ok = run_case(workers, max_threads, calls, "warmup", nullptr, nullptr,
+                       &(bench_result){0});
+
+    print_header(out, "Thread scaling per output (minimal config, 128 bytes)");
+    for (auto o = 0; ok && o < OUTPUT_TOTAL; o++) {
+        for (auto t = 1; ok && t <= max_threads; t *= 2) {
+            ok = run_row(&ctx, (bench_output)o, CONFIG_MINIMAL, 128, t);
+        }
+    }
+
+    print_header(out, "Feature configurations (file output, 128 bytes)");
+    for (auto c = 0; ok && c < CONFIG_TOTAL; c++) {
+        ok = run_row(&ctx, OUTPUT_FILE, (bench_config)c, 128, 1) &&
+             run_row(&ctx, OUTPUT_FILE, (bench_config)c, 128, max_threads);
+    }
+
+    print_header(out, "Message sizes (file output, all features)");
+    for (size_t s = 0; ok && s < sizeof(message_sizes) / sizeof(size_t); s++) {
+        ok = run_row(&ctx, OUTPUT_FILE, CONFIG_ALL, message_sizes[s], 1) &&
+             run_row(&ctx, OUTPUT_FILE, CONFIG_ALL, message_sizes[s],
+                     max_threads);
+    }
+
+    print_header(out, "File threads next to as many threads on a slow output "
+                      "(topics, 128 bytes)");
+    for (auto t = 2; ok && t <= max_threads; t *= 2) {
+        for (auto i = 0; ok && i < ISOLATION_TOTAL; i++) {
+            ok = run_lock_row(&ctx, (bench_isolation)i, t);
+        }
+    }
+
+    print_header(out, "Threads on one logger instance or spread over several "
+                      "(minimal config, 128 bytes)");
+    for (auto t = 2; ok && t <= max_threads; t *= 2) {
+        ok = run_instance_row(&ctx, false, t) && run_instance_row(&ctx, true, t);
+    }
+
+    static const struct {
+        const char *name;
+        ulog_queue_policy_config config;
+    } policies[] = {
+        {"drop newest", {.policy = ULOG_QUEUE_DROP_NEWEST}},
+        {"drop oldest", {.policy = ULOG_QUEUE_DROP_OLDEST}},
+        {"drop < WARN", {.policy = ULOG_QUEUE_DROP_BELOW,
+                         .level  = ULOG_LEVEL_WARN}},
+        {"block 1 ms", {.policy = ULOG_QUEUE_BLOCK, .timeout_ms = 1}},
+    };
+    static constexpr char policy_row[] = "| %-12s | %7s | %7s | %7s | %8s | "
+                                         "%8s | %8s | %8s | %9s |\n";
+    fprintf(out, "\nSlow output behind a 64-event queue, per backpressure "
+                 "policy (INFO, 128 bytes)\n\n");
+    fprintf(out, policy_row, "policy", "threads", "p50 ns", "p99 ns",
+            "max ns", "enqueued", "dropped", "blocked", "timed out");
+    fprintf(out, policy_row, "------------", "-------", "-------", "-------",
+            "--------", "--------", "--------", "--------", "---------");
+    for (size_t p = 0; ok && p < sizeof(policies) / sizeof(policies[0]);
+         p++) {
+        ok = run_policy_row(&ctx, policies[p].config, policies[p].name,
+                            max_threads);
+    }
+
+    if (!ok) {
+        fprintf(stderr, "benchmark run failed\n");
+    }
+    fprintf(out, "\nLatency includes two clock_gettime calls per sample.\n");
+    (void)ulog_lock_pthread_disable();
+    (void)ulog_cleanup();
+    fclose(file);
+    fclose(out);
+    free(samples);
+    return ok ? 0 : 1;
+}
@@ -71,4 +71,195 @@ pub fn build(b: *std.Build) void {
 
     const run_all_step = b.step("run-all-features", "Run the all-features example");
     run_all_step.dependOn(&run_all_cmd.step);
+
+    const binary_convert = b.addExecutable(.{
+        .name = "ulog_binary_convert",
+        .root_module = b.createModule(.{
+            .target = target,
+            .optimize = optimize,
+        }),
+    });
+
+    binary_convert.root_module.addCSourceFile(.{ .file = b.path("tools/ulog_binary_convert.c"), .flags = c_flags });
+    binary_convert.linkLibC();
+
+    b.installArtifact(binary_convert);
+
+    const c_flags_bench_json = &[_][]const u8{
+        "-std=c23",
+        "-Wall",
+        "-Wextra",
+        "-Wpedantic",
+        "-Werror",
+        "-DULOG_TESTING",
+        "-DULOG_BUILD_EXTRA_OUTPUTS=1",
+        "-DULOG_BUILD_JSON_OUTPUT=1",
+    };
+
+    const bench_json = b.addExecutable(.{
+        .name = "ulog_bench_json",
+        .root_module = b.createModule(.{
+            .target = target,
+            .optimize = .ReleaseFast,
+        }),
+    });
+
+    bench_json.root_module.addIncludePath(b.path("include"));
+    bench_json.root_module.addCSourceFile(.{ .file = b.path("src/ulog.c"), .flags = c_flags_bench_json });
+    bench_json.root_module.addCSourceFile(.{ .file = b.path("bench/ulog_bench_json.c"), .flags = c_flags_bench_json });
+    bench_json.linkLibC();
+
+    const run_bench_json_cmd = b.addRunArtifact(bench_json);
+    const run_bench_json_step = b.step("bench-json", "Run the JSON escaping benchmark");
+    run_bench_json_step.dependOn(&run_bench_json_cmd.step);
+
+    const c_flags_bench_format = &[_][]const u8{
+        "-std=c23",
+        "-Wall",
+        "-Wextra",
+        "-Wpedantic",
+        "-Werror",
+        "-DULOG_TESTING",
+        "-DULOG_BUILD_FAST_FORMAT=1",
+        "-DULOG_BUILD_FORMAT_CACHE=1",
+    };
+
+    const bench_format = b.addExecutable(.{
+        .name = "ulog_bench_format",
+        .root_module = b.createModule(.{
+            .target = target,
+            .optimize = .ReleaseFast,
+        }),
+    });
+
+    bench_format.root_module.addIncludePath(b.path("include"));
+    bench_format.root_module.addCSourceFile(.{ .file = b.path("src/ulog.c"), .flags = c_flags_bench_format });
+    bench_format.root_module.addCSourceFile(.{ .file = b.path("bench/ulog_bench_format.c"), .flags = c_flags_bench_format });
+    bench_format.linkLibC();
+
+    const run_bench_format_cmd = b.addRunArtifact(bench_format);
+    const run_bench_format_step = b.step("bench-format", "Run the printf engine benchmark");
+    run_bench_format_step.dependOn(&run_bench_format_cmd.step);
+
+    const c_flags_bench_float = &[_][]const u8{
+        "-std=c23",
+        "-Wall",
+        "-Wextra",
+        "-Wpedantic",
+        "-Werror",
+        "-DULOG_TESTING",
+        "-DULOG_BUILD_FAST_FORMAT=1",
+    };
+
+    const bench_float = b.addExecutable(.{
+        .name = "ulog_bench_float",
+        .root_module = b.createModule(.{
+            .target = target,
+            .optimize = .ReleaseFast,
+        }),
+    });
+
+    bench_float.root_module.addIncludePath(b.path("include"));
+    bench_float.root_module.addCSourceFile(.{ .file = b.path("src/ulog.c"), .flags = c_flags_bench_float });
+    bench_float.root_module.addCSourceFile(.{ .file = b.path("bench/ulog_bench_float.c"), .flags = c_flags_bench_float });
+    bench_float.linkLibC();
+
+    const run_bench_float_cmd = b.addRunArtifact(bench_float);
+    const run_bench_float_step = b.step("bench-float", "Run the floating point formatting benchmark");
+    run_bench_float_step.dependOn(&run_bench_float_cmd.step);
+
+    const bench_threads = b.addExecutable(.{
+        .name = "ulog_bench_threads",
+        .root_module = b.createModule(.{
+            .target = target,
+            .optimize = .ReleaseFast,
+        }),
+    });
+
+    bench_threads.root_module.addIncludePath(b.path("include"));
+    bench_threads.root_module.addIncludePath(b.path("extensions"));
+    bench_threads.root_module.addCSourceFile(.{ .file = b.path("src/ulog.c"), .flags = c_flags_dynamic });
+    bench_threads.root_module.addCSourceFile(.{ .file = b.path("extensions/ulog_lock_pthread.c"), .flags = c_flags_dynamic });
+    bench_threads.root_module.addCSourceFile(.{ .file = b.path("bench/ulog_bench_threads.c"), .flags = c_flags_dynamic });
+    bench_threads.linkLibC();
+    bench_threads.linkSystemLibrary("pthread");
+
+    const run_bench_threads_cmd = b.addRunArtifact(bench_threads);
+    if (b.args) |args| {
+        run_bench_threads_cmd.addArgs(args);
+    }
+    const run_bench_threads_step = b.step("bench", "Run the multithreaded throughput and latency benchmark");
+    run_bench_threads_step.dependOn(&run_bench_threads_cmd.step);
+
+    // One binary per build configuration; runs are chained so the rows of
+    // the comparison table come out in order.
+    const BenchConfig = struct {
+        name: []const u8,
+        flags: []const []const u8,
+        with_library: bool = true,
+    };
+    const bench_disabled_configs = [_]BenchConfig{
+        .{ .name = "default", .flags = &.{"-DULOG_BUILD_EXTRA_OUTPUTS=1"} },
+        .{ .name = "static-topics", .flags = &.{ "-DULOG_BUILD_EXTRA_OUTPUTS=1", "-DULOG_BUILD_TOPICS_MODE=1", "-DULOG_BUILD_TOPICS_STATIC_NUM=4" } },
+        .{ .name = "dynamic-topics", .flags = &.{ "-DULOG_BUILD_EXTRA_OUTPUTS=1", "-DULOG_BUILD_TOPICS_MODE=2" } },
+        .{ .name = "full-static", .flags = &.{ "-DULOG_BUILD_EXTRA_OUTPUTS=1", "-DULOG_BUILD_TOPICS_MODE=1", "-DULOG_BUILD_TOPICS_STATIC_NUM=4", "-DULOG_BUILD_TIME=1", "-DULOG_BUILD_COLOR=1", "-DULOG_BUILD_PREFIX_SIZE=16" } },
+        .{ .name = "dynamic-config", .flags = &.{"-DULOG_BUILD_DYNAMIC_CONFIG=1"} },
+        .{ .name = "registry", .flags = &.{ "-DULOG_BUILD_EXTRA_OUTPUTS=1", "-DULOG_BUILD_TOPICS_MODE=2", "-DULOG_BUILD_CALLSITE_REGISTRY=1" } },
+        .{ .name = "descriptors", .flags = &.{ "-DULOG_BUILD_EXTRA_OUTPUTS=1", "-DULOG_BUILD_TOPICS_MODE=2", "-DULOG_BUILD_CALLSITE_DESCRIPTORS=1" } },
+        .{ .name = "loggers", .flags = &.{ "-DULOG_BUILD_EXTRA_OUTPUTS=1", "-DULOG_BUILD_TOPICS_MODE=2", "-DULOG_BUILD_LOGGERS=2" } },
+        .{ .name = "disabled", .flags = &.{"-DULOG_BUILD_DISABLED=1"}, .with_library = false },
+    };
+
+    const run_bench_disabled_step = b.step("bench-disabled", "Run the filtered-call cost benchmark across build configurations");
+    var previous_bench_disabled: ?*std.Build.Step = null;
+    for (bench_disabled_configs) |config| {
+        const flags = std.mem.concat(b.allocator, []const u8, &.{
+            c_flags,
+            &.{b.fmt("-DBENCH_CONFIG=\"{s}\"", .{config.name})},
+            config.flags,
+        }) catch @panic("OOM");
+
+        const bench_disabled = b.addExecutable(.{
+            .name = b.fmt("ulog_bench_disabled_{s}", .{config.name}),
+            .root_module = b.createModule(.{
+                .target = target,
+                .optimize = .ReleaseFast,
+            }),
+        });
+
+        bench_disabled.root_module.addIncludePath(b.path("include"));
+        if (config.with_library) {
+            bench_disabled.root_module.addCSourceFile(.{ .file = b.path("src/ulog.c"), .flags = flags });
+        }
+        bench_disabled.root_module.addCSourceFile(.{ .file = b.path("bench/ulog_bench_disabled.c"), .flags = flags });
+        bench_disabled.linkLibC();
+        bench_disabled.linkSystemLibrary("pthread");
+
+        const run_bench_disabled_cmd = b.addRunArtifact(bench_disabled);
+        if (previous_bench_disabled) |previous| {
+            run_bench_disabled_cmd.step.dependOn(previous);
+        } else {
+            run_bench_disabled_cmd.addArg("--header");
+        }
+        previous_bench_disabled = &run_bench_disabled_cmd.step;
+    }
+    run_bench_disabled_step.dependOn(previous_bench_disabled.?);
+
+    const bench_alloc = b.addExecutable(.{
+        .name = "ulog_bench_alloc",
+        .root_module = b.createModule(.{
+            .target = target,
+            .optimize = .ReleaseFast,
+        }),
+    });
+
+    bench_alloc.root_module.addIncludePath(b.path("include"));
+    bench_alloc.root_module.addCSourceFile(.{ .file = b.path("src/ulog.c"), .flags = c_flags_dynamic });
+    bench_alloc.root_module.addCSourceFile(.{ .file = b.path("bench/ulog_bench_alloc.c"), .flags = c_flags_dynamic });
+    bench_alloc.linkLibC();
+    bench_alloc.linkSystemLibrary("dl");
+
+    const run_bench_alloc_cmd = b.addRunArtifact(bench_alloc);
+    const run_bench_alloc_step = b.step("bench-alloc", "Run the allocation and I/O accounting harness");
+    run_bench_alloc_step.dependOn(&run_bench_alloc_cmd.step);
 }
@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 
 #include "ulog/ulog.h"
@@ -35,6 +36,13 @@ static void print_status(const char *label, ulog_status status) {
     fprintf(stderr, "%s: %s (%d)\n", name, label, (int)status);
 }
 
+static void example_topic_visit(const ulog_topic_info *info, void *arg) {
+    (void)arg;
+    printf("topic %s: emitted(warn)=%llu filtered(debug)=%llu\n", info->name,
+           (unsigned long long)info->emitted[ULOG_LEVEL_WARN],
+           (unsigned long long)info->filtered[ULOG_LEVEL_DEBUG]);
+}
+
 static ulog_status example_lock(bool lock, void *arg) {
     if (arg == nullptr) {
         return ULOG_STATUS_INVALID_ARGUMENT;
@@ -88,6 +96,14 @@ static void example_prefix(ulog_event *ev, char *prefix, size_t prefix_size) {
                    file, line);
 }
 
+static void example_thread_prefix(ulog_event *ev, char *prefix,
+                                  size_t prefix_size) {
+    static int renders = 0;
+    (void)ev;
+    renders++;
+    (void)snprintf(prefix, prefix_size, "[main render=%d] ", renders);
+}
+
 static void example_output(ulog_event *ev, void *arg) {
     auto state = (example_output_state *)arg;
     if ((state == nullptr) || (state->stream == nullptr)) {
@@ -174,11 +190,36 @@ int main() {
         }
     }
 
+    FILE *json_file             = fopen("ulog_all_features.jsonl", "w");
+    ulog_output_id json_output = ULOG_OUTPUT_INVALID;
+    if (json_file != nullptr) {
+        json_output = ulog_output_add_json_file(json_file, ULOG_LEVEL_INFO);
+        if (json_output == ULOG_OUTPUT_INVALID) {
+            fclose(json_file);
+            json_file = nullptr;
+        }
+    }
+
+    FILE *binary_file             = fopen("ulog_all_features.ulogb", "wb");
+    ulog_output_id binary_output = ULOG_OUTPUT_INVALID;
+    if (binary_file != nullptr) {
+        binary_output =
+            ulog_output_add_binary_file(binary_file, ULOG_LEVEL_INFO);
+        if (binary_output == ULOG_OUTPUT_INVALID) {
+            fclose(binary_file);
+            binary_file = nullptr;
+        }
+    }
+
     example_output_state mirror_state = {.stream = stderr, .lines = 0U};
     auto mirror_output =
         ulog_output_add(example_output, &mirror_state, ULOG_LEVEL_INFO);
     if (mirror_output == ULOG_OUTPUT_INVALID) {
         fprintf(stderr, "mirror output: failed to add\n");
+    } else {
+        // The mirror runs in a worker thread of its own
+        status = ulog_output_isolate(mirror_output, 64);
+        print_status("ulog_output_isolate(mirror)", status);
     }
 
     ulog_trace("trace message");
@@ -189,6 +230,16 @@ int main() {
     ulog_fatal("fatal message");
     ulog(ULOG_LEVEL_6, "custom level %d", 6);
 
+    ulog_kv(ULOG_LEVEL_INFO, "request done", "path", "/api/v1", "status", 200,
+            "ok", true, "latency_ms", 12.5, "user", "jane doe");
+
+    // Longer than a binary record: cut, but the record stays readable
+    char long_text[1500];
+    memset(long_text, 'x', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+    ulog_info("long message: %s", long_text);
+    ulog_log(ULOG_LEVEL_INFO, long_text, 1, nullptr, "long file name");
+
     const char *warn_name = ulog_level_to_string(ULOG_LEVEL_WARN);
     if (warn_name == nullptr) {
         warn_name = "?";
@@ -222,10 +273,44 @@ int main() {
         ulog_t_warn("net", "link unstable");
         auto net_id = ulog_topic_get_id("net");
         ulog_info("net topic id: %d", (int)net_id);
+        status = ulog_topic_foreach(example_topic_visit, nullptr);
+        print_status("ulog_topic_foreach", status);
         status = ulog_topic_remove("net");
         print_status("ulog_topic_remove", status);
     }
 
+    // Rules set levels for a whole hierarchy of dotted topic names
+    status = ulog_topic_rule_set("db.*", ULOG_LEVEL_ERROR);
+    print_status("ulog_topic_rule_set(db.*)", status);
+    status = ulog_topic_rule_set("db.query", ULOG_LEVEL_DEBUG);
+    print_status("ulog_topic_rule_set(db.query)", status);
+    if (ulog_topic_add("db.query", ULOG_OUTPUT_ALL, ULOG_LEVEL_INFO) !=
+            ULOG_TOPIC_ID_INVALID &&
+        ulog_topic_add("db.pool", ULOG_OUTPUT_ALL, ULOG_LEVEL_INFO) !=
+            ULOG_TOPIC_ID_INVALID) {
+        ulog_t_debug("db.query", "query took 3 ms");
+        ulog_t_warn("db.pool", "pool warning should be filtered");
+        status = ulog_topic_rule_remove("db.*");
+        print_status("ulog_topic_rule_remove(db.*)", status);
+        ulog_t_warn("db.pool", "pool at 90%% capacity");
+        (void)ulog_topic_remove("db.query");
+        (void)ulog_topic_remove("db.pool");
+    }
+    (void)ulog_topic_rule_remove("db.query");
+
+    // A topic routes to a set of outputs, each route with a level of its own
+    if (ulog_topic_add("audit", ULOG_OUTPUT_STDOUT, ULOG_LEVEL_INFO) !=
+        ULOG_TOPIC_ID_INVALID) {
+        if (mirror_output != ULOG_OUTPUT_INVALID) {
+            status =
+                ulog_topic_route_set("audit", mirror_output, ULOG_LEVEL_WARN);
+            print_status("ulog_topic_route_set(audit, mirror)", status);
+        }
+        ulog_t_info("audit", "login (stdout only)");
+        ulog_t_warn("audit", "password changed (stdout and mirror)");
+        (void)ulog_topic_remove("audit");
+    }
+
     status = ulog_topic_config(false);
     print_status("ulog_topic_config(false)", status);
     ulog_t_info("net", "topics disabled");
@@ -265,8 +350,36 @@ int main() {
     log_message((ulog_level)LOG_INFO, "generic interface info");
     log_topic((ulog_level)LOG_WARN, "GEN", "generic interface topic");
 
+    if (mirror_output != ULOG_OUTPUT_INVALID) {
+        status = ulog_output_drain(mirror_output);
+        print_status("ulog_output_drain(mirror)", status);
+        ulog_queue_stats queue;
+        status = ulog_output_queue_get(mirror_output, &queue);
+        print_status("ulog_output_queue_get(mirror)", status);
+        printf("mirror queue: enqueued=%llu delivered=%llu dropped=%llu "
+               "max depth=%zu\n",
+               (unsigned long long)queue.enqueued,
+               (unsigned long long)queue.delivered,
+               (unsigned long long)queue.dropped, queue.max_depth);
+    }
     ulog_info("mirror output lines: %u", mirror_state.lines);
 
+    ulog_stats stats;
+    status = ulog_stats_get(&stats);
+    print_status("ulog_stats_get", status);
+    if (status == ULOG_STATUS_OK) {
+        printf("stats: info=%llu filtered(level)=%llu filtered(topic)=%llu "
+               "stdout bytes=%llu\n",
+               (unsigned long long)stats.events[ULOG_LEVEL_INFO],
+               (unsigned long long)stats.filtered_level,
+               (unsigned long long)stats.filtered_topic,
+               (unsigned long long)stats.outputs[ULOG_OUTPUT_STDOUT].bytes);
+    }
+    status = ulog_stats_latency_dump(stdout);
+    print_status("ulog_stats_latency_dump", status);
+    status = ulog_callsite_report(5, stdout);
+    print_status("ulog_callsite_report", status);
+
     if (mirror_output != ULOG_OUTPUT_INVALID) {
         status = ulog_output_remove(mirror_output);
         print_status("ulog_output_remove(mirror)", status);
@@ -281,6 +394,70 @@ int main() {
         fclose(log_file);
     }
 
+    if (json_output != ULOG_OUTPUT_INVALID) {
+        status = ulog_output_remove(json_output);
+        print_status("ulog_output_remove(json)", status);
+    }
+
+    if (json_file != nullptr) {
+        fclose(json_file);
+    }
+
+    if (binary_output != ULOG_OUTPUT_INVALID) {
+        status = ulog_output_remove(binary_output);
+        print_status("ulog_output_remove(binary)", status);
+    }
+
+    if (binary_file != nullptr) {
+        fclose(binary_file);
+    }
+
+    // Request-scoped fields on every event of this thread, no "%s" per site
+    status = ulog_context_push("req", 42);
+    print_status("ulog_context_push(req)", status);
+    status = ulog_context_push("user", "jane");
+    print_status("ulog_context_push(user)", status);
+    ulog_info("served with the request context");
+    ulog_kv(ULOG_LEVEL_INFO, "own fields follow", "status", 200);
+    status = ulog_context_pop();
+    print_status("ulog_context_pop", status);
+    status = ulog_context_clear();
+    print_status("ulog_context_clear", status);
+    ulog_info("outside the request");
+
+    // Thread ID, name and CPU, captured once per thread (the CPU per event)
+    status = ulog_thread_name_set("main");
+    print_status("ulog_thread_name_set", status);
+    status = ulog_thread_info_config(true);
+    print_status("ulog_thread_info_config(true)", status);
+    ulog_info("logged with the thread that logged it");
+    status = ulog_thread_info_config(false);
+    print_status("ulog_thread_info_config(false)", status);
+
+    // A logger instance has its own lock, outputs, topics and settings
+    auto shard = ulog_logger_add();
+    if (shard != ULOG_LOGGER_INVALID) {
+        auto previous = ulog_logger_use(shard);
+        ulog_info("logged by instance %d to its own stdout output", (int)shard);
+
+        // The prefix depends on the thread only: render it once, not per event
+        (void)ulog_prefix_config(true);
+        (void)ulog_prefix_set_fn(example_thread_prefix);
+        status = ulog_prefix_mode_set(ULOG_PREFIX_MODE_THREAD);
+        print_status("ulog_prefix_mode_set(thread)", status);
+        ulog_info("first event renders the prefix");
+        ulog_info("second event reuses it");
+        status = ulog_prefix_invalidate();
+        print_status("ulog_prefix_invalidate", status);
+        ulog_info("after invalidation it is rendered again");
+        (void)ulog_logger_use(previous);
+
+        // Without selecting it: log to the instance by its handle
+        ulog_logger_info(shard, "logged to instance %d by handle", (int)shard);
+        status = ulog_logger_remove(shard);
+        print_status("ulog_logger_remove", status);
+    }
+
     status = ulog_cleanup();
     print_status("ulog_cleanup", status);
 
@@ -35,3 +35,17 @@ ulog_status ulog_lock_cmsis_enable(osMutexId_t mutex_id) {
 ulog_status ulog_lock_cmsis_disable() {
     return ulog_lock_set_fn(nullptr, nullptr);
 }
+
+/** @copydoc ulog_lock_cmsis_output_enable */
+ulog_status ulog_lock_cmsis_output_enable(ulog_output_id output,
+                                          osMutexId_t mutex_id) {
+    if (mutex_id == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    return ulog_output_lock_set_fn(output, cmsis_lock_fn, (void *)mutex_id);
+}
+
+/** @copydoc ulog_lock_cmsis_output_disable */
+ulog_status ulog_lock_cmsis_output_disable(ulog_output_id output) {
+    return ulog_output_lock_set_fn(output, nullptr, nullptr);
+}
@@ -25,3 +25,19 @@
  * @brief Disable logging lock (clears lock function). Keeps mutex.
  */
 [[nodiscard]] ulog_status ulog_lock_cmsis_disable();
+
+/**
+ * @brief Give one output its own lock with an existing CMSIS-RTOS2 mutex id.
+ * The output then runs outside the global lock, in parallel with other outputs.
+ * @param output Output handle.
+ * @param mutex_id Lock for this output only.
+ * @return ULOG_STATUS_OK, ULOG_STATUS_INVALID_ARGUMENT or ULOG_STATUS_BUSY.
+ */
+[[nodiscard]] ulog_status
+ulog_lock_cmsis_output_enable(ulog_output_id output, osMutexId_t mutex_id);
+
+/**
+ * @brief Return an output to the global lock. Keeps mutex.
+ * @param output Output handle.
+ */
+[[nodiscard]] ulog_status ulog_lock_cmsis_output_disable(ulog_output_id output);
@@ -37,3 +37,17 @@ ulog_status ulog_lock_freertos_enable(SemaphoreHandle_t mutex) {
 ulog_status ulog_lock_freertos_disable() {
     return ulog_lock_set_fn(nullptr, nullptr);
 }
+
+/** @copydoc ulog_lock_freertos_output_enable */
+ulog_status ulog_lock_freertos_output_enable(ulog_output_id output,
+                                             SemaphoreHandle_t mutex) {
+    if (mutex == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    return ulog_output_lock_set_fn(output, freertos_lock_fn, (void *)mutex);
+}
+
+/** @copydoc ulog_lock_freertos_output_disable */
+ulog_status ulog_lock_freertos_output_disable(ulog_output_id output) {
+    return ulog_output_lock_set_fn(output, nullptr, nullptr);
+}
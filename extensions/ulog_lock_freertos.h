@@ -28,3 +28,21 @@
  * @brief Disable logging lock (clears lock function). Keeps mutex allocated.
  */
 [[nodiscard]] ulog_status ulog_lock_freertos_disable();
+
+/**
+ * @brief Give one output its own lock with an existing FreeRTOS mutex. The
+ * output then runs outside the global lock, in parallel with other outputs.
+ * @param output Output handle.
+ * @param mutex Lock for this output only.
+ * @return ULOG_STATUS_OK, ULOG_STATUS_INVALID_ARGUMENT or ULOG_STATUS_BUSY.
+ */
+[[nodiscard]] ulog_status
+ulog_lock_freertos_output_enable(ulog_output_id output,
+                                 SemaphoreHandle_t mutex);
+
+/**
+ * @brief Return an output to the global lock. Keeps mutex allocated.
+ * @param output Output handle.
+ */
+[[nodiscard]] ulog_status
+ulog_lock_freertos_output_disable(ulog_output_id output);
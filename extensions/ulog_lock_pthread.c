@@ -49,3 +49,17 @@ ulog_status ulog_lock_pthread_enable(pthread_mutex_t *mtx) {
 ulog_status ulog_lock_pthread_disable() {
     return ulog_lock_set_fn(nullptr, nullptr);
 }
+
+/** @copydoc ulog_lock_pthread_output_enable */
+ulog_status ulog_lock_pthread_output_enable(ulog_output_id output,
+                                            pthread_mutex_t *mtx) {
+    if (mtx == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    return ulog_output_lock_set_fn(output, pthread_lock_fn, mtx);
+}
+
+/** @copydoc ulog_lock_pthread_output_disable */
+ulog_status ulog_lock_pthread_output_disable(ulog_output_id output) {
+    return ulog_output_lock_set_fn(output, nullptr, nullptr);
+}
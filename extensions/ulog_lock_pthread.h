@@ -29,3 +29,21 @@
  * @return ULOG_STATUS_OK always.
  */
 [[nodiscard]] ulog_status ulog_lock_pthread_disable();
+
+/**
+ * @brief Give one output its own lock with an existing, already initialized
+ * pthread mutex. The output then runs outside the global lock, in parallel with
+ * other outputs.
+ * @param output Output handle.
+ * @param mtx Lock for this output only.
+ * @return ULOG_STATUS_OK, ULOG_STATUS_INVALID_ARGUMENT or ULOG_STATUS_BUSY.
+ */
+[[nodiscard]] ulog_status
+ulog_lock_pthread_output_enable(ulog_output_id output, pthread_mutex_t *mtx);
+
+/**
+ * @brief Return an output to the global lock. Does not destroy mutex.
+ * @param output Output handle.
+ */
+[[nodiscard]] ulog_status
+ulog_lock_pthread_output_disable(ulog_output_id output);
@@ -33,3 +33,17 @@ ulog_status ulog_lock_threadx_enable(TX_MUTEX *mtx) {
 ulog_status ulog_lock_threadx_disable() {
     return ulog_lock_set_fn(nullptr, nullptr);
 }
+
+/** @copydoc ulog_lock_threadx_output_enable */
+ulog_status ulog_lock_threadx_output_enable(ulog_output_id output,
+                                            TX_MUTEX *mtx) {
+    if (mtx == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    return ulog_output_lock_set_fn(output, threadx_lock_fn, mtx);
+}
+
+/** @copydoc ulog_lock_threadx_output_disable */
+ulog_status ulog_lock_threadx_output_disable(ulog_output_id output) {
+    return ulog_output_lock_set_fn(output, nullptr, nullptr);
+}
@@ -27,3 +27,20 @@
  * @brief Disable logging lock (clears lock function). Does not delete mutex.
  */
 [[nodiscard]] ulog_status ulog_lock_threadx_disable();
+
+/**
+ * @brief Give one output its own lock with an existing ThreadX mutex. The
+ * output then runs outside the global lock, in parallel with other outputs.
+ * @param output Output handle.
+ * @param mtx Lock for this output only.
+ * @return ULOG_STATUS_OK, ULOG_STATUS_INVALID_ARGUMENT or ULOG_STATUS_BUSY.
+ */
+[[nodiscard]] ulog_status
+ulog_lock_threadx_output_enable(ulog_output_id output, TX_MUTEX *mtx);
+
+/**
+ * @brief Return an output to the global lock. Does not delete mutex.
+ * @param output Output handle.
+ */
+[[nodiscard]] ulog_status
+ulog_lock_threadx_output_disable(ulog_output_id output);
@@ -102,6 +102,86 @@ enum {
     ULOG_TOPIC_ID_INVALID = -1,  ///< Invalid topic ID
 };
 
+/* ============================================================================
+   Core: Structured Fields
+============================================================================ */
+
+/// @brief Type of a structured field value
+typedef enum {
+    ULOG_KV_BOOL,    ///< Boolean value
+    ULOG_KV_INT,     ///< Signed integer, stored as int64_t
+    ULOG_KV_UINT,    ///< Unsigned integer, stored as uint64_t
+    ULOG_KV_DOUBLE,  ///< Floating point value, stored as double
+    ULOG_KV_STRING,  ///< Null-terminated string (not copied)
+} ulog_kv_type;
+
+/// @brief Structured key-value field attached to an event
+typedef struct {
+    const char *key;    ///< Field name (not copied)
+    ulog_kv_type type;  ///< Active member of `value`
+    union {
+        bool b;
+        int64_t i;
+        uint64_t u;
+        double d;
+        const char *s;
+    } value;
+} ulog_kv_field;
+
+// clang-format off
+static inline ulog_kv_field ulog_kv_bool(const char *key, bool value)
+    { return (ulog_kv_field){.key = key, .type = ULOG_KV_BOOL, .value.b = value}; }
+
+static inline ulog_kv_field ulog_kv_int(const char *key, int64_t value)
+    { return (ulog_kv_field){.key = key, .type = ULOG_KV_INT, .value.i = value}; }
+
+static inline ulog_kv_field ulog_kv_uint(const char *key, uint64_t value)
+    { return (ulog_kv_field){.key = key, .type = ULOG_KV_UINT, .value.u = value}; }
+
+static inline ulog_kv_field ulog_kv_double(const char *key, double value)
+    { return (ulog_kv_field){.key = key, .type = ULOG_KV_DOUBLE, .value.d = value}; }
+
+static inline ulog_kv_field ulog_kv_string(const char *key, const char *value)
+    { return (ulog_kv_field){.key = key, .type = ULOG_KV_STRING, .value.s = value}; }
+
+/// @brief Builds a `ulog_kv_field` choosing the value type with `_Generic`
+/// @param KEY Field name
+/// @param VALUE Field value (bool, integer, floating point or string)
+#define ULOG_KV(KEY, VALUE) _Generic((VALUE),                                  \
+    bool: ulog_kv_bool,                                                        \
+    char: ulog_kv_int, signed char: ulog_kv_int, short: ulog_kv_int,           \
+    int: ulog_kv_int, long: ulog_kv_int, long long: ulog_kv_int,               \
+    unsigned char: ulog_kv_uint, unsigned short: ulog_kv_uint,                 \
+    unsigned int: ulog_kv_uint, unsigned long: ulog_kv_uint,                   \
+    unsigned long long: ulog_kv_uint,                                          \
+    float: ulog_kv_double, double: ulog_kv_double,                             \
+    char *: ulog_kv_string, const char *: ulog_kv_string)(KEY, VALUE)
+
+// Expands "key", value pairs (up to 8) into `fields, count` arguments
+#define ULOG_KV_LIST(...) ULOG_KV_CAT(ULOG_KV_LIST_, ULOG_KV_NARG(__VA_ARGS__))(__VA_ARGS__)
+#define ULOG_KV_CAT(A, B) ULOG_KV_CAT_(A, B)
+#define ULOG_KV_CAT_(A, B) A##B
+#define ULOG_KV_NARG(...) ULOG_KV_NARG_(__VA_OPT__(__VA_ARGS__,) 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define ULOG_KV_NARG_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define ULOG_KV_PAIRS_2(K, V) ULOG_KV(K, V)
+#define ULOG_KV_PAIRS_4(K, V, ...) ULOG_KV(K, V), ULOG_KV_PAIRS_2(__VA_ARGS__)
+#define ULOG_KV_PAIRS_6(K, V, ...) ULOG_KV(K, V), ULOG_KV_PAIRS_4(__VA_ARGS__)
+#define ULOG_KV_PAIRS_8(K, V, ...) ULOG_KV(K, V), ULOG_KV_PAIRS_6(__VA_ARGS__)
+#define ULOG_KV_PAIRS_10(K, V, ...) ULOG_KV(K, V), ULOG_KV_PAIRS_8(__VA_ARGS__)
+#define ULOG_KV_PAIRS_12(K, V, ...) ULOG_KV(K, V), ULOG_KV_PAIRS_10(__VA_ARGS__)
+#define ULOG_KV_PAIRS_14(K, V, ...) ULOG_KV(K, V), ULOG_KV_PAIRS_12(__VA_ARGS__)
+#define ULOG_KV_PAIRS_16(K, V, ...) ULOG_KV(K, V), ULOG_KV_PAIRS_14(__VA_ARGS__)
+#define ULOG_KV_LIST_0() nullptr, 0
+#define ULOG_KV_LIST_2(...) (const ulog_kv_field[]){ULOG_KV_PAIRS_2(__VA_ARGS__)}, 1
+#define ULOG_KV_LIST_4(...) (const ulog_kv_field[]){ULOG_KV_PAIRS_4(__VA_ARGS__)}, 2
+#define ULOG_KV_LIST_6(...) (const ulog_kv_field[]){ULOG_KV_PAIRS_6(__VA_ARGS__)}, 3
+#define ULOG_KV_LIST_8(...) (const ulog_kv_field[]){ULOG_KV_PAIRS_8(__VA_ARGS__)}, 4
+#define ULOG_KV_LIST_10(...) (const ulog_kv_field[]){ULOG_KV_PAIRS_10(__VA_ARGS__)}, 5
+#define ULOG_KV_LIST_12(...) (const ulog_kv_field[]){ULOG_KV_PAIRS_12(__VA_ARGS__)}, 6
+#define ULOG_KV_LIST_14(...) (const ulog_kv_field[]){ULOG_KV_PAIRS_14(__VA_ARGS__)}, 7
+#define ULOG_KV_LIST_16(...) (const ulog_kv_field[]){ULOG_KV_PAIRS_16(__VA_ARGS__)}, 8
+// clang-format on
+
 /* ============================================================================
    Core: Events
 ============================================================================ */
@@ -154,6 +234,52 @@ ulog_level ulog_event_get_level(ulog_event *ev);
 ///         or time feature disabled
 struct tm *ulog_event_get_time(ulog_event *ev);
 
+/// @brief Get the ID of the thread that logged the event (requires
+/// ULOG_BUILD_THREAD_INFO=1). On Linux the kernel thread ID (`gettid`),
+/// elsewhere a number handed out per thread in order of first use.
+/// @param ev Event to get the thread ID from
+/// @return Thread ID, or -1 if event is nullptr
+int64_t ulog_event_get_thread_id(ulog_event *ev);
+
+/// @brief Get the name of the thread that logged the event (requires
+/// ULOG_BUILD_THREAD_INFO=1)
+/// @param ev Event to get the thread name from
+/// @return Name set with `ulog_thread_name_set`, else the system name of the
+/// thread when it first logged, "" if unknown, nullptr if event is nullptr.
+/// Valid only while the event is being handled.
+const char *ulog_event_get_thread_name(ulog_event *ev);
+
+/// @brief Get the CPU the event was logged on (requires
+/// ULOG_BUILD_THREAD_INFO=1)
+/// @param ev Event to get the CPU from
+/// @return CPU number, or -1 if event is nullptr, the CPU is unknown or thread
+/// info is disabled with `ulog_thread_info_config`
+int ulog_event_get_cpu(ulog_event *ev);
+
+/// @brief Get the number of structured fields attached to an event: the
+/// thread's context fields (see `ulog_context_push`), then the call's own
+/// @param ev Event to get the field count from
+/// @return Number of fields, or 0 if event is nullptr
+size_t ulog_event_get_field_count(ulog_event *ev);
+
+/// @brief Get a structured field from an event
+/// @param ev Event to get the field from
+/// @param index Field index, less than `ulog_event_get_field_count`
+/// @return Pointer to the field, or nullptr if event is nullptr or index is
+/// out of range. Valid only while the event is being handled.
+const ulog_kv_field *ulog_event_get_field(ulog_event *ev, size_t index);
+
+/// @brief Write the structured fields of an event to a buffer in logfmt form
+/// (`key=value key2="quoted value"`)
+/// @param ev Event to render fields from
+/// @param out Output buffer to write to
+/// @param out_size Size of the output buffer
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
+/// parameters
+[[nodiscard]] ulog_status ulog_event_fields_to_logfmt(ulog_event *ev,
+                                                      char *out,
+                                                      size_t out_size);
+
 /* ============================================================================
    Core: Thread Safety
 ============================================================================ */
@@ -163,13 +289,127 @@ struct tm *ulog_event_get_time(ulog_event *ev);
 /// @param lock_arg User-provided argument passed during registration
 typedef ulog_status (*ulog_lock_fn)(bool lock, void *lock_arg);
 
-/// @brief Sets the thread synchronization lock function
+/// @brief Sets the thread synchronization lock function. It guards the
+/// configuration and every output without its own lock (see
+/// `ulog_output_lock_set_fn`).
 /// @param function Lock function to use, or nullptr to disable locking
 /// @param lock_arg User argument passed to the lock function
-/// @return ULOG_STATUS_OK on success
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_BUSY if the selected logger
+///         instance was removed
 [[nodiscard]] ulog_status ulog_lock_set_fn(ulog_lock_fn function,
                                            void *lock_arg);
 
+/* ============================================================================
+   Feature: Logger Instances
+============================================================================ */
+
+/// @brief Logger instance handle
+typedef int ulog_logger_id;
+enum {
+    ULOG_LOGGER_INVALID = -0x1,  ///< Invalid instance handle
+    ULOG_LOGGER_DEFAULT = 0x0,   ///< Instance of threads that select no other
+};
+
+/// @brief Adds a logger instance (requires ULOG_BUILD_LOGGERS>0 or
+/// ULOG_BUILD_DYNAMIC_CONFIG=1). An instance has its own lock, outputs,
+/// topics, prefix, level names, runtime toggles and statistics, and starts in
+/// the state of a fresh process: stdout only, at TRACE, no lock. Call sites,
+/// their statistics and the format cache stay process-wide.
+/// @return Instance handle on success, ULOG_LOGGER_INVALID if all
+///         ULOG_BUILD_LOGGERS extra instances are taken
+[[nodiscard]] ulog_logger_id ulog_logger_add();
+
+/// @brief Cleans up an instance as `ulog_cleanup` would and frees its slot
+/// (requires ULOG_BUILD_LOGGERS>0 or ULOG_BUILD_DYNAMIC_CONFIG=1). Waits for
+/// calls already running on the instance; threads that still select it drop
+/// their events and get ULOG_STATUS_BUSY until they select another one, even
+/// if the slot is added again. Not from an output handler or prefix function
+/// of the instance itself.
+/// @param logger Instance handle
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_ERROR for the default
+///         instance, ULOG_STATUS_INVALID_ARGUMENT if the handle is out of
+///         range, ULOG_STATUS_NOT_FOUND if it is not added
+[[nodiscard]] ulog_status ulog_logger_remove(ulog_logger_id logger);
+
+/// @brief Selects the instance the calling thread logs to and configures
+/// (requires ULOG_BUILD_LOGGERS>0 or ULOG_BUILD_DYNAMIC_CONFIG=1). The logging
+/// macros and every other function of this API act on the selected instance,
+/// so threads of independent subsystems share no lock and no state. Not from
+/// an output handler or prefix function.
+/// @param logger Instance handle, ULOG_LOGGER_DEFAULT for the default one
+/// @return Previously selected instance, ULOG_LOGGER_INVALID if `logger` is not
+///         added (the selection does not change)
+[[nodiscard]] ulog_logger_id ulog_logger_use(ulog_logger_id logger);
+
+/// @brief Logs to the given instance, whatever the calling thread selected.
+/// Usually called through the `ulog_logger_*` macros. Without
+/// ULOG_BUILD_LOGGERS>0 or ULOG_BUILD_DYNAMIC_CONFIG=1 only
+/// ULOG_LOGGER_DEFAULT logs.
+/// @param logger Instance handle, events to instances not added are dropped
+/// @param level Log level for this message
+/// @param file Source file name (usually __FILE__)
+/// @param line Source line number (usually __LINE__)
+/// @param topic Topic name string, or nullptr for no topic
+/// @param message Printf-style format string
+/// @param ... Format arguments for the message
+void ulog_logger_log(ulog_logger_id logger, ulog_level level, const char *file,
+                     int line, const char *topic, const char *message, ...);
+
+// clang-format off
+/// @brief Log to instance `LOGGER`, e.g. `ulog_logger_info(shard, "%d", n)`
+#define ulog_logger(LOGGER, LEVEL, ...) ulog_logger_log(LOGGER, LEVEL, __FILE__, __LINE__, nullptr, __VA_ARGS__)
+#define ulog_logger_trace(LOGGER, ...) ulog_logger(LOGGER, ULOG_LEVEL_TRACE, __VA_ARGS__)
+#define ulog_logger_debug(LOGGER, ...) ulog_logger(LOGGER, ULOG_LEVEL_DEBUG, __VA_ARGS__)
+#define ulog_logger_info(LOGGER, ...) ulog_logger(LOGGER, ULOG_LEVEL_INFO, __VA_ARGS__)
+#define ulog_logger_warn(LOGGER, ...) ulog_logger(LOGGER, ULOG_LEVEL_WARN, __VA_ARGS__)
+#define ulog_logger_error(LOGGER, ...) ulog_logger(LOGGER, ULOG_LEVEL_ERROR, __VA_ARGS__)
+#define ulog_logger_fatal(LOGGER, ...) ulog_logger(LOGGER, ULOG_LEVEL_FATAL, __VA_ARGS__)
+
+/// @brief Log with a topic to instance `LOGGER`
+#define ulog_logger_topic_log(LOGGER, LEVEL, TOPIC_NAME, ...) ulog_logger_log(LOGGER, LEVEL, __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__)
+// clang-format on
+
+/* ============================================================================
+   Feature: Thread Info
+============================================================================ */
+
+/// @brief Names the calling thread in its events (requires
+/// ULOG_BUILD_THREAD_INFO=1 or ULOG_BUILD_DYNAMIC_CONFIG=1). Without it the
+/// system name the thread has when it first logs is used. Takes no lock.
+/// @param name Thread name, truncated to 15 characters
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if name is
+///         nullptr
+[[nodiscard]] ulog_status ulog_thread_name_set(const char *name);
+
+/* ============================================================================
+   Feature: Context
+============================================================================ */
+
+/// @brief Pushes a field onto the calling thread's context (requires
+/// ULOG_BUILD_CONTEXT_SIZE>0 or ULOG_BUILD_DYNAMIC_CONFIG=1). The context is
+/// attached to every event the thread logs, before the event's own fields.
+/// Takes no lock.
+/// @param field Field; a string value is copied (up to 63 characters), the
+///        key is not and must stay valid until the field is popped
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_ERROR if the context is
+///         full: the field is not attached but must still be popped
+[[nodiscard]] ulog_status ulog_context_push_field(ulog_kv_field field);
+
+/// @brief Pushes a "key", value pair onto the calling thread's context, the
+/// value type chosen with `_Generic`, e.g. `ulog_context_push("req", id)`
+#define ulog_context_push(KEY, VALUE)                                          \
+    ulog_context_push_field(ULOG_KV(KEY, VALUE))
+
+/// @brief Pops the field pushed last by the calling thread
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_NOT_FOUND if the context is
+///         empty
+[[nodiscard]] ulog_status ulog_context_pop();
+
+/// @brief Pops every field of the calling thread, e.g. when a pooled thread
+/// finishes a request
+/// @return ULOG_STATUS_OK
+[[nodiscard]] ulog_status ulog_context_clear();
+
 /* ============================================================================
    Feature: Dynamic Config
 ============================================================================ */
@@ -202,6 +442,13 @@ typedef ulog_status (*ulog_lock_fn)(bool lock, void *lock_arg);
 ///         acquired
 [[nodiscard]] ulog_status ulog_time_config(bool enabled);
 
+/// @brief Enable or disable the thread ID, name and CPU in logs (requires
+/// ULOG_BUILD_DYNAMIC_CONFIG=1, where it is disabled by default)
+/// @param enabled True to show thread info, false to hide
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_BUSY if lock cannot be
+///         acquired
+[[nodiscard]] ulog_status ulog_thread_info_config(bool enabled);
+
 /// @brief Log level configuration styles
 typedef enum {
     ULOG_LEVEL_CONFIG_STYLE_DEFAULT = 0,  /// Use default style (e.g. `DEBUG`)
@@ -234,12 +481,38 @@ typedef void (*ulog_prefix_fn)(ulog_event *ev, char *prefix,
                                size_t prefix_size);
 
 /// @brief Sets the custom prefix generation function (requires
-///        ULOG_BUILD_PREFIX_SIZE>0 or ULOG_BUILD_DYNAMIC_CONFIG=1)
+///        ULOG_BUILD_PREFIX_SIZE>0 or ULOG_BUILD_DYNAMIC_CONFIG=1). In
+///        ULOG_PREFIX_MODE_EVENT it runs without the global lock, so events
+///        logged before the call may still run the previous function.
 /// @param function Handler function to generate prefix, or nullptr to disable
 /// @return ULOG_STATUS_OK on success, ULOG_STATUS_BUSY if lock cannot be
 ///         acquired, ULOG_STATUS_INVALID_ARGUMENT if function is nullptr
 [[nodiscard]] ulog_status ulog_prefix_set_fn(ulog_prefix_fn function);
 
+/// @brief When the prefix function runs
+typedef enum {
+    ULOG_PREFIX_MODE_EVENT = 0,  ///< For every event (default)
+    /// Once per thread: the prefix is cached in thread-local storage and
+    /// reused until the thread pushes, pops or clears a context field, or
+    /// calls `ulog_prefix_invalidate`, or `ulog_prefix_set_fn` or
+    /// `ulog_prefix_mode_set` is called. For prefixes that depend on the
+    /// thread's context only (thread name, request ID), not on the event.
+    ULOG_PREFIX_MODE_THREAD,
+} ulog_prefix_mode;
+
+/// @brief Sets when the prefix function runs (requires
+///        ULOG_BUILD_PREFIX_SIZE>0 or ULOG_BUILD_DYNAMIC_CONFIG=1)
+/// @param mode Prefix mode
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_BUSY if lock cannot be
+///         acquired, ULOG_STATUS_INVALID_ARGUMENT if the mode is invalid
+[[nodiscard]] ulog_status ulog_prefix_mode_set(ulog_prefix_mode mode);
+
+/// @brief Tells that the calling thread's context changed: its next event
+/// renders the prefix again in ULOG_PREFIX_MODE_THREAD (requires
+/// ULOG_BUILD_PREFIX_SIZE>0 or ULOG_BUILD_DYNAMIC_CONFIG=1). Takes no lock.
+/// @return ULOG_STATUS_OK
+[[nodiscard]] ulog_status ulog_prefix_invalidate();
+
 /* ============================================================================
    Feature: Output
 ============================================================================ */
@@ -261,16 +534,31 @@ typedef void (*ulog_output_handler_fn)(ulog_event *ev, void *arg);
 /// @param output Output handle to configure
 /// @param level Minimum log level for this output
 /// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
-///         parameters, ULOG_STATUS_NOT_FOUND if output not found
+///         parameters, ULOG_STATUS_NOT_FOUND if output not found,
+///         ULOG_STATUS_BUSY if the lock cannot be taken
 [[nodiscard]] ulog_status ulog_output_level_set(ulog_output_id output,
                                                 ulog_level level);
 
 /// @brief Sets the minimum log level for all outputs
 /// @param level Minimum log level for all outputs
 /// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
-/// level
+/// level, ULOG_STATUS_BUSY if the lock cannot be taken
 [[nodiscard]] ulog_status ulog_output_level_set_all(ulog_level level);
 
+/// @brief Gives an output its own lock. The output's handler then runs under
+/// that lock after the global lock is released, so threads logging to
+/// different outputs proceed in parallel and a slow handler only holds up its
+/// own output. Topics must outlive the events logged with them.
+/// @param output Output handle
+/// @param function Lock function, or nullptr to run the output under the
+///                 global lock again
+/// @param lock_arg User argument passed to the lock function
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
+///         handle, ULOG_STATUS_BUSY if a lock cannot be taken
+[[nodiscard]] ulog_status ulog_output_lock_set_fn(ulog_output_id output,
+                                                  ulog_lock_fn function,
+                                                  void *lock_arg);
+
 /// @brief Adds a custom output handler (requires ULOG_BUILD_EXTRA_OUTPUTS>0
 /// or ULOG_BUILD_DYNAMIC_CONFIG=1)
 /// @param handler Function to handle log events
@@ -287,6 +575,27 @@ typedef void (*ulog_output_handler_fn)(ulog_event *ev, void *arg);
 /// @return Output handle on success, ULOG_OUTPUT_INVALID on error
 [[nodiscard]] ulog_output_id ulog_output_add_file(FILE *file, ulog_level level);
 
+/// @brief Adds a JSON lines file output (requires ULOG_BUILD_JSON_OUTPUT=1 and
+/// ULOG_BUILD_EXTRA_OUTPUTS>0, or ULOG_BUILD_DYNAMIC_CONFIG=1). Each event is
+/// written as one object with time, level, topic, file, line, msg and the
+/// structured fields as top-level keys.
+/// @param file File pointer to write logs to (must remain valid)
+/// @param level Minimum log level for this file output
+/// @return Output handle on success, ULOG_OUTPUT_INVALID on error
+[[nodiscard]] ulog_output_id ulog_output_add_json_file(FILE *file,
+                                                       ulog_level level);
+
+/// @brief Adds a compact binary file output (requires
+/// ULOG_BUILD_BINARY_OUTPUT=1 and ULOG_BUILD_EXTRA_OUTPUTS>0, or
+/// ULOG_BUILD_DYNAMIC_CONFIG=1). Records are CRC32C protected; decode them with
+/// `tools/ulog_binary_convert`. Writes the stream header immediately.
+/// @param file File pointer opened in binary mode (must remain valid)
+/// @param level Minimum log level for this file output
+/// @return Output handle on success, ULOG_OUTPUT_INVALID on error or when all
+///         binary streams are in use
+[[nodiscard]] ulog_output_id ulog_output_add_binary_file(FILE *file,
+                                                         ulog_level level);
+
 /// @brief Removes an output from the logging system (requires
 /// ULOG_BUILD_EXTRA_OUTPUTS>0 or ULOG_BUILD_DYNAMIC_CONFIG=1)
 /// @param output Output handle to remove
@@ -294,6 +603,86 @@ typedef void (*ulog_output_handler_fn)(ulog_event *ev, void *arg);
 ///         handle, ULOG_STATUS_NOT_FOUND if output not found
 [[nodiscard]] ulog_status ulog_output_remove(ulog_output_id output);
 
+/// @brief What an isolated output does with an event when its queue is full
+typedef enum {
+    ULOG_QUEUE_DROP_NEWEST = 0,  ///< Drop the new event (default)
+    ULOG_QUEUE_DROP_OLDEST,      ///< Drop the oldest queued event
+    ULOG_QUEUE_BLOCK,            ///< Wait up to `timeout_ms`, then drop newest
+    ULOG_QUEUE_DROP_BELOW,       ///< Drop events below `level`; wait up to
+                                 ///< `timeout_ms` for space for the others
+    ULOG_QUEUE_POLICY_TOTAL,
+} ulog_queue_policy;
+
+/// @brief Backpressure policy of an isolated output
+typedef struct {
+    ulog_queue_policy policy;
+    uint32_t timeout_ms;  ///< ULOG_QUEUE_BLOCK, ULOG_QUEUE_DROP_BELOW:
+                          ///< longest wait for space
+    ulog_level level;     ///< ULOG_QUEUE_DROP_BELOW: lowest level kept
+} ulog_queue_policy_config;
+
+/// @brief Queue counters of an isolated output. `dropped` is the sum of the
+/// policy decisions that lost an event.
+typedef struct {
+    size_t capacity;          ///< Events the queue holds
+    size_t depth;             ///< Events waiting for the worker
+    size_t max_depth;         ///< Highest depth since the queue was started
+    uint64_t enqueued;        ///< Events accepted by the queue
+    uint64_t delivered;       ///< Events the worker passed to the handler
+    uint64_t dropped;         ///< Events lost because the queue was full
+    uint64_t dropped_newest;  ///< New events dropped on a full queue
+    uint64_t dropped_oldest;  ///< Queued events evicted by newer ones
+    uint64_t dropped_below;   ///< Events below the policy level dropped or
+                              ///< evicted (ULOG_QUEUE_DROP_BELOW)
+    uint64_t blocked;         ///< Loggers that waited for space
+    uint64_t timed_out;       ///< Waits that ended with the event dropped
+} ulog_queue_stats;
+
+/// @brief Isolates an output (requires ULOG_BUILD_OUTPUT_QUEUE_SIZE>0 and C11
+/// threads, or ULOG_BUILD_DYNAMIC_CONFIG=1). Its events are copied into a
+/// bounded queue and passed to the handler by a worker thread of its own, so a
+/// stalled handler only fills its queue while the other outputs keep flowing.
+/// When the queue is full, the policy set with `ulog_output_queue_policy_set`
+/// decides which event is lost (by default the new one). Messages and
+/// field strings share ULOG_BUILD_OUTPUT_QUEUE_SIZE bytes per event and are
+/// truncated beyond that. The handler keeps the output's own lock, if any.
+/// @param output Output handle
+/// @param capacity Events the queue holds, or 0 to deliver the queued events
+///                 and run the output in the caller's thread again
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
+///         handle, ULOG_STATUS_NOT_FOUND if output not found, ULOG_STATUS_BUSY
+///         if the lock cannot be taken, ULOG_STATUS_ERROR if the queue or the
+///         thread cannot be created
+[[nodiscard]] ulog_status ulog_output_isolate(ulog_output_id output,
+                                              size_t capacity);
+
+/// @brief Waits until the worker of an isolated output has handled every
+/// queued event
+/// @param output Output handle
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
+///         handle, ULOG_STATUS_NOT_FOUND if the output is not isolated
+[[nodiscard]] ulog_status ulog_output_drain(ulog_output_id output);
+
+/// @brief Reads the queue counters of an isolated output
+/// @param output Output handle
+/// @param out Counters, zeroed if the output is not isolated
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
+///         parameters, ULOG_STATUS_NOT_FOUND if the output is not isolated
+[[nodiscard]] ulog_status ulog_output_queue_get(ulog_output_id output,
+                                                ulog_queue_stats *out);
+
+/// @brief Sets what the queue of an output does when it is full. Kept when the
+/// output is isolated again, reset by `ulog_cleanup`. Only ULOG_QUEUE_BLOCK and
+/// ULOG_QUEUE_DROP_BELOW (for events at or above `level`) make `ulog_log` wait,
+/// at most `timeout_ms`; the other decisions take constant time.
+/// @param output Output handle
+/// @param config Policy, wait limit and level
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
+///         parameters, ULOG_STATUS_BUSY if the lock cannot be taken
+[[nodiscard]] ulog_status
+ulog_output_queue_policy_set(ulog_output_id output,
+                             ulog_queue_policy_config config);
+
 /* ============================================================================
    Feature: Topics (2/2)
 ============================================================================ */
@@ -310,50 +699,59 @@ typedef void (*ulog_output_handler_fn)(ulog_event *ev, void *arg);
 /// @param LEVEL Log level
 /// @param TOPIC_NAME Topic name string
 /// @param ... Format string and arguments (printf-style)
-#define ulog_topic_log(LEVEL, TOPIC_NAME,...) ulog_log(LEVEL, __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__)
+#define ulog_topic_log(LEVEL, TOPIC_NAME,...) ULOG_LOG_SITE(LEVEL, TOPIC_NAME, __VA_ARGS__)
 #define ulog_t(...) ulog_topic_log(__VA_ARGS__) // Alias for `ulog_topic_log`
 
 /// @brief Alias: `ulog_t_trace`. Log a TRACE level message with topic (requires ULOG_BUILD_TOPICS!=0 or
 /// ULOG_BUILD_DYNAMIC_CONFIG=1)
 /// @param TOPIC_NAME Topic name string
 /// @param ... Format string and arguments (printf-style)
-#define ulog_topic_trace(TOPIC_NAME, ...) ulog_log(ULOG_LEVEL_TRACE, __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__)
+#define ulog_topic_trace(TOPIC_NAME, ...) ULOG_LOG_SITE(ULOG_LEVEL_TRACE, TOPIC_NAME, __VA_ARGS__)
 #define ulog_t_trace(...) ulog_topic_trace(__VA_ARGS__) // Alias for `ulog_topic_trace`
 
 /// @brief Alias: `ulog_t_debug`. Log a DEBUG level message with topic (requires ULOG_BUILD_TOPICS!=0 or
 /// ULOG_BUILD_DYNAMIC_CONFIG=1)
 /// @param TOPIC_NAME Topic name string
 /// @param ... Format string and arguments (printf-style)
-#define ulog_topic_debug(TOPIC_NAME, ...) ulog_log(ULOG_LEVEL_DEBUG, __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__)
+#define ulog_topic_debug(TOPIC_NAME, ...) ULOG_LOG_SITE(ULOG_LEVEL_DEBUG, TOPIC_NAME, __VA_ARGS__)
 #define ulog_t_debug(...) ulog_topic_debug(__VA_ARGS__)  // Alias for `ulog_topic_debug`
 
 /// @brief Alias: `ulog_t_info`. Log an INFO level message with topic (requires ULOG_BUILD_TOPICS!=0 or
 /// ULOG_BUILD_DYNAMIC_CONFIG=1)
 /// @param TOPIC_NAME Topic name string
 /// @param ... Format string and arguments (printf-style)
-#define ulog_topic_info(TOPIC_NAME, ...) ulog_log(ULOG_LEVEL_INFO, __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__)
+#define ulog_topic_info(TOPIC_NAME, ...) ULOG_LOG_SITE(ULOG_LEVEL_INFO, TOPIC_NAME, __VA_ARGS__)
 #define ulog_t_info(...) ulog_topic_info(__VA_ARGS__)  // Alias for `ulog_topic_info`
 
 /// @brief Alias: `ulog_t_warn`. Log a WARN level message with topic (requires ULOG_BUILD_TOPICS!=0 or
 /// ULOG_BUILD_DYNAMIC_CONFIG=1)
 /// @param TOPIC_NAME Topic name string
 /// @param ... Format string and arguments (printf-style)
-#define ulog_topic_warn(TOPIC_NAME, ...) ulog_log(ULOG_LEVEL_WARN, __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__)
+#define ulog_topic_warn(TOPIC_NAME, ...) ULOG_LOG_SITE(ULOG_LEVEL_WARN, TOPIC_NAME, __VA_ARGS__)
 #define ulog_t_warn(...) ulog_topic_warn(__VA_ARGS__)  // Alias for `ulog_topic_warn`
 
 /// @brief Alias: `ulog_t_error`. Log an ERROR level message with topic (requires ULOG_BUILD_TOPICS!=0 or
 /// ULOG_BUILD_DYNAMIC_CONFIG=1)
 /// @param TOPIC_NAME Topic name string
 /// @param ... Format string and arguments (printf-style)
-#define ulog_topic_error(TOPIC_NAME, ...) ulog_log(ULOG_LEVEL_ERROR, __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__)
+#define ulog_topic_error(TOPIC_NAME, ...) ULOG_LOG_SITE(ULOG_LEVEL_ERROR, TOPIC_NAME, __VA_ARGS__)
 #define ulog_t_error(...) ulog_topic_error(__VA_ARGS__)  // Alias for `ulog_topic_error`
 
 /// @brief Alias: `ulog_t_fatal`. Log a FATAL level message with topic (requires ULOG_BUILD_TOPICS!=0 or
 /// ULOG_BUILD_DYNAMIC_CONFIG=1)
 /// @param TOPIC_NAME Topic name string
 /// @param ... Format string and arguments (printf-style)
-#define ulog_topic_fatal(TOPIC_NAME, ...) ulog_log(ULOG_LEVEL_FATAL, __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__)
+#define ulog_topic_fatal(TOPIC_NAME, ...) ULOG_LOG_SITE(ULOG_LEVEL_FATAL, TOPIC_NAME, __VA_ARGS__)
 #define ulog_t_fatal(...) ulog_topic_fatal(__VA_ARGS__)  // Alias for `ulog_topic_fatal`
+
+/// @brief Alias: `ulog_t_kv`. Log a message with topic and structured fields (requires
+/// ULOG_BUILD_TOPICS!=0 or ULOG_BUILD_DYNAMIC_CONFIG=1)
+/// @param LEVEL Log level
+/// @param TOPIC_NAME Topic name string
+/// @param MSG Message string (not a format string)
+/// @param ... Up to 8 "key", value pairs
+#define ulog_topic_kv(LEVEL, TOPIC_NAME, MSG, ...) ulog_log_kv(LEVEL, __FILE__, __LINE__, TOPIC_NAME, ULOG_KV_LIST(__VA_ARGS__), "%s", MSG)
+#define ulog_t_kv(...) ulog_topic_kv(__VA_ARGS__)  // Alias for `ulog_topic_kv`
 // clang-format on
 
 /// @brief Adds a topic  (requires ULOG_BUILD_TOPICS!=0 or
@@ -385,6 +783,353 @@ ulog_topic_add(const char *topic_name, ulog_output_id output, ulog_level level);
 /// @return Topic ID on success, ULOG_TOPIC_ID_INVALID if not found
 [[nodiscard]] ulog_topic_id ulog_topic_get_id(const char *topic_name);
 
+/// @brief Topic state passed to `ulog_topic_foreach` visitors
+typedef struct {
+    ulog_topic_id id;       ///< Topic ID
+    const char *name;       ///< Topic name, valid during the visit only
+    ulog_level level;       ///< Effective minimum level, rules included
+    ulog_output_id output;  ///< Output given to `ulog_topic_add`
+    uint32_t routes;        ///< Outputs the topic routes to, bit N = ID N
+    /// Events per level that passed the topic level (requires
+    /// ULOG_BUILD_STATS=1, zero otherwise)
+    uint64_t emitted[ULOG_LEVEL_TOTAL];
+    /// Events per level rejected by the topic level (requires
+    /// ULOG_BUILD_STATS=1, zero otherwise)
+    uint64_t filtered[ULOG_LEVEL_TOTAL];
+} ulog_topic_info;
+
+/// @brief Topic visitor for `ulog_topic_foreach`
+/// @param info Topic state
+/// @param arg User argument
+typedef void (*ulog_topic_visit_fn)(const ulog_topic_info *info, void *arg);
+
+/// @brief Calls `visit` for every topic (requires ULOG_BUILD_TOPICS!=0 or
+/// ULOG_BUILD_DYNAMIC_CONFIG=1). Runs under the configuration lock: the visitor
+/// must not log or change the configuration.
+/// @param visit Visitor function
+/// @param arg User argument passed to the visitor
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if `visit`
+///         is nullptr, ULOG_STATUS_BUSY if the lock cannot be taken
+[[nodiscard]] ulog_status ulog_topic_foreach(ulog_topic_visit_fn visit,
+                                             void *arg);
+
+/// @brief Sets a level rule for dotted topic names (requires
+/// ULOG_BUILD_TOPICS!=0 or ULOG_BUILD_DYNAMIC_CONFIG=1). `net.tcp.rx` matches
+/// that topic, `net.*` every topic below `net`, `*` every topic. The most
+/// specific rule wins over the topic's own level: an exact name over any
+/// wildcard, a longer prefix over a shorter one. Rules apply to existing and
+/// future topics; setting a pattern again replaces its level.
+/// @param pattern Topic name, `prefix.*` or `*`
+/// @param level Minimum log level for matching topics
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if the
+///         pattern or level is invalid, ULOG_STATUS_ERROR if all rule slots
+///         are taken, ULOG_STATUS_BUSY if the lock cannot be taken
+[[nodiscard]] ulog_status ulog_topic_rule_set(const char *pattern,
+                                              ulog_level level);
+
+/// @brief Removes a level rule (requires ULOG_BUILD_TOPICS!=0 or
+/// ULOG_BUILD_DYNAMIC_CONFIG=1). Matching topics fall back to the next
+/// matching rule or their own level.
+/// @param pattern Pattern given to `ulog_topic_rule_set`
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_NOT_FOUND if there is no
+///         such rule
+[[nodiscard]] ulog_status ulog_topic_rule_remove(const char *pattern);
+
+/// @brief Routes a topic to one more output, or changes the level of an
+/// existing route (requires ULOG_BUILD_TOPICS!=0 or
+/// ULOG_BUILD_DYNAMIC_CONFIG=1). A topic event reaches a routed output if it
+/// passes the topic level, the route level and the output level. Routes are
+/// compiled into a per-topic level-to-outputs table when they or the outputs
+/// change.
+/// @param topic_name Topic name string (empty or nullptr names are invalid)
+/// @param output Output to route to, ULOG_OUTPUT_ALL for every output
+/// @param level Minimum log level for this route
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
+///         parameters, ULOG_STATUS_NOT_FOUND if topic not found,
+///         ULOG_STATUS_BUSY if the lock cannot be taken
+[[nodiscard]] ulog_status ulog_topic_route_set(const char *topic_name,
+                                               ulog_output_id output,
+                                               ulog_level level);
+
+/// @brief Stops routing a topic to an output (requires ULOG_BUILD_TOPICS!=0
+/// or ULOG_BUILD_DYNAMIC_CONFIG=1)
+/// @param topic_name Topic name string (empty or nullptr names are invalid)
+/// @param output Output to drop, ULOG_OUTPUT_ALL for every output
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if invalid
+///         parameters, ULOG_STATUS_NOT_FOUND if topic not found,
+///         ULOG_STATUS_BUSY if the lock cannot be taken
+[[nodiscard]] ulog_status ulog_topic_route_remove(const char *topic_name,
+                                                  ulog_output_id output);
+
+/* ============================================================================
+   Feature: Stats
+============================================================================ */
+
+/// @brief Maximum number of outputs reported by `ulog_stats_get`: the most
+/// outputs a build can have (stdout plus 31 extra outputs), so every output
+/// is reported whatever ULOG_BUILD_EXTRA_OUTPUTS the library was built with
+enum { ULOG_STATS_OUTPUTS = 32 };
+
+/// @brief Counters of one output
+typedef struct {
+    uint64_t events;  ///< Events passed to the output handler
+    uint64_t bytes;   ///< Bytes written (built-in stream outputs only)
+} ulog_output_stats;
+
+/// @brief Snapshot of the runtime statistics. Counters are read one by one
+/// without stopping loggers, so they may be off by events in flight.
+typedef struct {
+    uint64_t events[ULOG_LEVEL_TOTAL];  ///< Delivered events per level
+    uint64_t filtered_level;            ///< Events no output level accepted
+    uint64_t filtered_topic;            ///< Events rejected by their topic
+    uint64_t dropped;                   ///< Events lost on lock failure
+    uint64_t lock_count;                ///< Lock acquisitions measured
+    uint64_t lock_wait_ns;              ///< Total time spent acquiring the lock
+    uint64_t lock_wait_max_ns;          ///< Longest lock acquisition
+    int output_count;                   ///< Number of valid `outputs`
+    ulog_output_stats outputs[ULOG_STATS_OUTPUTS];  ///< Indexed by output ID
+} ulog_stats;
+
+/// @brief Reads the runtime statistics (requires ULOG_BUILD_STATS=1 or
+/// ULOG_BUILD_DYNAMIC_CONFIG=1)
+/// @param out Destination for the snapshot
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if `out` is
+///         nullptr
+[[nodiscard]] ulog_status ulog_stats_get(ulog_stats *out);
+
+/// @brief Resets all runtime statistics to zero (requires ULOG_BUILD_STATS=1
+/// or ULOG_BUILD_DYNAMIC_CONFIG=1)
+/// @return ULOG_STATUS_OK on success
+[[nodiscard]] ulog_status ulog_stats_reset();
+
+/// @brief Summary of one output's handler latency histogram. Percentiles are
+/// accurate to the histogram bucket width (12.5% of the value).
+typedef struct {
+    uint64_t count;    ///< Handler calls measured
+    uint64_t sum_ns;   ///< Total handler time
+    uint64_t min_ns;   ///< Fastest call
+    uint64_t max_ns;   ///< Slowest call
+    uint64_t p50_ns;   ///< Median
+    uint64_t p90_ns;   ///< 90th percentile
+    uint64_t p99_ns;   ///< 99th percentile
+    uint64_t p999_ns;  ///< 99.9th percentile
+} ulog_latency_stats;
+
+/// @brief Reads the handler latency histogram of an output (requires
+/// ULOG_BUILD_STATS=1 or ULOG_BUILD_DYNAMIC_CONFIG=1)
+/// @param output Output handle
+/// @param out Destination for the summary
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if the
+///         handle is out of range or `out` is nullptr
+[[nodiscard]] ulog_status ulog_stats_latency_get(ulog_output_id output,
+                                                 ulog_latency_stats *out);
+
+/// @brief Clears the handler latency histogram of an output (requires
+/// ULOG_BUILD_STATS=1 or ULOG_BUILD_DYNAMIC_CONFIG=1)
+/// @param output Output handle, or ULOG_OUTPUT_ALL for every output
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if the
+///         handle is out of range
+[[nodiscard]] ulog_status ulog_stats_latency_reset(ulog_output_id output);
+
+/// @brief Writes every non-empty latency histogram as text: one summary line
+/// per output followed by its non-empty buckets (requires ULOG_BUILD_STATS=1
+/// or ULOG_BUILD_DYNAMIC_CONFIG=1)
+/// @param file Destination stream
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if `file` is
+///         nullptr
+[[nodiscard]] ulog_status ulog_stats_latency_dump(FILE *file);
+
+/// @brief Writes the call sites with the most rendered bytes, most events
+/// first among equals: bytes, emitted and filtered events and `file:line` per
+/// line (requires ULOG_BUILD_CALLSITE_STATS>0 and ULOG_BUILD_STATS=1 or
+/// ULOG_BUILD_DYNAMIC_CONFIG=1). Sites are told apart by the `file` pointer and
+/// `line` passed to `ulog_log`; ULOG_BUILD_CALLSITE_STATS is the number of
+/// slots, a site is tracked if one of the 8 slots after its hash is free.
+/// @param top_n Maximum number of sites to write
+/// @param file Destination stream
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if `file` is
+///         nullptr, ULOG_STATUS_ERROR if the report buffer cannot be allocated
+[[nodiscard]] ulog_status ulog_callsite_report(size_t top_n, FILE *file);
+
+/// @brief Clears the call-site counters; tracked sites keep their slots
+/// (requires ULOG_BUILD_CALLSITE_STATS>0 and ULOG_BUILD_STATS=1 or
+/// ULOG_BUILD_DYNAMIC_CONFIG=1)
+/// @return ULOG_STATUS_OK on success
+[[nodiscard]] ulog_status ulog_callsite_reset();
+
+/* ============================================================================
+   Feature: Format Cache
+============================================================================ */
+
+/// @brief Maximum number of conversions a cached format program holds.
+/// Formats with more conversions are formatted without the cache.
+enum { ULOG_FORMAT_CACHE_OPS = 8 };
+
+/// @brief One step of a cached format program: a literal span of the format
+/// string followed by a conversion (internal, do not use directly)
+typedef struct {
+    uint16_t literal_offset;  ///< Literal text start in the format string
+    uint16_t literal_size;    ///< Literal text size
+    int32_t width;            ///< Field width, -1 if taken from the arguments
+    int32_t precision;        ///< Precision, -1 if none, -2 from the arguments
+    uint8_t flags;            ///< Conversion flags
+    uint8_t length;           ///< Length modifier
+    char conversion;          ///< Conversion character
+} ulog_format_op;
+
+/// @brief Per-call-site cache of a parsed format string. With
+/// ULOG_BUILD_FORMAT_CACHE=1 the logging macros create one as a `static` at
+/// every call site; the first call compiles the format into a list of
+/// literal spans and conversions, later calls only run that list (internal,
+/// do not use directly).
+typedef struct {
+    _Atomic(uint8_t) state;      ///< Not compiled, compiling, ready, uncacheable
+    uint8_t op_count;            ///< Number of used `ops`
+    uint16_t tail_offset;        ///< Literal text after the last conversion
+    uint16_t tail_size;          ///< Size of the trailing literal text
+    const char *format;          ///< Format string the program belongs to
+    ulog_format_op ops[ULOG_FORMAT_CACHE_OPS];
+} ulog_format_cache;
+
+/* ============================================================================
+   Feature: Callsite Registry
+============================================================================ */
+
+/// @brief Call-site flags, see `ulog_site`
+enum {
+    ULOG_SITE_ENABLED = 1 << 0,  ///< The call site calls into the library
+    ULOG_SITE_FORCED  = 1 << 1,  ///< Events pass the topic and output levels
+};
+
+/// @brief Descriptor of a logging macro call site. With
+/// ULOG_BUILD_CALLSITE_REGISTRY=1 every logging macro places one in the
+/// `ulog_sites` linker section and only calls into the library while `flags`
+/// is non-zero. Level, topic and format are kept if they are constants
+/// (internal, do not use directly).
+typedef struct {
+    _Atomic(uint8_t) flags;    ///< ULOG_SITE_* flags, read at every call
+    ulog_level level;          ///< Level, ULOG_LEVEL_TOTAL if not a constant
+    int line;                  ///< Source line
+    const char *file;          ///< Source file
+    const char *topic;         ///< Topic name, nullptr if none or not constant
+    const char *format;        ///< Format string, nullptr if not constant
+    ulog_format_cache *cache;  ///< Format cache of the site or nullptr
+} ulog_site;
+
+/// @brief Forces the matching call sites on: events of the sites at `level`
+/// and above pass the topic and output levels, the sites below `level` are
+/// switched off (requires ULOG_BUILD_CALLSITE_REGISTRY=1 for the library and
+/// the logging code, an ELF target and GCC or Clang).
+/// @param pattern `file[:first[-last]]`: a glob (`*`, `?`) matched against the
+/// whole `__FILE__` of the site or any part of it after a `/`, and an optional
+/// line or inclusive line range, e.g. "net/*.c:120-400"
+/// @param level Lowest level forced on. Sites whose level is not a constant
+/// are forced on at any level.
+/// @return ULOG_STATUS_OK if a site matched, ULOG_STATUS_NOT_FOUND if none
+/// did, ULOG_STATUS_INVALID_ARGUMENT if the pattern or level is invalid
+[[nodiscard]] ulog_status ulog_callsite_enable(const char *pattern,
+                                               ulog_level level);
+
+/// @brief Switches the matching call sites at `level` and below off, so they
+/// skip the call into the library (requires ULOG_BUILD_CALLSITE_REGISTRY=1)
+/// @param pattern Same as for `ulog_callsite_enable`
+/// @param level Highest level switched off. Sites whose level is not a
+/// constant are switched off at any level.
+/// @return ULOG_STATUS_OK if a site changed, ULOG_STATUS_NOT_FOUND if none
+/// did, ULOG_STATUS_INVALID_ARGUMENT if the pattern or level is invalid
+[[nodiscard]] ulog_status ulog_callsite_disable(const char *pattern,
+                                                ulog_level level);
+
+/// @brief Returns the matching call sites to the level filters (requires
+/// ULOG_BUILD_CALLSITE_REGISTRY=1)
+/// @param pattern Same as for `ulog_callsite_enable`, "*" for every site
+/// @return ULOG_STATUS_OK if a site matched, ULOG_STATUS_NOT_FOUND if none
+/// did, ULOG_STATUS_INVALID_ARGUMENT if the pattern is invalid
+[[nodiscard]] ulog_status ulog_callsite_restore(const char *pattern);
+
+/// @brief Writes every registered call site, one per line: `file:line`,
+/// level, state (on, off or forced), topic and format (requires
+/// ULOG_BUILD_CALLSITE_REGISTRY=1)
+/// @param file Destination stream
+/// @return ULOG_STATUS_OK on success, ULOG_STATUS_INVALID_ARGUMENT if `file` is
+///         nullptr
+[[nodiscard]] ulog_status ulog_callsite_list(FILE *file);
+
+/* ============================================================================
+   Feature: Callsite Descriptors
+============================================================================ */
+
+/// @brief Constant description of a logging macro call site. With
+/// ULOG_BUILD_CALLSITE_DESCRIPTORS=1 every logging macro creates one as a
+/// `static const` and passes only its address and the format arguments
+/// (internal, do not use directly).
+typedef struct {
+    const char *file;          ///< Source file
+    const char *topic;         ///< Topic name or nullptr
+    const char *format;        ///< Printf-style format string
+    ulog_format_cache *cache;  ///< Format cache of the site or nullptr
+    int line;                  ///< Source line
+    ulog_level level;          ///< Log level
+} ulog_site_desc;
+
+// clang-format off
+#define ULOG_SITE_FORMAT_(FORMAT, ...) FORMAT
+
+// The site's cache is only used for string literal formats: it is tied to the
+// format's address, which a reused buffer keeps with new contents. Compilers
+// that cannot tell a literal apart get no cache.
+#if ULOG_BUILD_FORMAT_CACHE == 1 && defined(__GNUC__)
+#define ULOG_SITE_CACHE_DECLARE_ static ulog_format_cache ulog_format_cache_site_;
+#define ULOG_SITE_CACHE_(FORMAT) (__builtin_constant_p(FORMAT) ? &ulog_format_cache_site_ : nullptr)
+#else
+#define ULOG_SITE_CACHE_DECLARE_
+#define ULOG_SITE_CACHE_(FORMAT) nullptr
+#endif
+
+#if ULOG_BUILD_CALLSITE_REGISTRY == 1 && ULOG_BUILD_DISABLED != 1
+/// @brief `X` if it is a constant expression, `OTHERWISE` if not
+#define ULOG_SITE_CONST_(X, OTHERWISE) (__builtin_constant_p(X) ? (X) : (OTHERWISE))
+
+/// @brief Logs through a registered `static` descriptor owned by the call
+/// site; switched-off sites cost one load of `flags`
+#define ULOG_LOG_SITE(LEVEL, TOPIC_NAME, ...)                                         \
+    do {                                                                              \
+        ULOG_SITE_CACHE_DECLARE_                                                      \
+        static ulog_site ulog_site_                                                   \
+            __attribute__((used, section("ulog_sites"), aligned(_Alignof(ulog_site)))) = { \
+            ULOG_SITE_ENABLED, ULOG_SITE_CONST_(LEVEL, ULOG_LEVEL_TOTAL), __LINE__,   \
+            __FILE__, ULOG_SITE_CONST_(TOPIC_NAME, nullptr),                          \
+            ULOG_SITE_CONST_(ULOG_SITE_FORMAT_(__VA_ARGS__, ), nullptr),              \
+            ULOG_SITE_CACHE_(ULOG_SITE_FORMAT_(__VA_ARGS__, ))};                      \
+        if (__atomic_load_n(&ulog_site_.flags, __ATOMIC_RELAXED) != 0) {              \
+            ulog_log_site(&ulog_site_, LEVEL, TOPIC_NAME, __VA_ARGS__);               \
+        }                                                                             \
+    } while (0)
+#elif ULOG_BUILD_CALLSITE_DESCRIPTORS == 1
+/// @brief Logs through a `static const` descriptor owned by the call site:
+/// one pointer instead of level, file, line, topic and format. Level and topic
+/// must be constants and the format a string literal.
+#define ULOG_LOG_SITE(LEVEL, TOPIC_NAME, ...) ULOG_LOG_DESC_(LEVEL, TOPIC_NAME, __VA_ARGS__)
+#define ULOG_LOG_DESC_(LEVEL, TOPIC_NAME, FORMAT, ...)                                \
+    do {                                                                              \
+        ULOG_SITE_CACHE_DECLARE_                                                      \
+        static const ulog_site_desc ulog_site_desc_ = {                               \
+            __FILE__, TOPIC_NAME, FORMAT, ULOG_SITE_CACHE_(FORMAT), __LINE__, LEVEL}; \
+        ulog_log_desc(&ulog_site_desc_ __VA_OPT__(,) __VA_ARGS__);                    \
+    } while (0)
+#elif ULOG_BUILD_FORMAT_CACHE == 1
+/// @brief Logs through a `static` format cache owned by the call site
+#define ULOG_LOG_SITE(LEVEL, TOPIC_NAME, ...)                                         \
+    do {                                                                              \
+        ULOG_SITE_CACHE_DECLARE_                                                      \
+        ulog_log_cached(ULOG_SITE_CACHE_(ULOG_SITE_FORMAT_(__VA_ARGS__, )), LEVEL,    \
+                        __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__);                 \
+    } while (0)
+#else
+#define ULOG_LOG_SITE(LEVEL, TOPIC_NAME, ...) ulog_log(LEVEL, __FILE__, __LINE__, TOPIC_NAME, __VA_ARGS__)
+#endif
+// clang-format on
+
 /* ============================================================================
    Core: Log
 ============================================================================ */
@@ -396,31 +1141,31 @@ ulog_topic_add(const char *topic_name, ulog_output_id output, ulog_level level);
 /// and `ulog_fatal`.
 /// @param level Log level for this message
 /// @param ... Format arguments for the message
-#define ulog(LEVEL,...) ulog_log(LEVEL, __FILE__, __LINE__, nullptr, __VA_ARGS__)
+#define ulog(LEVEL,...) ULOG_LOG_SITE(LEVEL, nullptr, __VA_ARGS__)
 
 /// @brief Log a TRACE level message
 /// @param ... Format string and arguments (printf-style)
-#define ulog_trace(...) ulog_log(ULOG_LEVEL_TRACE, __FILE__, __LINE__, nullptr, __VA_ARGS__)
+#define ulog_trace(...) ULOG_LOG_SITE(ULOG_LEVEL_TRACE, nullptr, __VA_ARGS__)
 
 /// @brief Log a DEBUG level message
 /// @param ... Format string and arguments (printf-style)
-#define ulog_debug(...) ulog_log(ULOG_LEVEL_DEBUG, __FILE__, __LINE__, nullptr, __VA_ARGS__)
+#define ulog_debug(...) ULOG_LOG_SITE(ULOG_LEVEL_DEBUG, nullptr, __VA_ARGS__)
 
 /// @brief Log an INFO level message
 /// @param ... Format string and arguments (printf-style)
-#define ulog_info(...) ulog_log(ULOG_LEVEL_INFO, __FILE__, __LINE__, nullptr, __VA_ARGS__)
+#define ulog_info(...) ULOG_LOG_SITE(ULOG_LEVEL_INFO, nullptr, __VA_ARGS__)
 
 /// @brief Log a WARN level message
 /// @param ... Format string and arguments (printf-style)
-#define ulog_warn(...) ulog_log(ULOG_LEVEL_WARN, __FILE__, __LINE__, nullptr, __VA_ARGS__)
+#define ulog_warn(...) ULOG_LOG_SITE(ULOG_LEVEL_WARN, nullptr, __VA_ARGS__)
 
 /// @brief Log an ERROR level message
 /// @param ... Format string and arguments (printf-style)
-#define ulog_error(...) ulog_log(ULOG_LEVEL_ERROR, __FILE__, __LINE__, nullptr, __VA_ARGS__)
+#define ulog_error(...) ULOG_LOG_SITE(ULOG_LEVEL_ERROR, nullptr, __VA_ARGS__)
 
 /// @brief Log a FATAL level message
 /// @param ... Format string and arguments (printf-style)
-#define ulog_fatal(...) ulog_log(ULOG_LEVEL_FATAL, __FILE__, __LINE__, nullptr, __VA_ARGS__)
+#define ulog_fatal(...) ULOG_LOG_SITE(ULOG_LEVEL_FATAL, nullptr, __VA_ARGS__)
 
 
 /// @brief Main logging function - typically called through macros
@@ -432,9 +1177,61 @@ ulog_topic_add(const char *topic_name, ulog_output_id output, ulog_level level);
 /// @param ... Format arguments for the message
 void ulog_log(ulog_level level, const char *file,
               int line, const char *topic, const char *message, ...);
-              
 
-/// @brief Clean up all topic, outputs and other dynamic resources
+/// @brief Logging function with a per-call-site format cache - called by the
+/// logging macros when ULOG_BUILD_FORMAT_CACHE=1. Behaves like `ulog_log` if
+/// the library is built without ULOG_BUILD_FORMAT_CACHE.
+/// @param cache Call site cache, zero-initialized before the first call
+/// @param level Log level for this message
+/// @param file Source file name (usually __FILE__)
+/// @param line Source line number (usually __LINE__)
+/// @param topic Topic name string, or nullptr for no topic
+/// @param message Printf-style format string
+/// @param ... Format arguments for the message
+void ulog_log_cached(ulog_format_cache *cache, ulog_level level,
+                     const char *file, int line, const char *topic,
+                     const char *message, ...);
+
+/// @brief Logging function of a registered call site - called by the logging
+/// macros when ULOG_BUILD_CALLSITE_REGISTRY=1. File, line and format cache
+/// come from the descriptor.
+/// @param site Call site descriptor
+/// @param level Log level for this message
+/// @param topic Topic name string, or nullptr for no topic
+/// @param message Printf-style format string
+/// @param ... Format arguments for the message
+void ulog_log_site(ulog_site *site, ulog_level level, const char *topic,
+                   const char *message, ...);
+
+/// @brief Logging function of a described call site - called by the logging
+/// macros when ULOG_BUILD_CALLSITE_DESCRIPTORS=1
+/// @param site Call site descriptor with level, file, line, topic and format
+/// @param ... Format arguments for the message
+void ulog_log_desc(const ulog_site_desc *site, ...);
+
+/// @brief Log a message with structured fields
+/// @param LEVEL Log level
+/// @param MSG Message string (not a format string)
+/// @param ... Up to 8 "key", value pairs, e.g. `"user", name, "retries", 3`
+#define ulog_kv(LEVEL, MSG, ...) ulog_log_kv(LEVEL, __FILE__, __LINE__, nullptr, ULOG_KV_LIST(__VA_ARGS__), "%s", MSG)
+
+/// @brief Logging function with structured fields - typically called through
+/// `ulog_kv` and `ulog_topic_kv` macros
+/// @param level Log level for this message
+/// @param file Source file name (usually __FILE__)
+/// @param line Source line number (usually __LINE__)
+/// @param topic Topic name string, or nullptr for no topic
+/// @param fields Array of fields, must stay valid during the call
+/// @param field_count Number of elements in `fields`
+/// @param message Printf-style format string
+/// @param ... Format arguments for the message
+void ulog_log_kv(ulog_level level, const char *file, int line,
+                 const char *topic, const ulog_kv_field *fields,
+                 size_t field_count, const char *message, ...);
+
+
+/// @brief Clean up all topic, outputs and other dynamic resources of the
+/// selected logger instance, and the call-site statistics
 [[nodiscard]] ulog_status ulog_cleanup();
 
 /* ============================================================================
@@ -457,6 +1254,27 @@ void ulog_log(ulog_level level, const char *file,
 // clang-format off
 ULOG_INLINE ulog_status ulog_cleanup() 
     { return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_logger_id ulog_logger_add()
+    { return ULOG_LOGGER_INVALID; }
+
+ULOG_INLINE ulog_status ulog_logger_remove(ulog_logger_id logger)
+    { (void)logger; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_logger_id ulog_logger_use(ulog_logger_id logger)
+    { return logger == ULOG_LOGGER_DEFAULT ? ULOG_LOGGER_DEFAULT : ULOG_LOGGER_INVALID; }
+
+ULOG_INLINE ulog_status ulog_thread_name_set(const char *name)
+    { (void)name; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_context_push_field(ulog_kv_field field)
+    { (void)field; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_context_pop()
+    { return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_context_clear()
+    { return ULOG_STATUS_DISABLED; }
     
 ULOG_INLINE ulog_status ulog_color_config(bool enabled) 
     { (void)enabled; return ULOG_STATUS_DISABLED; }
@@ -478,9 +1296,27 @@ ULOG_INLINE struct tm* ulog_event_get_time(ulog_event *ev)
     
 ULOG_INLINE ulog_topic_id ulog_event_get_topic(ulog_event *ev) 
     { (void)ev; return ULOG_TOPIC_ID_INVALID; }
+
+ULOG_INLINE int64_t ulog_event_get_thread_id(ulog_event *ev)
+    { (void)ev; return -1; }
+
+ULOG_INLINE const char *ulog_event_get_thread_name(ulog_event *ev)
+    { (void)ev; return nullptr; }
+
+ULOG_INLINE int ulog_event_get_cpu(ulog_event *ev)
+    { (void)ev; return -1; }
     
 ULOG_INLINE ulog_status ulog_event_to_cstr(ulog_event *ev, char *out, size_t out_size) 
     { (void)ev; (void)out; (void)out_size; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE size_t ulog_event_get_field_count(ulog_event *ev)
+    { (void)ev; return 0; }
+
+ULOG_INLINE const ulog_kv_field *ulog_event_get_field(ulog_event *ev, size_t index)
+    { (void)ev; (void)index; return nullptr; }
+
+ULOG_INLINE ulog_status ulog_event_fields_to_logfmt(ulog_event *ev, char *out, size_t out_size)
+    { (void)ev; (void)out; (void)out_size; return ULOG_STATUS_DISABLED; }
     
 ULOG_INLINE ulog_status ulog_level_config(ulog_level_config_style style) 
     { (void)style; return ULOG_STATUS_DISABLED; }
@@ -499,33 +1335,111 @@ ULOG_INLINE ulog_status ulog_lock_set_fn(ulog_lock_fn function, void *lock_arg)
     
 ULOG_INLINE void ulog_log(ulog_level level, const char *file, int line, const char *topic, const char *message, ...) 
     { (void)level; (void)file; (void)line; (void)topic; (void)message; }
+
+ULOG_INLINE void ulog_log_kv(ulog_level level, const char *file, int line, const char *topic, const ulog_kv_field *fields, size_t field_count, const char *message, ...)
+    { (void)level; (void)file; (void)line; (void)topic; (void)fields; (void)field_count; (void)message; }
+
+ULOG_INLINE void ulog_logger_log(ulog_logger_id logger, ulog_level level, const char *file, int line, const char *topic, const char *message, ...)
+    { (void)logger; (void)level; (void)file; (void)line; (void)topic; (void)message; }
+
+ULOG_INLINE void ulog_log_cached(ulog_format_cache *cache, ulog_level level, const char *file, int line, const char *topic, const char *message, ...)
+    { (void)cache; (void)level; (void)file; (void)line; (void)topic; (void)message; }
+
+ULOG_INLINE void ulog_log_site(ulog_site *site, ulog_level level, const char *topic, const char *message, ...)
+    { (void)site; (void)level; (void)topic; (void)message; }
+
+ULOG_INLINE void ulog_log_desc(const ulog_site_desc *site, ...)
+    { (void)site; }
     
 ULOG_INLINE ulog_output_id ulog_output_add(ulog_output_handler_fn handler, void *arg, ulog_level level) 
     { (void)handler; (void)arg; (void)level; return ULOG_OUTPUT_INVALID; }
     
 ULOG_INLINE ulog_output_id ulog_output_add_file(FILE *file, ulog_level level) 
     { (void)file; (void)level; return ULOG_OUTPUT_INVALID; }
+
+ULOG_INLINE ulog_output_id ulog_output_add_json_file(FILE *file, ulog_level level)
+    { (void)file; (void)level; return ULOG_OUTPUT_INVALID; }
+
+ULOG_INLINE ulog_output_id ulog_output_add_binary_file(FILE *file, ulog_level level)
+    { (void)file; (void)level; return ULOG_OUTPUT_INVALID; }
     
 ULOG_INLINE ulog_status ulog_output_level_set(ulog_output_id output, ulog_level level) 
     { (void)output; (void)level; return ULOG_STATUS_DISABLED; }
     
 ULOG_INLINE ulog_status ulog_output_level_set_all(ulog_level level) 
     { (void)level; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_output_lock_set_fn(ulog_output_id output, ulog_lock_fn function, void *lock_arg)
+    { (void)output; (void)function; (void)lock_arg; return ULOG_STATUS_DISABLED; }
     
 ULOG_INLINE ulog_status ulog_output_remove(ulog_output_id output) 
     { (void)output; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_output_isolate(ulog_output_id output, size_t capacity)
+    { (void)output; (void)capacity; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_output_drain(ulog_output_id output)
+    { (void)output; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_output_queue_get(ulog_output_id output, ulog_queue_stats *out)
+    { (void)output; (void)out; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_output_queue_policy_set(ulog_output_id output, ulog_queue_policy_config config)
+    { (void)output; (void)config; return ULOG_STATUS_DISABLED; }
     
 ULOG_INLINE ulog_status ulog_prefix_config(bool enabled) 
     { (void)enabled; return ULOG_STATUS_DISABLED; }
     
 ULOG_INLINE ulog_status ulog_prefix_set_fn(ulog_prefix_fn function) 
     { (void)function; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_prefix_mode_set(ulog_prefix_mode mode)
+    { (void)mode; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_prefix_invalidate()
+    { return ULOG_STATUS_DISABLED; }
     
+ULOG_INLINE ulog_status ulog_stats_get(ulog_stats *out)
+    { (void)out; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_stats_reset()
+    { return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_stats_latency_get(ulog_output_id output, ulog_latency_stats *out)
+    { (void)output; (void)out; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_stats_latency_reset(ulog_output_id output)
+    { (void)output; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_stats_latency_dump(FILE *file)
+    { (void)file; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_callsite_report(size_t top_n, FILE *file)
+    { (void)top_n; (void)file; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_callsite_reset()
+    { return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_callsite_enable(const char *pattern, ulog_level level)
+    { (void)pattern; (void)level; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_callsite_disable(const char *pattern, ulog_level level)
+    { (void)pattern; (void)level; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_callsite_restore(const char *pattern)
+    { (void)pattern; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_callsite_list(FILE *file)
+    { (void)file; return ULOG_STATUS_DISABLED; }
+
 ULOG_INLINE ulog_status ulog_source_location_config(bool enabled) 
     { (void)enabled; return ULOG_STATUS_DISABLED; }
     
 ULOG_INLINE ulog_status ulog_time_config(bool enabled) 
     { (void)enabled; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_thread_info_config(bool enabled)
+    { (void)enabled; return ULOG_STATUS_DISABLED; }
     
 ULOG_INLINE ulog_topic_id ulog_topic_add(const char *topic_name, ulog_output_id output, ulog_level level) 
     { (void)topic_name; (void)output; (void)level; return ULOG_TOPIC_ID_INVALID; }
@@ -542,6 +1456,21 @@ ULOG_INLINE ulog_status ulog_topic_level_set(const char *topic_name, ulog_level
 ULOG_INLINE ulog_status ulog_topic_remove(const char *topic_name) 
     { (void)topic_name; return ULOG_STATUS_DISABLED; }
 
+ULOG_INLINE ulog_status ulog_topic_foreach(ulog_topic_visit_fn visit, void *arg)
+    { (void)visit; (void)arg; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_topic_rule_set(const char *pattern, ulog_level level)
+    { (void)pattern; (void)level; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_topic_rule_remove(const char *pattern)
+    { (void)pattern; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_topic_route_set(const char *topic_name, ulog_output_id output, ulog_level level)
+    { (void)topic_name; (void)output; (void)level; return ULOG_STATUS_DISABLED; }
+
+ULOG_INLINE ulog_status ulog_topic_route_remove(const char *topic_name, ulog_output_id output)
+    { (void)topic_name; (void)output; return ULOG_STATUS_DISABLED; }
+
 // Redefine logging macros to be no-ops when disabled
 #undef ulog_trace
 #undef ulog_debug
@@ -564,6 +1493,17 @@ ULOG_INLINE ulog_status ulog_topic_remove(const char *topic_name)
 #undef ulog_t_error
 #undef ulog_t_fatal
 #undef ulog_t
+#undef ulog_kv
+#undef ulog_topic_kv
+#undef ulog_t_kv
+#undef ulog_logger
+#undef ulog_logger_trace
+#undef ulog_logger_debug
+#undef ulog_logger_info
+#undef ulog_logger_warn
+#undef ulog_logger_error
+#undef ulog_logger_fatal
+#undef ulog_logger_topic_log
 #define ulog_trace(...) ((void)0)
 #define ulog_debug(...) ((void)0)
 #define ulog_info(...) ((void)0)
@@ -585,6 +1525,17 @@ ULOG_INLINE ulog_status ulog_topic_remove(const char *topic_name)
 #define ulog_t_error(...) ((void)0)
 #define ulog_t_fatal(...) ((void)0)
 #define ulog_t(...) ((void)0)
+#define ulog_kv(...) ((void)0)
+#define ulog_topic_kv(...) ((void)0)
+#define ulog_t_kv(...) ((void)0)
+#define ulog_logger(...) ((void)0)
+#define ulog_logger_trace(...) ((void)0)
+#define ulog_logger_debug(...) ((void)0)
+#define ulog_logger_info(...) ((void)0)
+#define ulog_logger_warn(...) ((void)0)
+#define ulog_logger_error(...) ((void)0)
+#define ulog_logger_fatal(...) ((void)0)
+#define ulog_logger_topic_log(...) ((void)0)
 
 #undef ULOG_INLINE // not to expose it
 // clang-format on
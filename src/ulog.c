@@ -16,6 +16,11 @@
 //
 // *************************************************************************
 
+// Thread info reads the thread ID, name and CPU through GNU extensions
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "ulog/ulog.h"
 #include <stdlib.h>
 #include <string.h>
@@ -35,6 +40,18 @@
 | ULOG_BUILD_TIME                  | 0                          | ULOG_HAS_TIME             | Timestamp support        |
 | ULOG_BUILD_TOPICS_MODE           | ULOG_BUILD_TOPICS_MODE_OFF | ULOG_HAS_TOPICS           | Topics mode              |
 | ULOG_BUILD_TOPICS_STATIC_NUM     | 0                          | -                         | Topic number             |
+| ULOG_BUILD_JSON_OUTPUT           | 0                          | ULOG_HAS_JSON_OUTPUT      | JSON lines file output   |
+| ULOG_BUILD_BINARY_OUTPUT         | 0                          | ULOG_HAS_BINARY_OUTPUT    | Binary records output    |
+| ULOG_BUILD_FAST_FORMAT           | 0                          | ULOG_HAS_FAST_FORMAT      | Built-in printf engine   |
+| ULOG_BUILD_FORMAT_CACHE          | 0                          | ULOG_HAS_FORMAT_CACHE     | Per-call-site formats    |
+| ULOG_BUILD_STATS                 | 0                          | ULOG_HAS_STATS            | Runtime statistics       |
+| ULOG_BUILD_CALLSITE_STATS        | 0                          | ULOG_HAS_CALLSITE_STATS   | Per-call-site counters   |
+| ULOG_BUILD_OUTPUT_QUEUE_SIZE     | 0                          | ULOG_HAS_OUTPUT_QUEUE     | Isolated output queues   |
+| ULOG_BUILD_CALLSITE_REGISTRY     | 0                          | ULOG_HAS_CALLSITE_REGISTRY| Call-site enable flags   |
+| ULOG_BUILD_CALLSITE_DESCRIPTORS  | 0                          | -                         | Descriptor-based macros  |
+| ULOG_BUILD_LOGGERS               | 0                          | ULOG_HAS_LOGGERS          | Extra logger instances   |
+| ULOG_BUILD_THREAD_INFO           | 0                          | ULOG_HAS_THREAD_INFO      | Thread ID, name and CPU  |
+| ULOG_BUILD_CONTEXT_SIZE          | 0                          | ULOG_HAS_CONTEXT          | Thread context fields    |
 | ULOG_BUILD_DYNAMIC_CONFIG        | 0                          | ULOG_HAS_DYNAMIC_CONFIG   | Runtime toggles          |
 | ULOG_BUILD_WARN_NOT_ENABLED      | 1                          | ULOG_HAS_WARN_NOT_ENABLED | Warning stubs            |
 | ULOG_BUILD_CONFIG_HEADER_ENABLED | 0                          | -                         | Configuration header mode|
@@ -83,6 +100,42 @@
     #ifdef ULOG_BUILD_WARN_NOT_ENABLED
         #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_WARN_NOT_ENABLED"
     #endif
+    #ifdef ULOG_BUILD_JSON_OUTPUT
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_JSON_OUTPUT"
+    #endif
+    #ifdef ULOG_BUILD_BINARY_OUTPUT
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_BINARY_OUTPUT"
+    #endif
+    #ifdef ULOG_BUILD_FAST_FORMAT
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_FAST_FORMAT"
+    #endif
+    #ifdef ULOG_BUILD_FORMAT_CACHE
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_FORMAT_CACHE"
+    #endif
+    #ifdef ULOG_BUILD_STATS
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_STATS"
+    #endif
+    #ifdef ULOG_BUILD_CALLSITE_STATS
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_CALLSITE_STATS"
+    #endif
+    #ifdef ULOG_BUILD_OUTPUT_QUEUE_SIZE
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_OUTPUT_QUEUE_SIZE"
+    #endif
+    #ifdef ULOG_BUILD_CALLSITE_REGISTRY
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_CALLSITE_REGISTRY"
+    #endif
+    #ifdef ULOG_BUILD_CALLSITE_DESCRIPTORS
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_CALLSITE_DESCRIPTORS"
+    #endif
+    #ifdef ULOG_BUILD_LOGGERS
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_LOGGERS"
+    #endif
+    #ifdef ULOG_BUILD_THREAD_INFO
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_THREAD_INFO"
+    #endif
+    #ifdef ULOG_BUILD_CONTEXT_SIZE
+        #error "ULOG_BUILD_CONFIG_HEADER_ENABLED cannot be used with ULOG_BUILD_CONTEXT_SIZE"
+    #endif
 
     // The user provided configuration header
     #ifndef ULOG_BUILD_CONFIG_HEADER_NAME
@@ -153,6 +206,82 @@
     #define ULOG_HAS_TOPICS (ULOG_BUILD_TOPICS_MODE != ULOG_BUILD_TOPICS_MODE_OFF)
 #endif
 
+/* JSON output is an extra output, so it needs a free output slot */
+#ifndef ULOG_BUILD_JSON_OUTPUT
+    #define ULOG_HAS_JSON_OUTPUT 0
+#else
+    #define ULOG_HAS_JSON_OUTPUT (ULOG_BUILD_JSON_OUTPUT == 1 && ULOG_HAS_EXTRA_OUTPUTS)
+#endif
+
+/* Binary output is an extra output as well */
+#ifndef ULOG_BUILD_BINARY_OUTPUT
+    #define ULOG_HAS_BINARY_OUTPUT 0
+#else
+    #define ULOG_HAS_BINARY_OUTPUT (ULOG_BUILD_BINARY_OUTPUT == 1 && ULOG_HAS_EXTRA_OUTPUTS)
+#endif
+
+#ifndef ULOG_BUILD_FAST_FORMAT
+    #define ULOG_HAS_FAST_FORMAT 0
+#else
+    #define ULOG_HAS_FAST_FORMAT (ULOG_BUILD_FAST_FORMAT == 1)
+#endif
+
+/* The format cache runs programs of the built-in printf engine */
+#ifndef ULOG_BUILD_FORMAT_CACHE
+    #define ULOG_HAS_FORMAT_CACHE 0
+#else
+    #define ULOG_HAS_FORMAT_CACHE (ULOG_BUILD_FORMAT_CACHE == 1 && ULOG_HAS_FAST_FORMAT)
+#endif
+
+#ifndef ULOG_BUILD_STATS
+    #define ULOG_HAS_STATS 0
+#else
+    #define ULOG_HAS_STATS (ULOG_BUILD_STATS == 1)
+#endif
+
+/* Call-site counters take their byte counts from the statistics */
+#ifndef ULOG_BUILD_CALLSITE_STATS
+    #define ULOG_HAS_CALLSITE_STATS 0
+#else
+    #define ULOG_HAS_CALLSITE_STATS (ULOG_BUILD_CALLSITE_STATS > 0 && ULOG_HAS_STATS)
+#endif
+
+/* Output queues run a worker thread per isolated output */
+#ifndef ULOG_BUILD_OUTPUT_QUEUE_SIZE
+    #define ULOG_HAS_OUTPUT_QUEUE 0
+#elif defined(__STDC_NO_THREADS__)
+    #error "ULOG_BUILD_OUTPUT_QUEUE_SIZE requires C11 threads"
+#else
+    #define ULOG_HAS_OUTPUT_QUEUE (ULOG_BUILD_OUTPUT_QUEUE_SIZE > 0)
+#endif
+
+/* The call-site registry walks a linker section: ELF and GNU C only */
+#ifndef ULOG_BUILD_CALLSITE_REGISTRY
+    #define ULOG_HAS_CALLSITE_REGISTRY 0
+#elif ULOG_BUILD_CALLSITE_REGISTRY == 1 && !(defined(__ELF__) && defined(__GNUC__))
+    #error "ULOG_BUILD_CALLSITE_REGISTRY requires an ELF target and GCC or Clang"
+#else
+    #define ULOG_HAS_CALLSITE_REGISTRY (ULOG_BUILD_CALLSITE_REGISTRY == 1)
+#endif
+
+#ifndef ULOG_BUILD_LOGGERS
+    #define ULOG_HAS_LOGGERS 0
+#else
+    #define ULOG_HAS_LOGGERS (ULOG_BUILD_LOGGERS > 0)
+#endif
+
+#ifndef ULOG_BUILD_THREAD_INFO
+    #define ULOG_HAS_THREAD_INFO 0
+#else
+    #define ULOG_HAS_THREAD_INFO (ULOG_BUILD_THREAD_INFO == 1)
+#endif
+
+#ifndef ULOG_BUILD_CONTEXT_SIZE
+    #define ULOG_HAS_CONTEXT 0
+#else
+    #define ULOG_HAS_CONTEXT (ULOG_BUILD_CONTEXT_SIZE > 0)
+#endif
+
 /* ============================================================================
    Optional Feature: Dynamic Configuration
 ============================================================================ */
@@ -166,8 +295,20 @@
     #undef ULOG_BUILD_EXTRA_OUTPUTS
     #undef ULOG_BUILD_PREFIX_SIZE
     #undef ULOG_BUILD_TOPICS_MODE
+    #undef ULOG_BUILD_OUTPUT_QUEUE_SIZE
+    #undef ULOG_BUILD_LOGGERS
+    #undef ULOG_BUILD_CONTEXT_SIZE
     #undef ULOG_HAS_COLOR
     #undef ULOG_HAS_EXTRA_OUTPUTS
+    #undef ULOG_HAS_JSON_OUTPUT
+    #undef ULOG_HAS_BINARY_OUTPUT
+    #undef ULOG_HAS_STATS
+    #undef ULOG_HAS_CALLSITE_STATS
+    #undef ULOG_HAS_OUTPUT_QUEUE
+    #undef ULOG_HAS_CALLSITE_REGISTRY
+    #undef ULOG_HAS_LOGGERS
+    #undef ULOG_HAS_THREAD_INFO
+    #undef ULOG_HAS_CONTEXT
     #undef ULOG_HAS_LEVEL_LONG
     #undef ULOG_HAS_LEVEL_SHORT
     #undef ULOG_HAS_PREFIX
@@ -181,8 +322,35 @@
     #define ULOG_BUILD_PREFIX_SIZE 64
     /* In dynamic configuration mode we enable dynamic topics */
     #define ULOG_BUILD_TOPICS_MODE ULOG_BUILD_TOPICS_MODE_DYNAMIC
+    #define ULOG_BUILD_LOGGERS 4
+    #define ULOG_BUILD_CONTEXT_SIZE 8
     #define ULOG_HAS_COLOR 1
     #define ULOG_HAS_EXTRA_OUTPUTS 1
+    #define ULOG_HAS_JSON_OUTPUT 1
+    #define ULOG_HAS_BINARY_OUTPUT 1
+    #define ULOG_HAS_STATS 1
+    /* Call-site counters stay opt-in: every call looks its site up */
+    #ifdef ULOG_BUILD_CALLSITE_STATS
+        #define ULOG_HAS_CALLSITE_STATS (ULOG_BUILD_CALLSITE_STATS > 0)
+    #else
+        #define ULOG_HAS_CALLSITE_STATS 0
+    #endif
+    #define ULOG_HAS_LOGGERS 1
+    #define ULOG_HAS_THREAD_INFO 1
+    #define ULOG_HAS_CONTEXT 1
+    /* Output queues only where the platform has C11 threads */
+    #ifndef __STDC_NO_THREADS__
+        #define ULOG_BUILD_OUTPUT_QUEUE_SIZE 256
+        #define ULOG_HAS_OUTPUT_QUEUE 1
+    #else
+        #define ULOG_HAS_OUTPUT_QUEUE 0
+    #endif
+    /* The call-site registry only where the linker brackets its section */
+    #if defined(__ELF__) && defined(__GNUC__)
+        #define ULOG_HAS_CALLSITE_REGISTRY 1
+    #else
+        #define ULOG_HAS_CALLSITE_REGISTRY 0
+    #endif
     #define ULOG_HAS_LEVEL_LONG 1
     #define ULOG_HAS_LEVEL_SHORT 1
     #define ULOG_HAS_PREFIX 1
@@ -229,941 +397,5104 @@ static inline bool is_str_empty(const char *str) {
              "'%s' called with %s disabled", func, feature)
 
 #endif  // ULOG_HAS_WARN_NOT_ENABLED
+
 /* ============================================================================
-   Core Feature: Print
-   (`print_*`, depends on: - )
+   Core Functionality: Logger Instances
+   (`logger_*`, depends on: - )
 ============================================================================ */
 
-//  Private
-// ================
-
-typedef struct {
-    char *data;
-    size_t curr_pos;
-    size_t size;
-} print_buffer;
+// Every section keeps one state per logger instance and names the instance
+// of the calling thread like its former global, e.g. `output_data`. Without
+// extra instances the index is the constant 0.
+#if ULOG_HAS_LOGGERS
+#include <stdatomic.h>
 
-typedef union {
-    print_buffer buffer;
-    FILE *stream;
-} print_target_descriptor;
+enum { logger_total_num = 1 + ULOG_BUILD_LOGGERS };  // Default + extra
 
-typedef enum { PRINT_TARGET_BUFFER, PRINT_TARGET_STREAM } print_target_type;
+// State of an extra instance: the phase in the low bits, above them the number
+// of times the slot was added. A thread that selected the slot before it was
+// removed holds an older state and no longer matches, even once it is reused.
+enum {
+    logger_state_free  = 0,  // Not added
+    logger_state_owned = 1,  // Being reset or cleaned up by `ulog_logger_*`
+    logger_state_live  = 2,  // Added
+    logger_state_phase = 3,  // Mask of the phase
+    logger_state_step  = 4,  // Added to the state by each `ulog_logger_add`
+};
 
 typedef struct {
-    print_target_type type;
-    print_target_descriptor dsc;
-} print_target;
+    alignas(64) _Atomic(uint32_t) state;
+    _Atomic(uint32_t) users;  // Calls running on the instance, see `logger_pin`
+} logger_slot_t;
 
-static void print_to_target_valist(print_target *tgt, const char *format,
-                                   va_list args) {
-    if (tgt->type == PRINT_TARGET_BUFFER) {
-        auto buf = &tgt->dsc.buffer;
+// The default instance's slot stays free and unused: it is never removed
+static logger_slot_t logger_slots[logger_total_num];
 
-        if (buf->curr_pos >= buf->size) {
-            return;  // No space available
-        }
+typedef struct {
+    ulog_logger_id id;
+    uint32_t state;  // State of the slot when the thread selected it
+} logger_selection_t;
 
-        auto remaining = buf->size - buf->curr_pos;
-        auto write_pos = buf->data + buf->curr_pos;
+// Instance the thread logs to and configures, see `ulog_logger_use`
+static thread_local logger_selection_t logger_current = {ULOG_LOGGER_DEFAULT,
+                                                         0};
 
-        auto written = vsnprintf(write_pos, remaining, format, args);
-        if (written < 0) {
-            return;  // Encoding error
-        }
+#define logger_id() logger_current.id
 
-        // Update position, capping at buffer end
-        if ((size_t)written >= remaining) {
-            buf->curr_pos = buf->size;
-        } else {
-            buf->curr_pos += written;
-        }
+static void logger_select(ulog_logger_id logger) {
+    logger_current.id    = logger;
+    logger_current.state = atomic_load_explicit(&logger_slots[logger].state,
+                                                memory_order_acquire);
+}
 
-    } else if (tgt->type == PRINT_TARGET_STREAM) {
-        vfprintf(tgt->dsc.stream, format, args);
+/// @brief Keeps the selected instance from being cleaned up until
+/// `logger_unpin`. Taken with its lock, so every call that reads the instance
+/// holds it.
+/// @return false if the instance was removed since the thread selected it
+static bool logger_pin() {
+    if (logger_id() == ULOG_LOGGER_DEFAULT) {
+        return true;  // Never removed
     }
+    auto slot = &logger_slots[logger_id()];
+    atomic_fetch_add_explicit(&slot->users, 1, memory_order_seq_cst);
+    if (atomic_load_explicit(&slot->state, memory_order_seq_cst) ==
+        logger_current.state) {
+        return true;
+    }
+    atomic_fetch_sub_explicit(&slot->users, 1, memory_order_release);
+    return false;
 }
 
-static void print_to_target(print_target *tgt, const char *format, ...) {
-    va_list args;
-    va_start(args, format);
-    print_to_target_valist(tgt, format, args);
-    va_end(args);
+static void logger_unpin() {
+    if (logger_id() != ULOG_LOGGER_DEFAULT) {
+        atomic_fetch_sub_explicit(&logger_slots[logger_id()].users, 1,
+                                  memory_order_release);
+    }
 }
+#else
+enum { logger_total_num = 1 };
+#define logger_id() ULOG_LOGGER_DEFAULT
+#define logger_select(logger) (void)(logger)
+#define logger_pin() true
+#define logger_unpin() (void)0
+#endif  // ULOG_HAS_LOGGERS
 
 /* ============================================================================
-   Core Feature: Events
-   (`event_*`, depends on: Print)
+   Optional Feature: Fast Format
+   (`fmt_*`, depends on: - )
 ============================================================================ */
+#if ULOG_HAS_FAST_FORMAT
+#include <limits.h>
+#include <stdint.h>
 
 // Private
 // ================
 
-static void log_print_message(print_target *tgt, ulog_event *ev);
+// Built-in replacement for vsnprintf covering the conversions logs use most:
+// %d %i %u %x %X %o %c %s %p %f %F %e %E %g %G %% with the "-+ 0" flags,
+// width, precision, `*` and the hh/h/l/ll/z/j/t length modifiers. Anything
+// else (%n, %a, '#', long double, positional arguments, ...) hands the rest of
+// the format string and the partly consumed va_list to vsnprintf, so the
+// output is always the libc one.
 
-/// @brief Event structure
-struct ulog_event {
-    const char *message;          // Message format string
-    va_list message_format_args;  // Format arguments
+enum {
+    fmt_int_buf_size      = 24,     // 64-bit octal plus sign
+    fmt_stream_buf_size   = 512,    // Stream output is formatted here first
+    fmt_width_max         = 65536,  // Larger widths go to libc
+    fmt_inline_copy_max   = 16,     // Longer copies use memcpy/memset
+};
 
-#if ULOG_HAS_TOPICS
-    ulog_topic_id topic;
-#endif
+typedef enum {
+    FMT_LEN_NONE,
+    FMT_LEN_CHAR,     // hh
+    FMT_LEN_SHORT,    // h
+    FMT_LEN_LONG,     // l
+    FMT_LEN_LLONG,    // ll
+    FMT_LEN_SIZE,     // z
+    FMT_LEN_INTMAX,   // j
+    FMT_LEN_PTRDIFF,  // t
+} fmt_length;
 
-#if ULOG_HAS_TIME
-    struct tm *time;
-#endif
+typedef struct {
+    bool left;      // '-'
+    bool zero;      // '0'
+    char sign;      // '+', ' ' or 0
+    bool width_arg;
+    bool precision_arg;
+    int width;
+    int precision;  // -1 if not given
+    fmt_length length;
+    char conv;
+} fmt_spec;
 
-#if ULOG_HAS_SOURCE_LOCATION
-    const char *file;  // Event file name
-    int line;          // Event line number
-#endif                 // ULOG_HAS_SOURCE_LOCATION
+typedef struct {
+    char *data;
+    size_t limit;  // Bytes that may be stored, the terminator excluded
+    size_t pos;    // Logical length, may run past the limit
+} fmt_writer;
+
+static constexpr char fmt_digit_pairs[] = "00010203040506070809"
+                                          "10111213141516171819"
+                                          "20212223242526272829"
+                                          "30313233343536373839"
+                                          "40414243444546474849"
+                                          "50515253545556575859"
+                                          "60616263646566676869"
+                                          "70717273747576777879"
+                                          "80818283848586878889"
+                                          "90919293949596979899";
+
+// Conversions produce a few bytes at a time; short runs are copied inline
+// since a libc call costs more than the copy itself
+static void fmt_put(fmt_writer *w, const char *src, size_t size) {
+    auto room = w->pos < w->limit ? w->limit - w->pos : 0;
+    auto copy = size < room ? size : room;
+    auto dst  = w->data + w->pos;
+    if (copy > fmt_inline_copy_max) {
+        memcpy(dst, src, copy);
+    } else {
+        for (size_t i = 0; i < copy; i++) {
+            dst[i] = src[i];
+        }
+    }
+    w->pos += size;
+}
 
-    ulog_level level;  // Event debug level
-};
+static void fmt_pad(fmt_writer *w, char c, size_t count) {
+    auto room = w->pos < w->limit ? w->limit - w->pos : 0;
+    auto fill = count < room ? count : room;
+    auto dst  = w->data + w->pos;
+    if (fill > fmt_inline_copy_max) {
+        memset(dst, c, fill);
+    } else {
+        for (size_t i = 0; i < fill; i++) {
+            dst[i] = c;
+        }
+    }
+    w->pos += count;
+}
 
-ulog_status ulog_event_get_message(ulog_event *ev, char *buffer,
-                                   size_t buffer_size) {
-    if (ev == nullptr || buffer == nullptr || buffer_size == 0) {
-        return ULOG_STATUS_INVALID_ARGUMENT;
+/// @brief Writes the decimal digits of `value` backwards from `end`, two
+/// digits per division
+static size_t fmt_utoa_dec(char *end, uint64_t value) {
+    auto p = end;
+    while (value >= 100) {
+        auto pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        p -= 2;
+        memcpy(p, fmt_digit_pairs + pair, 2);
+    }
+    if (value >= 10) {
+        p -= 2;
+        memcpy(p, fmt_digit_pairs + value * 2, 2);
+    } else {
+        *--p = (char)('0' + value);
     }
+    return (size_t)(end - p);
+}
 
-    auto tgt = (print_target){.type       = PRINT_TARGET_BUFFER,
-                              .dsc.buffer = {buffer, 0, buffer_size}};
+static size_t fmt_utoa_base(char *end, uint64_t value, unsigned shift,
+                            const char *digits) {
+    auto p    = end;
+    auto mask = (1U << shift) - 1;
+    do {
+        *--p = digits[value & mask];
+        value >>= shift;
+    } while (value != 0);
+    return (size_t)(end - p);
+}
 
-    // Create a copy of the event to avoid va_list issues
-    auto ev_copy = *ev;
-    va_copy(ev_copy.message_format_args, ev->message_format_args);
+/// @brief Parses a number of at most `fmt_width_max`, -1 if larger
+static int fmt_parse_num(const char **p) {
+    auto value = 0;
+    while (**p >= '0' && **p <= '9') {
+        value = value * 10 + (**p - '0');
+        (*p)++;
+        if (value > fmt_width_max) {
+            return -1;
+        }
+    }
+    return value;
+}
 
-    log_print_message(&tgt, &ev_copy);
+/// @brief Parses the conversion after '%'
+/// @return Pointer past the conversion, nullptr if it has to go to libc
+static const char *fmt_parse(const char *p, fmt_spec *spec) {
+    *spec = (fmt_spec){.precision = -1};
+
+    for (;; p++) {
+        if (*p == '-') {
+            spec->left = true;
+        } else if (*p == '0') {
+            spec->zero = true;
+        } else if (*p == '+') {
+            spec->sign = '+';
+        } else if (*p == ' ') {
+            spec->sign = spec->sign == '+' ? '+' : ' ';
+        } else {
+            break;
+        }
+    }
 
-    va_end(ev_copy.message_format_args);
-    return ULOG_STATUS_OK;
-}
+    if (*p == '*') {
+        spec->width_arg = true;
+        p++;
+    } else {
+        spec->width = fmt_parse_num(&p);
+        if (spec->width < 0 || *p == '$') {
+            return nullptr;  // Huge width or positional argument
+        }
+    }
 
-#if ULOG_HAS_TOPICS
-ulog_topic_id ulog_event_get_topic(ulog_event *ev) {
-    if (ev == nullptr) {
-        return ULOG_TOPIC_ID_INVALID;  // Invalid topic
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            spec->precision_arg = true;
+            p++;
+        } else {
+            spec->precision = fmt_parse_num(&p);
+            if (spec->precision < 0) {
+                return nullptr;
+            }
+        }
     }
-    return ev->topic;
-}
-#endif  // ULOG_HAS_TOPICS
 
-#if ULOG_HAS_TIME
-struct tm *ulog_event_get_time(ulog_event *ev) {
-    if (ev == nullptr) {
+    switch (*p) {
+    case 'h':
+        spec->length = (p[1] == 'h') ? FMT_LEN_CHAR : FMT_LEN_SHORT;
+        p += (p[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        spec->length = (p[1] == 'l') ? FMT_LEN_LLONG : FMT_LEN_LONG;
+        p += (p[1] == 'l') ? 2 : 1;
+        break;
+    case 'z':
+        spec->length = FMT_LEN_SIZE;
+        p++;
+        break;
+    case 'j':
+        spec->length = FMT_LEN_INTMAX;
+        p++;
+        break;
+    case 't':
+        spec->length = FMT_LEN_PTRDIFF;
+        p++;
+        break;
+    default:
+        break;
+    }
+
+    spec->conv = *p;
+    switch (spec->conv) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+        return p + 1;
+    case 'c':
+    case 's':
+        // Wide characters and strings go to libc
+        return spec->length == FMT_LEN_NONE ? p + 1 : nullptr;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+        // %lf is a double as well, long double goes to libc
+        return (spec->length == FMT_LEN_NONE || spec->length == FMT_LEN_LONG)
+                   ? p + 1
+                   : nullptr;
+#ifdef __GLIBC__
+    case 'p':
+        // Only the plain form; flags and precision differ between libcs
+        return (spec->length == FMT_LEN_NONE && !spec->zero &&
+                spec->sign == 0 && spec->precision < 0)
+                   ? p + 1
+                   : nullptr;
+#endif
+    default:
         return nullptr;
     }
-    return ev->time;
 }
-#endif  // ULOG_HAS_TIME
 
-#if ULOG_HAS_SOURCE_LOCATION
-const char *ulog_event_get_file(ulog_event *ev) {
-    if (ev == nullptr) {
-        return nullptr;
+static int64_t fmt_arg_signed(fmt_length length, va_list *args) {
+    switch (length) {
+    case FMT_LEN_CHAR:
+        return (signed char)va_arg(*args, int);
+    case FMT_LEN_SHORT:
+        return (short)va_arg(*args, int);
+    case FMT_LEN_LONG:
+        return va_arg(*args, long);
+    case FMT_LEN_LLONG:
+        return va_arg(*args, long long);
+    case FMT_LEN_SIZE:
+        return (ptrdiff_t)va_arg(*args, size_t);
+    case FMT_LEN_INTMAX:
+        return va_arg(*args, intmax_t);
+    case FMT_LEN_PTRDIFF:
+        return va_arg(*args, ptrdiff_t);
+    default:
+        return va_arg(*args, int);
     }
-    return ev->file;
 }
 
-int ulog_event_get_line(ulog_event *ev) {
-    if (ev == nullptr) {
-        return -1;
+static uint64_t fmt_arg_unsigned(fmt_length length, va_list *args) {
+    switch (length) {
+    case FMT_LEN_CHAR:
+        return (unsigned char)va_arg(*args, unsigned);
+    case FMT_LEN_SHORT:
+        return (unsigned short)va_arg(*args, unsigned);
+    case FMT_LEN_LONG:
+        return va_arg(*args, unsigned long);
+    case FMT_LEN_LLONG:
+        return va_arg(*args, unsigned long long);
+    case FMT_LEN_SIZE:
+        return va_arg(*args, size_t);
+    case FMT_LEN_INTMAX:
+        return va_arg(*args, uintmax_t);
+    case FMT_LEN_PTRDIFF:
+        return (size_t)va_arg(*args, ptrdiff_t);
+    default:
+        return va_arg(*args, unsigned);
     }
-    return ev->line;
 }
-#endif  // ULOG_HAS_SOURCE_LOCATION
 
-ulog_level ulog_event_get_level(ulog_event *ev) {
-    if (ev == nullptr) {
-        return ULOG_LEVEL_TRACE;  // Invalid level
+/// @brief Writes `prefix`, `body` and the padding required by the spec
+static void fmt_emit(fmt_writer *w, const fmt_spec *spec, const char *prefix,
+                     size_t prefix_size, size_t zeros, const char *body,
+                     size_t body_size) {
+    auto size    = prefix_size + zeros + body_size;
+    auto padding = (size_t)spec->width > size ? (size_t)spec->width - size : 0;
+    if (!spec->left && spec->zero) {
+        zeros += padding;  // Zero padding goes between sign and digits
+        padding = 0;
+    }
+    if (!spec->left) {
+        fmt_pad(w, ' ', padding);
+    }
+    fmt_put(w, prefix, prefix_size);
+    fmt_pad(w, '0', zeros);
+    fmt_put(w, body, body_size);
+    if (spec->left) {
+        fmt_pad(w, ' ', padding);
     }
-    return ev->level;
 }
 
-/* ============================================================================
-   Core Functionality: Lock
-   (`lock_*`, depends on: - )
-============================================================================ */
+static void fmt_integer(fmt_writer *w, fmt_spec *spec, va_list *args) {
+    char buf[fmt_int_buf_size];
+    auto end       = buf + sizeof(buf);
+    auto prefix    = (char)0;
+    uint64_t value = 0;
 
-// Private
-// ================
-typedef struct {
-    ulog_lock_fn function;  // Lock function
-    void *args;             // Argument for the lock function
-} lock_data_t;
+    if (spec->conv == 'd' || spec->conv == 'i') {
+        auto sval = fmt_arg_signed(spec->length, args);
+        value     = sval < 0 ? 0 - (uint64_t)sval : (uint64_t)sval;
+        prefix    = sval < 0 ? '-' : spec->sign;
+    } else {
+        value = fmt_arg_unsigned(spec->length, args);
+    }
 
-static lock_data_t lock_data = {
-    .function = nullptr,  // No lock function by default
-    .args     = nullptr,  // No lock argument by default
-};
+    size_t size = 0;
+    if (value != 0 || spec->precision != 0) {
+        switch (spec->conv) {
+        case 'x':
+            size = fmt_utoa_base(end, value, 4, "0123456789abcdef");
+            break;
+        case 'X':
+            size = fmt_utoa_base(end, value, 4, "0123456789ABCDEF");
+            break;
+        case 'o':
+            size = fmt_utoa_base(end, value, 3, "01234567");
+            break;
+        default:
+            size = fmt_utoa_dec(end, value);
+            break;
+        }
+    }
 
-static ulog_status lock_lock() {
-    if (lock_data.function != nullptr) {
-        return lock_data.function(true, lock_data.args);
+    size_t zeros = 0;
+    if (spec->precision >= 0) {
+        spec->zero = false;  // '0' is ignored when a precision is given
+        zeros      = (size_t)spec->precision > size
+                         ? (size_t)spec->precision - size
+                         : 0;
     }
-    return ULOG_STATUS_OK;
+    fmt_emit(w, spec, &prefix, prefix != 0 ? 1 : 0, zeros, end - size,
+             size);
 }
 
-static ulog_status lock_unlock() {
-    if (lock_data.function != nullptr) {
-        return lock_data.function(false, lock_data.args);
+static void fmt_string(fmt_writer *w, fmt_spec *spec, const char *str) {
+    spec->zero = false;
+    if (str == nullptr) {
+        // glibc prints "(null)" unless the precision cuts it
+        str = (spec->precision < 0 || spec->precision >= 6) ? "(null)" : "";
     }
-    return ULOG_STATUS_OK;
+    auto size = (size_t)spec->precision;
+    if (spec->precision < 0) {
+        size = strlen(str);
+    } else {
+        // The precision allows arrays without a terminator
+        auto nul = (const char *)memchr(str, '\0', size);
+        size     = nul != nullptr ? (size_t)(nul - str) : size;
+    }
+    fmt_emit(w, spec, nullptr, 0, 0, str, size);
 }
 
-// Public
-// ================
+// Floating point conversions (%f %F %e %E %g %G) are computed exactly: the
+// double is split into mantissa and binary exponent, scaled by a power of ten
+// in 128-bit integers and rounded half to even, which is what glibc prints in
+// the default rounding mode. Values outside that exact domain (very large or
+// very small magnitudes, large precisions, inf and nan) are formatted by
+// snprintf for that one conversion.
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 fmt_u128;
 
-/// @brief  Sets the lock function and user data
-ulog_status ulog_lock_set_fn(ulog_lock_fn function, void *lock_arg) {
-    if (function == nullptr) {
-        lock_data.function = nullptr;
-        lock_data.args     = nullptr;
-        return ULOG_STATUS_OK;
+enum {
+    fmt_float_buf_size      = 64,
+    fmt_float_digits_size   = 40,  // Digits of a 128-bit integer
+    fmt_float_precision_max = 17,  // %e and %g precisions beyond go to libc
+    fmt_float_fixed_max     = 19,  // %f precisions beyond go to libc
+    fmt_float_bits_max      = 126,
+    fmt_pow5_max            = 27,  // Largest power of five in 64 bits
+};
+
+static constexpr uint64_t fmt_pow10[] = {1ULL,
+                                         10ULL,
+                                         100ULL,
+                                         1000ULL,
+                                         10000ULL,
+                                         100000ULL,
+                                         1000000ULL,
+                                         10000000ULL,
+                                         100000000ULL,
+                                         1000000000ULL,
+                                         10000000000ULL,
+                                         100000000000ULL,
+                                         1000000000000ULL,
+                                         10000000000000ULL,
+                                         100000000000000ULL,
+                                         1000000000000000ULL,
+                                         10000000000000000ULL,
+                                         100000000000000000ULL,
+                                         1000000000000000000ULL,
+                                         10000000000000000000ULL};
+
+static constexpr uint64_t fmt_pow5[] = {1ULL,
+                                        5ULL,
+                                        25ULL,
+                                        125ULL,
+                                        625ULL,
+                                        3125ULL,
+                                        15625ULL,
+                                        78125ULL,
+                                        390625ULL,
+                                        1953125ULL,
+                                        9765625ULL,
+                                        48828125ULL,
+                                        244140625ULL,
+                                        1220703125ULL,
+                                        6103515625ULL,
+                                        30517578125ULL,
+                                        152587890625ULL,
+                                        762939453125ULL,
+                                        3814697265625ULL,
+                                        19073486328125ULL,
+                                        95367431640625ULL,
+                                        476837158203125ULL,
+                                        2384185791015625ULL,
+                                        11920928955078125ULL,
+                                        59604644775390625ULL,
+                                        298023223876953125ULL,
+                                        1490116119384765625ULL,
+                                        7450580596923828125ULL};
+
+static size_t fmt_utoa_dec128(char *end, fmt_u128 value) {
+    auto p = end;
+    while (value > UINT64_MAX) {
+        auto chunk = (uint64_t)(value % fmt_pow10[19]);
+        value /= fmt_pow10[19];
+        auto size = fmt_utoa_dec(p, chunk);
+        p -= size;
+        for (; size < 19; size++) {
+            *--p = '0';
+        }
     }
-    lock_data.function = function;
-    lock_data.args     = lock_arg;
-    return ULOG_STATUS_OK;
+    p -= fmt_utoa_dec(p, (uint64_t)value);
+    return (size_t)(end - p);
 }
-/* ============================================================================
-   Optional Feature: Dynamic Configuration - Color
-   (`color_config_*`, depends on: - )
-============================================================================ */
-#if ULOG_HAS_DYNAMIC_CONFIG
-
-typedef struct {
-    bool enabled;
-} color_config;
 
-static color_config color_cfg = {
-    .enabled = (bool)ULOG_HAS_COLOR,
-};
+/// @brief Computes round(m * 2^e * 10^k), ties to even
+/// @return false if the exact value does not fit the 128-bit arithmetic
+static bool fmt_float_scale(uint64_t m, int e, int k, fmt_u128 *q) {
+    // 10^k = 5^k * 2^k, the power of two folds into the shift
+    auto binary     = e + k;
+    auto up_shift   = binary > 0 ? binary : 0;
+    auto down_shift = binary < 0 ? -binary : 0;
+    auto mul_pow    = k > 0 ? k : 0;
+    auto div_pow    = k < 0 ? -k : 0;
+    // log2(5) < 7/3, so this bounds the bits of m * 2^up_shift * 5^mul_pow
+    if (div_pow > fmt_pow5_max ||
+        53 + up_shift + (mul_pow * 7 + 2) / 3 > fmt_float_bits_max) {
+        return false;
+    }
 
-// Private
-// ================
+    auto n = (fmt_u128)m << up_shift;
+    for (; mul_pow > fmt_pow5_max; mul_pow -= fmt_pow5_max) {
+        n *= fmt_pow5[fmt_pow5_max];
+    }
+    n *= fmt_pow5[mul_pow];
+
+    auto div = fmt_pow5[div_pow];
+    auto q1  = n / div;
+    auto r1  = (uint64_t)(n % div);
+    if (down_shift == 0) {
+        auto twice = (fmt_u128)r1 * 2;
+        *q         = q1 + ((twice > div || (twice == div && (q1 & 1))) ? 1 : 0);
+        return true;
+    }
+    if (down_shift >= 128) {
+        *q = 0;  // n < 2^126, so the value is below one half
+        return true;
+    }
 
-bool color_config_is_enabled() {
-    return color_cfg.enabled;
+    // Remainder of the shift, plus r1 / div which is below one
+    auto half = (fmt_u128)1 << (down_shift - 1);
+    auto r2   = q1 & ((half << 1) - 1);
+    *q        = q1 >> down_shift;
+    if (r2 > half || (r2 == half && (r1 > 0 || (*q & 1)))) {
+        (*q)++;
+    }
+    return true;
 }
 
-// Public
-// ================
+/// @brief Rounds m * 2^e to `digits` significant digits
+/// @param q Digits as an integer in [10^(digits-1), 10^digits), 0 for zero
+/// @param exp10 Decimal exponent of the first digit
+static bool fmt_float_digits(uint64_t m, int e, int digits, fmt_u128 *q,
+                             int *exp10) {
+    if (m == 0) {
+        *q     = 0;
+        *exp10 = 0;
+        return true;
+    }
+    // floor(log10) estimate from floor(log2), exact or off by one
+    auto log2 = e + 63 - __builtin_clzll(m);
+    auto est  = log2 >= 0 ? (log2 * 78913) >> 18
+                          : -((-log2 * 78913 + 262143) >> 18);
+    auto lower = fmt_pow10[digits - 1];
+    auto upper = (fmt_u128)lower * 10;
+
+    for (auto attempt = 0; attempt < 3; attempt++) {
+        if (!fmt_float_scale(m, e, digits - 1 - est, q)) {
+            return false;
+        }
+        if (*q >= upper) {
+            est++;
+        } else if (*q < lower) {
+            est--;
+        } else {
+            *exp10 = est;
+            return true;
+        }
+    }
+    return false;
+}
 
-ulog_status ulog_color_config(bool enabled) {
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;  // Failed to acquire lock
+static size_t fmt_float_exponent(char *out, int exp10, bool upper) {
+    char buf[fmt_int_buf_size];
+    auto end  = buf + sizeof(buf);
+    auto abs  = (uint64_t)(exp10 < 0 ? -exp10 : exp10);
+    auto size = fmt_utoa_dec(end, abs);
+    auto pos  = (size_t)0;
+    out[pos++] = upper ? 'E' : 'e';
+    out[pos++] = exp10 < 0 ? '-' : '+';
+    if (size < 2) {
+        out[pos++] = '0';  // At least two exponent digits
     }
-    color_cfg.enabled = enabled;
-    return lock_unlock();
+    memcpy(out + pos, end - size, size);
+    return pos + size;
 }
 
-#else  // ULOG_HAS_DYNAMIC_CONFIG
+/// @return Body size, 0 if the value is outside the exact domain
+static size_t fmt_float_f(char *out, uint64_t m, int e, int precision) {
+    fmt_u128 q;
+    if (precision > fmt_float_fixed_max ||
+        !fmt_float_scale(m, e, precision, &q)) {
+        return 0;
+    }
+    char digits[fmt_float_digits_size];
+    auto n = fmt_utoa_dec128(digits + sizeof(digits), q);
+    auto d = digits + sizeof(digits) - n;
+
+    auto pos = (size_t)0;
+    if (n <= (size_t)precision) {
+        out[pos++] = '0';
+        out[pos++] = '.';
+        memset(out + pos, '0', (size_t)precision - n);
+        pos += (size_t)precision - n;
+        memcpy(out + pos, d, n);
+        return pos + n;
+    }
+    auto int_size = n - (size_t)precision;
+    memcpy(out, d, int_size);
+    pos = int_size;
+    if (precision > 0) {
+        out[pos++] = '.';
+        memcpy(out + pos, d + int_size, (size_t)precision);
+        pos += (size_t)precision;
+    }
+    return pos;
+}
 
-// Disabled Public
-// ================
+static size_t fmt_float_e(char *out, uint64_t m, int e, int precision,
+                          bool upper) {
+    fmt_u128 q;
+    auto exp10 = 0;
+    if (precision > fmt_float_precision_max ||
+        !fmt_float_digits(m, e, precision + 1, &q, &exp10)) {
+        return 0;
+    }
+    char digits[fmt_float_digits_size];
+    auto n = fmt_utoa_dec128(digits + sizeof(digits), q);
+    auto d = digits + sizeof(digits) - n;
+
+    auto pos   = (size_t)0;
+    out[pos++] = d[0];
+    if (precision > 0) {
+        out[pos++] = '.';
+        memcpy(out + pos, d + 1, n - 1);
+        pos += n - 1;
+        memset(out + pos, '0', (size_t)precision + 1 - n);  // Zero only
+        pos += (size_t)precision + 1 - n;
+    }
+    return pos + fmt_float_exponent(out + pos, exp10, upper);
+}
 
-#if ULOG_HAS_WARN_NOT_ENABLED
-ulog_status ulog_color_config(bool enabled) {
-    (void)(enabled);
-    warn_not_enabled("ULOG_BUILD_COLOR");
-    return ULOG_STATUS_DISABLED;
+static size_t fmt_float_g(char *out, uint64_t m, int e, int precision,
+                          bool upper) {
+    auto digits_num = precision == 0 ? 1 : precision;
+    fmt_u128 q;
+    auto exp10 = 0;
+    if (digits_num > fmt_float_precision_max + 1 ||
+        !fmt_float_digits(m, e, digits_num, &q, &exp10)) {
+        return 0;
+    }
+    char digits[fmt_float_digits_size];
+    auto n = fmt_utoa_dec128(digits + sizeof(digits), q);
+    auto d = digits + sizeof(digits) - n;
+    while (n > 1 && d[n - 1] == '0') {
+        n--;  // Trailing zeros are removed without '#'
+    }
+
+    auto pos = (size_t)0;
+    if (exp10 < -4 || exp10 >= digits_num) {
+        out[pos++] = d[0];
+        if (n > 1) {
+            out[pos++] = '.';
+            memcpy(out + pos, d + 1, n - 1);
+            pos += n - 1;
+        }
+        return pos + fmt_float_exponent(out + pos, exp10, upper);
+    }
+    if (exp10 < 0) {
+        out[pos++] = '0';
+        out[pos++] = '.';
+        memset(out + pos, '0', (size_t)(-exp10 - 1));
+        pos += (size_t)(-exp10 - 1);
+        memcpy(out + pos, d, n);
+        return pos + n;
+    }
+    auto int_size = (size_t)exp10 + 1;
+    if (n <= int_size) {
+        memcpy(out, d, n);
+        memset(out + n, '0', int_size - n);
+        return int_size;
+    }
+    memcpy(out, d, int_size);
+    pos        = int_size;
+    out[pos++] = '.';
+    memcpy(out + pos, d + int_size, n - int_size);
+    return pos + n - int_size;
+}
+#endif  // __SIZEOF_INT128__
+
+/// @brief Formats a single floating point conversion with snprintf
+static void fmt_float_libc(fmt_writer *w, const fmt_spec *spec,
+                           double value) {
+    char format[16];
+    auto pos      = (size_t)0;
+    format[pos++] = '%';
+    if (spec->left) {
+        format[pos++] = '-';
+    }
+    if (spec->zero) {
+        format[pos++] = '0';
+    }
+    if (spec->sign != 0) {
+        format[pos++] = spec->sign;
+    }
+    memcpy(format + pos, "*.*", 3);
+    format[pos + 3] = spec->conv;
+    format[pos + 4] = '\0';
+
+    auto room    = w->pos < w->limit ? w->limit - w->pos + 1 : 0;
+    auto written = snprintf(room > 0 ? w->data + w->pos : nullptr, room,
+                            format, spec->width, spec->precision, value);
+    w->pos += written > 0 ? (size_t)written : 0;
 }
-#endif  // ULOG_HAS_WARN_NOT_ENABLED
 
-// Disabled Private
-// ================
+static void fmt_float(fmt_writer *w, fmt_spec *spec, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    auto negative = (bits >> 63) != 0;
+    auto biased   = (int)((bits >> 52) & 0x7ff);
+
+#ifdef __SIZEOF_INT128__
+    if (biased != 0x7ff) {  // inf and nan are left to libc
+        auto m = bits & ((1ULL << 52) - 1);
+        auto e = -1074;  // Subnormal
+        if (biased != 0) {
+            m |= 1ULL << 52;
+            e = biased - 1075;
+        }
+        auto precision = spec->precision < 0 ? 6 : spec->precision;
+        auto upper     = spec->conv == 'E' || spec->conv == 'G';
+
+        char body[fmt_float_buf_size];
+        size_t size = 0;
+        switch (spec->conv) {
+        case 'f':
+        case 'F':
+            size = fmt_float_f(body, m, e, precision);
+            break;
+        case 'e':
+        case 'E':
+            size = fmt_float_e(body, m, e, precision, upper);
+            break;
+        default:
+            size = fmt_float_g(body, m, e, precision, upper);
+            break;
+        }
+        if (size > 0) {
+            char prefix = negative ? '-' : spec->sign;
+            fmt_emit(w, spec, &prefix, prefix != 0 ? 1 : 0, 0, body, size);
+            return;
+        }
+    }
+#else
+    (void)negative, (void)biased;
+#endif  // __SIZEOF_INT128__
 
-#define color_config_is_enabled() (ULOG_HAS_COLOR)
+    fmt_float_libc(w, spec, value);
+}
 
-#endif  // ULOG_HAS_DYNAMIC_CONFIG
+static void fmt_convert(fmt_writer *w, fmt_spec *spec, va_list *args) {
+    if (spec->width_arg) {
+        auto width = va_arg(*args, int);
+        if (width < 0) {
+            spec->left = true;
+            width      = width == INT_MIN ? INT_MAX : -width;
+        }
+        spec->width = width;
+    }
+    if (spec->precision_arg) {
+        auto precision  = va_arg(*args, int);
+        spec->precision = precision < 0 ? -1 : precision;
+    }
+    if (spec->left) {
+        spec->zero = false;
+    }
 
-/* ============================================================================
-   Optional Feature: Color
-   (`color_*`, depends on: Print, Color Config)
-============================================================================ */
-#if ULOG_HAS_COLOR
+    switch (spec->conv) {
+    case 'c': {
+        auto c     = (char)va_arg(*args, int);
+        spec->zero = false;
+        fmt_emit(w, spec, nullptr, 0, 0, &c, 1);
+        break;
+    }
+    case 's':
+        fmt_string(w, spec, va_arg(*args, const char *));
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+        fmt_float(w, spec, va_arg(*args, double));
+        break;
+    case 'p': {
+        auto ptr = (uintptr_t)va_arg(*args, void *);
+        if (ptr == 0) {
+            spec->precision = -1;
+            fmt_string(w, spec, "(nil)");
+            break;
+        }
+        char buf[fmt_int_buf_size];
+        auto end  = buf + sizeof(buf);
+        auto size = fmt_utoa_base(end, ptr, 4, "0123456789abcdef");
+        fmt_emit(w, spec, "0x", 2, 0, end - size, size);
+        break;
+    }
+    default:
+        fmt_integer(w, spec, args);
+        break;
+    }
+}
 
-//  Private
-// ================
+/// @brief Formats the remaining format string with libc
+static int fmt_fallback(fmt_writer *w, char *out, size_t size,
+                        const char *rest, va_list *args) {
+    auto room = w->pos < size ? size - w->pos : 0;
+    if (room == 0 && size > 0) {
+        out[size - 1] = '\0';
+    }
+    auto written = vsnprintf(room > 0 ? out + w->pos : nullptr, room, rest,
+                             *args);
+    if (written < 0 || w->pos + (size_t)written > INT_MAX) {
+        return -1;
+    }
+    return (int)(w->pos + (size_t)written);
+}
 
-// From https://en.wikipedia.org/wiki/ANSI_escape_code#8-bit
-// ANSI color codes from least to most attention-grabbing
-static constexpr const char color_levels[][11] = {
-    "\x1b[m",            // LEVEL_0: Color reset (default)
-    "\x1b[36m",          // LEVEL_1: Color (Cyan)
-    "\x1b[32m",          // LEVEL_2: Color (Green)
-    "\x1b[33m",          // LEVEL_3: Color (Yellow)
-    "\x1b[31m",          // LEVEL_4: Color (Red)
-    "\x1b[31m\x1b[47m",  // LEVEL_5: Color (Red on White)
-    "\x1b[43m\x1b[31m",  // LEVEL_6: Color (Yellow on Red)
-    "\x1b[41m\x1b[97m",  // LEVEL_7: Color (White on Red)
-};
+/// @brief vsnprintf-compatible formatter
+/// @param args Pointer to a local va_list, consumed by the call
+/// @return Number of characters the full output has, -1 on error
+NOT_VERY_STATIC int fmt_vformat(char *out, size_t size, const char *format,
+                                va_list *args) {
+    auto w = (fmt_writer){out, size > 0 ? size - 1 : 0, 0};
+    auto p = format;
+
+    for (;;) {
+        // Literal text is short in log formats; copying while scanning
+        // beats a strchr and memcpy call pair
+        auto pct = p;
+        for (; *pct != '\0' && *pct != '%'; pct++) {
+            if (w.pos < w.limit) {
+                out[w.pos] = *pct;
+            }
+            w.pos++;
+        }
+        if (*pct == '\0') {
+            break;
+        }
+        if (pct[1] == '%') {
+            fmt_put(&w, "%", 1);
+            p = pct + 2;
+            continue;
+        }
 
-static constexpr const char color_terminator[] = "\x1b[0m";
+        fmt_spec spec;
+        auto next = fmt_parse(pct + 1, &spec);
+        if (next == nullptr) {
+            return fmt_fallback(&w, out, size, pct, args);
+        }
+        fmt_convert(&w, &spec, args);
+        p = next;
+    }
 
-static void color_print_start(print_target *tgt, ulog_event *ev) {
-    if (!color_config_is_enabled()) {
-        return;  // Color is disabled, do not print color codes
+    if (size > 0) {
+        out[w.pos < w.limit ? w.pos : w.limit] = '\0';
     }
-    print_to_target(tgt, "%s", color_levels[ev->level]);  // color start
+    return w.pos > INT_MAX ? -1 : (int)w.pos;
 }
 
-static void color_print_end(print_target *tgt) {
-    if (!color_config_is_enabled()) {
-        return;  // Color is disabled, do not print color codes
+static int fmt_vsnprintf(char *out, size_t size, const char *format,
+                         va_list args) {
+    va_list copy;  // Only a local va_list can be passed on by pointer
+    va_copy(copy, args);
+    auto written = fmt_vformat(out, size, format, &copy);
+    va_end(copy);
+    return written;
+}
+
+/// @return Bytes written, negative on error, like vfprintf
+static int fmt_vfprintf(FILE *stream, const char *format, va_list args) {
+    char buf[fmt_stream_buf_size];
+    auto written = fmt_vsnprintf(buf, sizeof(buf), format, args);
+    if (written >= 0 && (size_t)written < sizeof(buf)) {
+        return (int)fwrite(buf, 1, (size_t)written, stream);
     }
-    print_to_target(tgt, "%s", color_terminator);  // color end
+    return vfprintf(stream, format, args);  // Longer than the stack buffer
 }
 
-#else  // ULOG_HAS_COLOR
+#else  // ULOG_HAS_FAST_FORMAT
 
 // Disabled Private
 // ================
 
-#define color_print_start(tgt, ev) (void)(tgt), (void)(ev)
-#define color_print_end(tgt) (void)(tgt)
+#define fmt_vsnprintf(out, size, format, args)                                 \
+    vsnprintf(out, size, format, args)
+#define fmt_vfprintf(stream, format, args) vfprintf(stream, format, args)
 
-#endif  // ULOG_HAS_COLOR
+#endif  // ULOG_HAS_FAST_FORMAT
 
 /* ============================================================================
-   Optional Feature: Dynamic Configuration - Prefix
-   (`prefix_config_*`, depends on: - )
+   Optional Feature: Format Cache
+   (`fmt_cache_*`, depends on: Fast Format)
 ============================================================================ */
-#if ULOG_HAS_DYNAMIC_CONFIG
+#if ULOG_HAS_FORMAT_CACHE
+#include <stdatomic.h>
 
-typedef struct {
-    bool enabled;
-} prefix_config;
+// Private
+// ================
+
+// The first call from a call site parses the format string once into
+// `ulog_format_cache.ops`; later calls run the ops without parsing. Formats
+// with unsupported conversions or more than ULOG_FORMAT_CACHE_OPS conversions
+// are marked uncacheable and go through fmt_vsnprintf every time.
+
+typedef enum {
+    FMT_CACHE_EMPTY       = 0,  // Zero-initialized, not compiled yet
+    FMT_CACHE_COMPILING   = 1,  // Being compiled by another thread
+    FMT_CACHE_READY       = 2,
+    FMT_CACHE_UNCACHEABLE = 3,
+} fmt_cache_state;
 
-static prefix_config prefix_cfg = {
-    .enabled = (bool)ULOG_HAS_PREFIX,
+enum {
+    FMT_CACHE_FLAG_LEFT  = 1 << 0,
+    FMT_CACHE_FLAG_ZERO  = 1 << 1,
+    FMT_CACHE_FLAG_PLUS  = 1 << 2,
+    FMT_CACHE_FLAG_SPACE = 1 << 3,
 };
 
-// Private
-// ================
+enum {
+    fmt_cache_width_arg     = -1,  // ulog_format_op.width taken from `*`
+    fmt_cache_precision_arg = -2,  // ulog_format_op.precision taken from `*`
+};
 
-bool prefix_config_is_enabled() {
-    return prefix_cfg.enabled;
+static ulog_format_op fmt_cache_op(const fmt_spec *spec, size_t literal_offset,
+                                   size_t literal_size) {
+    uint8_t flags = 0;
+    flags |= spec->left ? FMT_CACHE_FLAG_LEFT : 0;
+    flags |= spec->zero ? FMT_CACHE_FLAG_ZERO : 0;
+    flags |= spec->sign == '+' ? FMT_CACHE_FLAG_PLUS : 0;
+    flags |= spec->sign == ' ' ? FMT_CACHE_FLAG_SPACE : 0;
+    return (ulog_format_op){
+        .literal_offset = (uint16_t)literal_offset,
+        .literal_size   = (uint16_t)literal_size,
+        .width = spec->width_arg ? fmt_cache_width_arg : spec->width,
+        .precision =
+            spec->precision_arg ? fmt_cache_precision_arg : spec->precision,
+        .flags      = flags,
+        .length     = (uint8_t)spec->length,
+        .conversion = spec->conv,
+    };
 }
 
-// Public
-// ================
+static fmt_spec fmt_cache_spec(const ulog_format_op *op) {
+    auto sign = (op->flags & FMT_CACHE_FLAG_PLUS)    ? '+'
+                : (op->flags & FMT_CACHE_FLAG_SPACE) ? ' '
+                                                     : 0;
+    return (fmt_spec){
+        .left          = (op->flags & FMT_CACHE_FLAG_LEFT) != 0,
+        .zero          = (op->flags & FMT_CACHE_FLAG_ZERO) != 0,
+        .sign          = (char)sign,
+        .width_arg     = op->width == fmt_cache_width_arg,
+        .precision_arg = op->precision == fmt_cache_precision_arg,
+        .width         = op->width < 0 ? 0 : op->width,
+        .precision     = op->precision < 0 ? -1 : op->precision,
+        .length        = (fmt_length)op->length,
+        .conv          = op->conversion,
+    };
+}
 
-ulog_status ulog_prefix_config(bool enabled) {
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;
+/// @brief Parses `format` into the cache
+/// @return false if the format can not be cached
+static bool fmt_cache_compile(ulog_format_cache *cache, const char *format) {
+    auto literal  = format;
+    uint8_t count = 0;
+
+    for (;;) {
+        auto pct = strchr(literal, '%');
+        if (pct == nullptr) {
+            break;
+        }
+        auto spec        = (fmt_spec){.precision = -1, .conv = '%'};
+        const char *next = pct + 2;
+        if (pct[1] != '%') {
+            next = fmt_parse(pct + 1, &spec);
+        }
+        if (next == nullptr || count >= ULOG_FORMAT_CACHE_OPS ||
+            (size_t)(pct - format) > UINT16_MAX) {
+            return false;  // Goes to libc, too many conversions or too long
+        }
+        cache->ops[count++] = fmt_cache_op(&spec, (size_t)(literal - format),
+                                           (size_t)(pct - literal));
+        literal = next;
     }
-    prefix_cfg.enabled = enabled;
-    return lock_unlock();
+
+    auto tail_size = strlen(literal);
+    if ((size_t)(literal - format) + tail_size > UINT16_MAX) {
+        return false;
+    }
+    cache->op_count    = count;
+    cache->tail_offset = (uint16_t)(literal - format);
+    cache->tail_size   = (uint16_t)tail_size;
+    cache->format      = format;
+    return true;
 }
 
-#else  // ULOG_HAS_DYNAMIC_CONFIG
+/// @brief Compiles the cache unless another thread already does it
+static uint8_t fmt_cache_prepare(ulog_format_cache *cache,
+                                 const char *format) {
+    uint8_t expected = FMT_CACHE_EMPTY;
+    if (!atomic_compare_exchange_strong_explicit(
+            &cache->state, &expected, FMT_CACHE_COMPILING,
+            memory_order_acquire, memory_order_acquire)) {
+        return expected;  // Compiled or being compiled elsewhere
+    }
+    uint8_t state = fmt_cache_compile(cache, format) ? FMT_CACHE_READY
+                                                     : FMT_CACHE_UNCACHEABLE;
+    atomic_store_explicit(&cache->state, state, memory_order_release);
+    return state;
+}
 
-// Disabled Public
-// ================
+/// @brief Runs a compiled program, same result as fmt_vformat
+static int fmt_cache_run(const ulog_format_cache *cache, char *out,
+                         size_t size, va_list *args) {
+    auto w      = (fmt_writer){out, size > 0 ? size - 1 : 0, 0};
+    auto format = cache->format;
+
+    for (auto i = 0; i < cache->op_count; i++) {
+        auto op = &cache->ops[i];
+        fmt_put(&w, format + op->literal_offset, op->literal_size);
+        if (op->conversion == '%') {
+            fmt_put(&w, "%", 1);
+            continue;
+        }
+        auto spec = fmt_cache_spec(op);
+        fmt_convert(&w, &spec, args);
+    }
+    fmt_put(&w, format + cache->tail_offset, cache->tail_size);
 
-#if ULOG_HAS_WARN_NOT_ENABLED
-ulog_status ulog_prefix_config(bool enabled) {
-    (void)(enabled);
-    warn_not_enabled("ULOG_BUILD_DYNAMIC_CONFIG");
-    return ULOG_STATUS_DISABLED;
+    if (size > 0) {
+        out[w.pos < w.limit ? w.pos : w.limit] = '\0';
+    }
+    return w.pos > INT_MAX ? -1 : (int)w.pos;
+}
+
+NOT_VERY_STATIC int fmt_cache_vsnprintf(ulog_format_cache *cache, char *out,
+                                        size_t size, const char *format,
+                                        va_list args) {
+    if (cache == nullptr) {
+        return fmt_vsnprintf(out, size, format, args);
+    }
+    auto state = atomic_load_explicit(&cache->state, memory_order_acquire);
+    if (state == FMT_CACHE_EMPTY) {
+        state = fmt_cache_prepare(cache, format);
+    }
+    if (state != FMT_CACHE_READY || cache->format != format) {
+        return fmt_vsnprintf(out, size, format, args);
+    }
+
+    va_list copy;  // Only a local va_list can be passed on by pointer
+    va_copy(copy, args);
+    auto written = fmt_cache_run(cache, out, size, &copy);
+    va_end(copy);
+    return written;
+}
+
+static int fmt_cache_vfprintf(ulog_format_cache *cache, FILE *stream,
+                              const char *format, va_list args) {
+    if (cache == nullptr) {
+        return fmt_vfprintf(stream, format, args);
+    }
+    char buf[fmt_stream_buf_size];
+    auto written = fmt_cache_vsnprintf(cache, buf, sizeof(buf), format, args);
+    if (written >= 0 && (size_t)written < sizeof(buf)) {
+        return (int)fwrite(buf, 1, (size_t)written, stream);
+    }
+    return vfprintf(stream, format, args);  // Longer than the stack buffer
 }
-#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+#else  // ULOG_HAS_FORMAT_CACHE
 
 // Disabled Private
 // ================
 
-#define prefix_config_is_enabled() (ULOG_HAS_PREFIX)
-#endif  // ULOG_HAS_DYNAMIC_CONFIG
+#define fmt_cache_vsnprintf(cache, out, size, format, args)                    \
+    ((void)(cache), fmt_vsnprintf(out, size, format, args))
+#define fmt_cache_vfprintf(cache, stream, format, args)                        \
+    ((void)(cache), fmt_vfprintf(stream, format, args))
+
+#endif  // ULOG_HAS_FORMAT_CACHE
 
 /* ============================================================================
-   Optional Feature: Prefix
-   (`prefix_*`, depends on: Print, Prefix Config)
+   Optional Feature: Stats
+   (`stats_*`, depends on: - )
 ============================================================================ */
-#if ULOG_HAS_PREFIX
+#if ULOG_HAS_STATS
+#include <stdatomic.h>
+#include <time.h>
 
 // Private
 // ================
-typedef struct {
-    ulog_prefix_fn function;
-    char prefix[ULOG_BUILD_PREFIX_SIZE];
-} prefix_data_t;
 
-static prefix_data_t prefix_data = {
-    .function = nullptr,
-    .prefix   = {0},
+#if ULOG_HAS_EXTRA_OUTPUTS
+enum { stats_output_num = 1 + ULOG_BUILD_EXTRA_OUTPUTS };
+static_assert((int)stats_output_num <= (int)ULOG_STATS_OUTPUTS,
+              "ulog_stats reports at most ULOG_STATS_OUTPUTS outputs");
+#else
+enum { stats_output_num = 1 };
+#endif
+
+// Counters are relaxed atomics: they are only summed up and read for
+// reporting, so they need no ordering and do not serialize `ulog_log` callers
+typedef _Atomic(uint64_t) stats_counter;
+
+// Handler latency histogram, HDR style: values below `stats_latency_sub_num`
+// ns get a bucket each, every larger power of two is split into
+// `stats_latency_sub_num` equal buckets, so a bucket is at most 1/8 (12.5%)
+// wide relative to its values. Latencies from 2^40 ns (~18 min) go to the last
+// bucket.
+enum {
+    stats_latency_sub_bits   = 3,
+    stats_latency_sub_num    = 1 << stats_latency_sub_bits,
+    stats_latency_max_bits   = 40,
+    stats_latency_bucket_num =
+        stats_latency_sub_num *
+        (stats_latency_max_bits - stats_latency_sub_bits + 1),
 };
 
-static void prefix_update(ulog_event *ev) {
-    if (prefix_data.function == nullptr || !prefix_config_is_enabled()) {
-        return;
+typedef struct {
+    stats_counter count;
+    stats_counter sum_ns;
+    stats_counter inv_min_ns;  // UINT64_MAX - min, so zero means empty
+    stats_counter max_ns;
+    stats_counter buckets[stats_latency_bucket_num];
+} stats_latency;
+
+typedef struct {
+    stats_counter events;
+    stats_counter bytes;
+    stats_latency latency;
+} stats_output;
+
+typedef struct {
+    stats_counter events[ULOG_LEVEL_TOTAL];
+    stats_counter filtered_level;
+    stats_counter filtered_topic;
+    stats_counter dropped;
+    stats_counter lock_count;
+    stats_counter lock_wait_ns;
+    stats_counter lock_wait_max_ns;
+    stats_output outputs[stats_output_num];
+} stats_data_t;
+
+static stats_data_t stats_instances[logger_total_num];
+#define stats_data stats_instances[logger_id()]
+
+// Bytes the current thread wrote to output streams. Output handlers are
+// measured by the difference before and after the call.
+static thread_local uint64_t stats_thread_bytes;
+
+static inline void stats_add(stats_counter *counter, uint64_t value) {
+    atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+static inline uint64_t stats_load(stats_counter *counter) {
+    return atomic_load_explicit(counter, memory_order_relaxed);
+}
+
+static uint64_t stats_now_ns() {
+    struct timespec ts;
+#ifdef TIME_MONOTONIC
+    if (timespec_get(&ts, TIME_MONOTONIC) == 0)
+#endif
+    {
+        (void)timespec_get(&ts, TIME_UTC);
     }
-    prefix_data.function(ev, prefix_data.prefix, ULOG_BUILD_PREFIX_SIZE);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
 }
 
-static void prefix_print(print_target *tgt) {
-    if (prefix_data.function == nullptr || !prefix_config_is_enabled()) {
-        return;
+static inline void stats_store(stats_counter *counter, uint64_t value) {
+    atomic_store_explicit(counter, value, memory_order_relaxed);
+}
+
+static void stats_max(stats_counter *counter, uint64_t value) {
+    auto max = stats_load(counter);
+    while (value > max &&
+           !atomic_compare_exchange_weak_explicit(counter, &max, value,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
     }
-    print_to_target(tgt, "%s", prefix_data.prefix);
 }
 
-// Public
-// ================
+/// @brief Accounts a lock acquisition that started at `start`
+static void stats_lock_waited(uint64_t start) {
+    auto waited = stats_now_ns() - start;
+    stats_add(&stats_data.lock_count, 1);
+    stats_add(&stats_data.lock_wait_ns, waited);
+    stats_max(&stats_data.lock_wait_max_ns, waited);
+}
 
-ulog_status ulog_prefix_set_fn(ulog_prefix_fn function) {
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;
+static int stats_latency_bucket(uint64_t ns) {
+    if (ns < stats_latency_sub_num) {
+        return (int)ns;
     }
-    if (function == nullptr) {
-        if (lock_unlock() != ULOG_STATUS_OK) {
-            return ULOG_STATUS_BUSY;
-        }
-        return ULOG_STATUS_INVALID_ARGUMENT;  // Ignore nullptr function
+    if (ns >> stats_latency_max_bits != 0) {
+        return stats_latency_bucket_num - 1;
     }
-    prefix_data.function = function;
-    return lock_unlock();
+#if defined(__GNUC__) || defined(__clang__)
+    auto msb = 63 - __builtin_clzll(ns);
+#else
+    auto msb = 0;
+    for (auto v = ns; v > 1; v >>= 1) {
+        msb++;
+    }
+#endif
+    auto shift = msb - stats_latency_sub_bits;
+    auto sub   = (int)(ns >> shift) - stats_latency_sub_num;
+    return stats_latency_sub_num * (shift + 1) + sub;
 }
 
-#else  // ULOG_HAS_PREFIX
+/// @brief Lowest value of a bucket; the bucket ends where the next one starts
+static uint64_t stats_latency_bucket_low(int bucket) {
+    if (bucket < stats_latency_sub_num) {
+        return (uint64_t)bucket;
+    }
+    auto shift = bucket / stats_latency_sub_num - 1;
+    auto sub   = (uint64_t)(bucket % stats_latency_sub_num);
+    return (stats_latency_sub_num + sub) << shift;
+}
 
-// Disabled Public
-// ================
+static void stats_latency_add(stats_latency *h, uint64_t ns) {
+    stats_add(&h->count, 1);
+    stats_add(&h->sum_ns, ns);
+    stats_max(&h->inv_min_ns, UINT64_MAX - ns);
+    stats_max(&h->max_ns, ns);
+    stats_add(&h->buckets[stats_latency_bucket(ns)], 1);
+}
 
-#if ULOG_HAS_WARN_NOT_ENABLED
-ulog_status ulog_prefix_set_fn(ulog_prefix_fn function) {
-    (void)(function);
-    warn_not_enabled("ULOG_BUILD_PREFIX_SIZE");
-    return ULOG_STATUS_DISABLED;
+static void stats_latency_reset(stats_latency *h) {
+    stats_store(&h->count, 0);
+    stats_store(&h->sum_ns, 0);
+    stats_store(&h->inv_min_ns, 0);
+    stats_store(&h->max_ns, 0);
+    for (auto i = 0; i < stats_latency_bucket_num; i++) {
+        stats_store(&h->buckets[i], 0);
+    }
 }
-#endif  // ULOG_HAS_WARN_NOT_ENABLED
 
-// Disabled Private
-// ================
+/// @brief Reads a histogram; percentiles are the upper end of the bucket they
+/// fall in, clamped to the observed range
+static void stats_latency_read(stats_latency *h, ulog_latency_stats *out,
+                               uint64_t *buckets) {
+    auto total = (uint64_t)0;
+    for (auto i = 0; i < stats_latency_bucket_num; i++) {
+        buckets[i] = stats_load(&h->buckets[i]);
+        total += buckets[i];
+    }
+    *out = (ulog_latency_stats){
+        .count  = total,
+        .sum_ns = stats_load(&h->sum_ns),
+        .min_ns = total > 0 ? UINT64_MAX - stats_load(&h->inv_min_ns) : 0,
+        .max_ns = stats_load(&h->max_ns),
+    };
+
+    static const uint64_t per_mille[] = {500, 900, 990, 999};
+    uint64_t *targets[] = {&out->p50_ns, &out->p90_ns, &out->p99_ns,
+                           &out->p999_ns};
+    auto seen   = (uint64_t)0;
+    auto bucket = 0;
+    for (size_t p = 0; p < sizeof(per_mille) / sizeof(per_mille[0]); p++) {
+        // Rank of the percentile, rounded up: the smallest value with at
+        // least p of the samples at or below it
+        auto rank = (total * per_mille[p] + 999) / 1000;
+        while (bucket < stats_latency_bucket_num &&
+               seen + buckets[bucket] < rank) {
+            seen += buckets[bucket++];
+        }
+        if (total == 0 || bucket >= stats_latency_bucket_num) {
+            *targets[p] = out->max_ns;
+            continue;
+        }
+        auto value  = stats_latency_bucket_low(bucket + 1) - 1;
+        value       = value > out->max_ns ? out->max_ns : value;
+        *targets[p] = value < out->min_ns ? out->min_ns : value;
+    }
+}
 
-#define prefix_print(tgt) (void)(tgt)
-#define prefix_update(ev) (void)(ev)
-#endif  // ULOG_HAS_PREFIX
+static inline void stats_stream_written(int64_t written) {
+    if (written > 0) {
+        stats_thread_bytes += (uint64_t)written;
+    }
+}
 
-/* ============================================================================
-   Optional Feature: Dynamic Configuration - Time
-   (`time_config_*`, depends on: - )
-============================================================================ */
-#if ULOG_HAS_DYNAMIC_CONFIG
+static inline uint64_t stats_output_begin() {
+    return stats_thread_bytes;
+}
 
-typedef struct {
-    bool enabled;
-} time_config;
+/// @brief Accounts an output handler call that started at `start_ns` with
+/// `begin` bytes written by this thread
+static inline void stats_output_end(int output, uint64_t begin,
+                                    uint64_t start_ns) {
+    auto elapsed = stats_now_ns() - start_ns;
+    if (output >= 0 && output < stats_output_num) {
+        stats_add(&stats_data.outputs[output].events, 1);
+        stats_add(&stats_data.outputs[output].bytes,
+                  stats_thread_bytes - begin);
+        stats_latency_add(&stats_data.outputs[output].latency, elapsed);
+    }
+}
 
-static time_config time_cfg = {
-    .enabled = ULOG_HAS_TIME,
-};
+/// @brief Accounts an event that passed the topic filter
+static inline void stats_event(ulog_level level, bool delivered) {
+    if (delivered) {
+        stats_add(&stats_data.events[level], 1);
+    } else {
+        stats_add(&stats_data.filtered_level, 1);
+    }
+}
 
-// Private
-// ================
+static inline void stats_output_reset(int output) {
+    stats_store(&stats_data.outputs[output].events, 0);
+    stats_store(&stats_data.outputs[output].bytes, 0);
+    stats_latency_reset(&stats_data.outputs[output].latency);
+}
 
-bool time_config_is_enabled() {
-    return time_cfg.enabled;
+static void stats_reset() {
+    for (auto i = 0; i < ULOG_LEVEL_TOTAL; i++) {
+        stats_store(&stats_data.events[i], 0);
+    }
+    stats_counter *totals[] = {
+        &stats_data.filtered_level, &stats_data.filtered_topic,
+        &stats_data.dropped,        &stats_data.lock_count,
+        &stats_data.lock_wait_ns,   &stats_data.lock_wait_max_ns,
+    };
+    for (size_t i = 0; i < sizeof(totals) / sizeof(totals[0]); i++) {
+        stats_store(totals[i], 0);
+    }
+    for (auto i = 0; i < stats_output_num; i++) {
+        stats_output_reset(i);
+    }
 }
 
+#define stats_filtered_topic() stats_add(&stats_data.filtered_topic, 1)
+#define stats_dropped() stats_add(&stats_data.dropped, 1)
+
 // Public
 // ================
 
-ulog_status ulog_time_config(bool enabled) {
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;
+ulog_status ulog_stats_get(ulog_stats *out) {
+    if (out == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
     }
-    time_cfg.enabled = enabled;
-    return lock_unlock();
+    *out = (ulog_stats){0};
+    for (auto i = 0; i < ULOG_LEVEL_TOTAL; i++) {
+        out->events[i] = stats_load(&stats_data.events[i]);
+    }
+    out->filtered_level   = stats_load(&stats_data.filtered_level);
+    out->filtered_topic   = stats_load(&stats_data.filtered_topic);
+    out->dropped          = stats_load(&stats_data.dropped);
+    out->lock_count       = stats_load(&stats_data.lock_count);
+    out->lock_wait_ns     = stats_load(&stats_data.lock_wait_ns);
+    out->lock_wait_max_ns = stats_load(&stats_data.lock_wait_max_ns);
+
+    out->output_count = stats_output_num;
+    for (auto i = 0; i < out->output_count; i++) {
+        out->outputs[i].events = stats_load(&stats_data.outputs[i].events);
+        out->outputs[i].bytes  = stats_load(&stats_data.outputs[i].bytes);
+    }
+    return ULOG_STATUS_OK;
 }
 
-#else  // ULOG_HAS_DYNAMIC_CONFIG
+ulog_status ulog_stats_reset() {
+    stats_reset();
+    return ULOG_STATUS_OK;
+}
 
-// Disabled Public
-// ================
+ulog_status ulog_stats_latency_get(ulog_output_id output,
+                                   ulog_latency_stats *out) {
+    if (out == nullptr || output < 0 || output >= stats_output_num) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    uint64_t buckets[stats_latency_bucket_num];
+    stats_latency_read(&stats_data.outputs[output].latency, out, buckets);
+    return ULOG_STATUS_OK;
+}
 
-#if ULOG_HAS_WARN_NOT_ENABLED
-ulog_status ulog_time_config(bool enabled) {
-    (void)(enabled);
-    warn_not_enabled("ULOG_BUILD_TIME");
-    return ULOG_STATUS_DISABLED;
+ulog_status ulog_stats_latency_reset(ulog_output_id output) {
+    if (output == ULOG_OUTPUT_ALL) {
+        for (auto i = 0; i < stats_output_num; i++) {
+            stats_latency_reset(&stats_data.outputs[i].latency);
+        }
+        return ULOG_STATUS_OK;
+    }
+    if (output < 0 || output >= stats_output_num) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    stats_latency_reset(&stats_data.outputs[output].latency);
+    return ULOG_STATUS_OK;
 }
-#endif  // ULOG_HAS_WARN_NOT_ENABLED
 
-// Disabled Private
-// ================
-
-#define time_config_is_enabled() (ULOG_HAS_TIME)
-#endif  // ULOG_HAS_DYNAMIC_CONFIG
+ulog_status ulog_stats_latency_dump(FILE *file) {
+    if (file == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    uint64_t buckets[stats_latency_bucket_num];
+    for (auto i = 0; i < stats_output_num; i++) {
+        ulog_latency_stats s;
+        stats_latency_read(&stats_data.outputs[i].latency, &s, buckets);
+        if (s.count == 0) {
+            continue;
+        }
+        fprintf(file,
+                "output %d: count=%llu mean=%llu min=%llu p50=%llu p90=%llu "
+                "p99=%llu p99.9=%llu max=%llu (ns)\n",
+                i, (unsigned long long)s.count,
+                (unsigned long long)(s.sum_ns / s.count),
+                (unsigned long long)s.min_ns, (unsigned long long)s.p50_ns,
+                (unsigned long long)s.p90_ns, (unsigned long long)s.p99_ns,
+                (unsigned long long)s.p999_ns, (unsigned long long)s.max_ns);
+        for (auto b = 0; b < stats_latency_bucket_num; b++) {
+            if (buckets[b] == 0) {
+                continue;
+            }
+            auto low = stats_latency_bucket_low(b);
+            if (b + 1 < stats_latency_bucket_num) {
+                fprintf(file, "  [%12llu, %12llu) %llu\n",
+                        (unsigned long long)low,
+                        (unsigned long long)stats_latency_bucket_low(b + 1),
+                        (unsigned long long)buckets[b]);
+            } else {
+                fprintf(file, "  [%12llu,          inf) %llu\n",
+                        (unsigned long long)low,
+                        (unsigned long long)buckets[b]);
+            }
+        }
+    }
+    return ULOG_STATUS_OK;
+}
 
-/* ============================================================================
-   Optional Feature: Time
-   (`time_*`, depends on: Time, Print)
-============================================================================ */
-#if ULOG_HAS_TIME
+#else  // ULOG_HAS_STATS
 
-#include <time.h>
+// Disabled Private
+// ================
 
-enum {
-    time_short_buf_size = 10,  // HH:MM:SS(8) + 1 space + null
-    time_full_buf_size  = 21,  // YYYY-MM-DD HH:MM:SS(19) + 1 space + null
-};
+#define stats_now_ns() ((uint64_t)0)
+#define stats_lock_waited(start) (void)(start)
+#define stats_stream_written(written) (void)(written)
+#define stats_output_begin() ((uint64_t)0)
+#define stats_output_end(output, begin, start_ns)                               \
+    ((void)(output), (void)(begin), (void)(start_ns))
+#define stats_event(level, delivered) ((void)(level), (void)(delivered))
+#define stats_output_reset(output) (void)(output)
+#define stats_reset() (void)(0)
+#define stats_filtered_topic() (void)(0)
+#define stats_dropped() (void)(0)
 
-// Private
+// Disabled Public
 // ================
-static bool time_print_if_invalid(print_target *tgt, ulog_event *ev) {
-    if (ev->time == nullptr) {
-        print_to_target(tgt, "INVALID_TIME");
-        return true;  // Time is invalid, print error message
-    }
-    return false;  // Time is valid
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+
+ulog_status ulog_stats_get(ulog_stats *out) {
+    (void)(out);
+    warn_not_enabled("ULOG_BUILD_STATS");
+    return ULOG_STATUS_DISABLED;
 }
 
-/// @brief Fills the event time with the current local time
-/// @param ev - Event to fill. Assumed not nullptr
-static void time_fill_current_time(ulog_event *ev) {
-    auto current_time = time(nullptr);  // Get current time
-    // Use localtime because existing tests inspect local clock fields.
-    ev->time = localtime(&current_time);
+ulog_status ulog_stats_reset() {
+    warn_not_enabled("ULOG_BUILD_STATS");
+    return ULOG_STATUS_DISABLED;
 }
 
-static void time_print_short(print_target *tgt, ulog_event *ev,
-                             bool append_space) {
-    if (!time_config_is_enabled() || time_print_if_invalid(tgt, ev)) {
-        return;  // If time is not valid or disabled, stop printing
-    }
-    char buf[time_short_buf_size] = {0};
-    auto format                   = append_space ? "%H:%M:%S " : "%H:%M:%S";
-    strftime(buf, time_short_buf_size, format, ev->time);
-    print_to_target(tgt, "%s", buf);
+ulog_status ulog_stats_latency_get(ulog_output_id output,
+                                   ulog_latency_stats *out) {
+    (void)(output);
+    (void)(out);
+    warn_not_enabled("ULOG_BUILD_STATS");
+    return ULOG_STATUS_DISABLED;
 }
 
-#if ULOG_HAS_EXTRA_OUTPUTS
-static void time_print_full(print_target *tgt, ulog_event *ev,
-                            bool append_space) {
-    if (!time_config_is_enabled() || time_print_if_invalid(tgt, ev)) {
-        return;  // If time is not valid or disabled, stop printing
-    }
-    char buf[time_full_buf_size] = {0};
-    auto format = append_space ? "%Y-%m-%d %H:%M:%S " : "%Y-%m-%d %H:%M:%S";
-    strftime(buf, time_full_buf_size, format, ev->time);
-    print_to_target(tgt, "%s", buf);
+ulog_status ulog_stats_latency_reset(ulog_output_id output) {
+    (void)(output);
+    warn_not_enabled("ULOG_BUILD_STATS");
+    return ULOG_STATUS_DISABLED;
 }
-#else
-#define time_print_full(tgt, ev, append_space) (void)(0)
-#endif  // ULOG_HAS_EXTRA_OUTPUTS
 
-#else  // ULOG_HAS_TIME
+ulog_status ulog_stats_latency_dump(FILE *file) {
+    (void)(file);
+    warn_not_enabled("ULOG_BUILD_STATS");
+    return ULOG_STATUS_DISABLED;
+}
 
-// Disabled Private
-// ================
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
 
-#define time_print_short(tgt, ev, append_space) (void)(0)
-#define time_print_full(tgt, ev, append_space) (void)(0)
-#define time_fill_current_time(ev) (void)(ev)
-#endif  // ULOG_HAS_TIME
+#endif  // ULOG_HAS_STATS
 
 /* ============================================================================
-   Core Feature: Levels
-   (`level_*`, depends on: Levels Config, Print)
+   Optional Feature: Callsite Stats
+   (`callsite_*`, depends on: Stats)
 ============================================================================ */
+#if ULOG_HAS_CALLSITE_STATS
 
 // Private
 // ================
-static constexpr ulog_level level_min_value = ULOG_LEVEL_0;
-
-typedef struct {
-    const ulog_level_descriptor *dsc;
-} level_data_t;
 
-static const ulog_level_descriptor level_names_default = {
-    .max_level = ULOG_LEVEL_FATAL,
-#if ULOG_HAS_LEVEL_SHORT && !ULOG_HAS_LEVEL_LONG
-    .names = {"T", "D", "I", "W", "E", "F", nullptr, nullptr},
-#else
-    .names = {"TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "FATAL", nullptr,
-              nullptr},
-#endif
+enum {
+    callsite_slot_num  = ULOG_BUILD_CALLSITE_STATS,
+    callsite_probe_max = 8,  // Slots a lookup tries before giving up
+    callsite_free      = 0,  // Slot states
+    callsite_claimed   = 1,  // Key being written by the thread that claimed it
+    callsite_ready     = 2,
 };
 
-level_data_t level_data = {
-    .dsc = &level_names_default,
-};
+// One slot of the open addressing table. A slot is claimed once and keeps its
+// key until the process ends, so lookups never lock and never see a key
+// change; `ulog_stats_reset` only clears the counters.
+typedef struct {
+    _Atomic(int) state;
+    int line;
+    const char *file;  // Compared by pointer: `__FILE__` of the call site
+    stats_counter emitted;
+    stats_counter filtered;
+    stats_counter bytes;
+} callsite_t;
 
-static bool level_is_allowed(ulog_level msg_level, ulog_level log_verbosity) {
-    if (msg_level < log_verbosity || msg_level < level_min_value) {
-        return false;  // Level is higher than the configured level, not allowed
-    }
+typedef struct {
+    callsite_t sites[callsite_slot_num];
+    stats_counter overflow;  // Events from sites that did not fit the table
+} callsite_data_t;
 
-    return true;  // Level is allowed
-}
+static callsite_data_t callsite_data;
 
-static bool level_is_valid(ulog_level level) {
-    return (level >= level_min_value && level <= level_data.dsc->max_level);
+static size_t callsite_hash(const char *file, int line) {
+    auto key = (uint64_t)(uintptr_t)file ^ ((uint64_t)(unsigned)line << 32);
+    key *= 0x9e3779b97f4a7c15ULL;
+    return (size_t)((key >> 32) % callsite_slot_num);
 }
 
-static bool level_descriptor_is_valid(const ulog_level_descriptor *dsc) {
-    if (dsc == nullptr || dsc->max_level < level_min_value ||
-        dsc->max_level >= ULOG_LEVEL_TOTAL) {
-        return false;
+/// @brief Finds or claims the slot of a call site
+/// @return Slot, nullptr if the table is full
+static callsite_t *callsite_get(const char *file, int line) {
+    if (file == nullptr) {
+        return nullptr;
     }
-
-    for (auto i = (int)level_min_value; i <= (int)dsc->max_level; i++) {
-        if (is_str_empty(dsc->names[i])) {
-            return false;
+    // Short probe runs keep untracked sites cheap once the table is full
+    auto index = callsite_hash(file, line);
+    for (auto probe = 0;
+         probe < callsite_probe_max && probe < callsite_slot_num; probe++) {
+        auto site  = &callsite_data.sites[index];
+        auto state = atomic_load_explicit(&site->state, memory_order_acquire);
+        if (state == callsite_free) {
+            if (atomic_compare_exchange_strong_explicit(
+                    &site->state, &state, callsite_claimed,
+                    memory_order_acquire, memory_order_acquire)) {
+                site->file = file;
+                site->line = line;
+                atomic_store_explicit(&site->state, callsite_ready,
+                                      memory_order_release);
+                return site;
+            }
         }
+        while (state == callsite_claimed) {  // Key is a few stores away
+            state = atomic_load_explicit(&site->state, memory_order_acquire);
+        }
+        if (site->file == file && site->line == line) {
+            return site;
+        }
+        index = (index + 1) % callsite_slot_num;
     }
-
-    return true;
-}
-
-static void level_print(print_target *tgt, ulog_event *ev) {
-    if (!level_is_valid(ev->level)) {
-        print_to_target(tgt, "? ");
-        return;
-    }
-    print_to_target(tgt, "%s ", level_data.dsc->names[ev->level]);
+    stats_add(&callsite_data.overflow, 1);
+    return nullptr;
 }
 
-// Public
-// ================
-
-/// @brief Returns the string representation of the level
-const char *ulog_level_to_string(ulog_level level) {
-    if (level < level_min_value || level > level_data.dsc->max_level) {
-        return "?";  // Return a default string for invalid levels
+static inline void callsite_filtered(callsite_t *site) {
+    if (site != nullptr) {
+        stats_add(&site->filtered, 1);
     }
-
-    return level_data.dsc->names[level];
 }
 
-ulog_status ulog_level_set_new_levels(const ulog_level_descriptor *new_levels) {
-    if (!level_descriptor_is_valid(new_levels)) {
-        return ULOG_STATUS_INVALID_ARGUMENT;  // Invalid argument
-    }
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;  // Failed to acquire lock
+/// @brief Accounts a dispatched event that rendered `bytes` bytes
+static inline void callsite_event(callsite_t *site, bool delivered,
+                                  uint64_t bytes) {
+    if (site != nullptr) {
+        stats_add(delivered ? &site->emitted : &site->filtered, 1);
+        stats_add(&site->bytes, bytes);
     }
-
-    level_data.dsc = new_levels;
-    return lock_unlock();
 }
 
-ulog_status ulog_level_reset_levels() {
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;  // Failed to acquire lock
+static void callsite_reset() {
+    for (auto i = 0; i < callsite_slot_num; i++) {
+        stats_store(&callsite_data.sites[i].emitted, 0);
+        stats_store(&callsite_data.sites[i].filtered, 0);
+        stats_store(&callsite_data.sites[i].bytes, 0);
     }
-
-    level_data.dsc = &level_names_default;
-    return lock_unlock();
+    stats_store(&callsite_data.overflow, 0);
 }
 
-/* ============================================================================
-   Optional Feature: Dynamic Configuration - Level
-   (`level_config_*`, depends on: - )
-============================================================================ */
-#if ULOG_HAS_DYNAMIC_CONFIG
-
-// Private
-// ================
-
 typedef struct {
-    bool short_style;  // Use short level strings
-} level_config;
-
-static level_config level_cfg = {
-    .short_style = false,
-};
-
-static const ulog_level_descriptor level_names_default_short = {
-    .max_level = ULOG_LEVEL_FATAL,
-    .names     = {"T", "D", "I", "W", "E", "F", nullptr, nullptr},
-};
-
-bool level_config_is_short() {
-    return level_cfg.short_style;
+    const char *file;
+    int line;
+    uint64_t emitted;
+    uint64_t filtered;
+    uint64_t bytes;
+} callsite_row;
+
+// Most bytes first, then most events
+static int callsite_row_compare(const void *a, const void *b) {
+    auto x = (const callsite_row *)a;
+    auto y = (const callsite_row *)b;
+    if (x->bytes != y->bytes) {
+        return x->bytes < y->bytes ? 1 : -1;
+    }
+    auto x_events = x->emitted + x->filtered;
+    auto y_events = y->emitted + y->filtered;
+    return (x_events < y_events) - (x_events > y_events);
 }
 
 // Public
 // ================
 
-ulog_status ulog_level_config(ulog_level_config_style style) {
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;
+ulog_status ulog_callsite_report(size_t top_n, FILE *file) {
+    if (file == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
     }
-    level_cfg.short_style = (style == ULOG_LEVEL_CONFIG_STYLE_SHORT);
-    if (level_cfg.short_style) {
-        level_data.dsc = &level_names_default_short;
-    } else {
-        level_data.dsc = &level_names_default;
+    auto rows =
+        (callsite_row *)malloc(sizeof(callsite_row) * callsite_slot_num);
+    if (rows == nullptr) {
+        return ULOG_STATUS_ERROR;
     }
-    return lock_unlock();
+    size_t count = 0;
+    for (auto i = 0; i < callsite_slot_num; i++) {
+        auto site = &callsite_data.sites[i];
+        if (atomic_load_explicit(&site->state, memory_order_acquire) !=
+            callsite_ready) {
+            continue;
+        }
+        rows[count++] = (callsite_row){
+            .file     = site->file,
+            .line     = site->line,
+            .emitted  = stats_load(&site->emitted),
+            .filtered = stats_load(&site->filtered),
+            .bytes    = stats_load(&site->bytes),
+        };
+    }
+    qsort(rows, count, sizeof(rows[0]), callsite_row_compare);
+
+    fprintf(file, "%12s %10s %10s  %s\n", "bytes", "emitted", "filtered",
+            "site");
+    for (size_t i = 0; i < count && i < top_n; i++) {
+        fprintf(file, "%12llu %10llu %10llu  %s:%d\n",
+                (unsigned long long)rows[i].bytes,
+                (unsigned long long)rows[i].emitted,
+                (unsigned long long)rows[i].filtered, rows[i].file,
+                rows[i].line);
+    }
+    auto overflow = stats_load(&callsite_data.overflow);
+    if (overflow > 0) {
+        fprintf(file, "%llu events from sites that found no free slot\n",
+                (unsigned long long)overflow);
+    }
+    free(rows);
+    return ULOG_STATUS_OK;
 }
 
-#else  // ULOG_HAS_DYNAMIC_CONFIG
+ulog_status ulog_callsite_reset() {
+    callsite_reset();
+    return ULOG_STATUS_OK;
+}
+
+#else  // ULOG_HAS_CALLSITE_STATS
+
+// Disabled Private
+// ================
+
+#define callsite_get(file, line) ((void)(file), (void)(line), nullptr)
+#define callsite_filtered(site) (void)(site)
+#define callsite_event(site, delivered, bytes)                                 \
+    ((void)(site), (void)(delivered), (void)(bytes))
+#define callsite_reset() (void)(0)
 
 // Disabled Public
 // ================
 
+// Dynamic config leaves the table opt-in, so its stubs stay linkable there
+#if ULOG_HAS_WARN_NOT_ENABLED || ULOG_HAS_DYNAMIC_CONFIG
+
 #if ULOG_HAS_WARN_NOT_ENABLED
+#define callsite_warn() warn_not_enabled("ULOG_BUILD_CALLSITE_STATS")
+#else
+#define callsite_warn() (void)(0)
+#endif
 
-ulog_status ulog_level_config(ulog_level_config_style style) {
-    (void)(style);
-    warn_not_enabled("ULOG_BUILD_DYNAMIC_CONFIG");
+ulog_status ulog_callsite_report(size_t top_n, FILE *file) {
+    (void)(top_n);
+    (void)(file);
+    callsite_warn();
     return ULOG_STATUS_DISABLED;
 }
 
-#endif  // ULOG_HAS_WARN_NOT_ENABLED
+ulog_status ulog_callsite_reset() {
+    callsite_warn();
+    return ULOG_STATUS_DISABLED;
+}
 
-// Disabled Private
-// ================
+#endif  // ULOG_HAS_WARN_NOT_ENABLED || ULOG_HAS_DYNAMIC_CONFIG
 
-#define level_config_is_short() (ULOG_HAS_LEVEL_SHORT)
-#endif  // ULOG_HAS_DYNAMIC_CONFIG
+#endif  // ULOG_HAS_CALLSITE_STATS
 
 /* ============================================================================
-   Core Feature: Outputs
-   (`output_*`, depends on: Print, Log, Level)
+   Core Feature: Print
+   (`print_*`, depends on: - )
 ============================================================================ */
 
 //  Private
 // ================
-#if ULOG_HAS_EXTRA_OUTPUTS
-enum { output_total_num = (1 + ULOG_BUILD_EXTRA_OUTPUTS) };  // stdout + extra
-#else
-enum { output_total_num = 1 };  // Only stdout
-#endif  // ULOG_HAS_EXTRA_OUTPUTS
-
-static constexpr ulog_level output_stdout_default_level = ULOG_LEVEL_TRACE;
-
-// Prototypes
-static void output_stdout_handler(ulog_event *ev, void *arg);
-static void log_print_event(print_target *tgt, ulog_event *ev, bool full_time,
-                            bool color, bool new_line);
 
 typedef struct {
-    ulog_output_handler_fn handler;
-    void *arg;
-    ulog_level level;
-} output;
+    char *data;
+    size_t curr_pos;
+    size_t size;
+} print_buffer;
 
-typedef struct {
-    output outputs[output_total_num];  // order num = id. 0 is for stdout
-} output_data_t;
+typedef union {
+    print_buffer buffer;
+    FILE *stream;
+} print_target_descriptor;
 
-static output_data_t output_data = {
-    .outputs = {{output_stdout_handler, nullptr, output_stdout_default_level}}};
+typedef enum { PRINT_TARGET_BUFFER, PRINT_TARGET_STREAM } print_target_type;
 
-static void output_handle_single(ulog_event *ev, output *output) {
-    if (output->handler == nullptr) {
-        return;  // Output has been removed, skip it
-    }
+typedef struct {
+    print_target_type type;
+    print_target_descriptor dsc;
+} print_target;
 
-    if (level_is_allowed(ev->level, output->level)) {
+/// @brief Formats into the target, through the call site format cache if
+/// there is one
+static void print_to_target_cached_valist(print_target *tgt,
+                                          ulog_format_cache *cache,
+                                          const char *format, va_list args) {
+    if (tgt->type == PRINT_TARGET_BUFFER) {
+        auto buf = &tgt->dsc.buffer;
 
-        // Create event copy to avoid va_list issues
-        auto ev_copy = (ulog_event){0};
-        memcpy(&ev_copy, ev, sizeof(ulog_event));
+        if (buf->curr_pos >= buf->size) {
+            return;  // No space available
+        }
 
-        // Initialize the va_list for the copied event
-        // Note: We use a copy of the va_list to avoid issues with passing it
-        // directly as on some platforms using the same va_list multiple times
-        // can lead to undefined behavior.
-        va_copy(ev_copy.message_format_args, ev->message_format_args);
-        output->handler(&ev_copy, output->arg);
-        va_end(ev_copy.message_format_args);
-    }
-}
+        auto remaining = buf->size - buf->curr_pos;
+        auto write_pos = buf->data + buf->curr_pos;
 
-static void output_handle_by_id(ulog_event *ev, ulog_output_id output_id) {
-    // Validate output ID bounds
-    if (output_id < 0 || output_id >= output_total_num) {
-        return;  // Invalid output ID
-    }
-    output_handle_single(ev, &output_data.outputs[output_id]);
-}
+        auto written = fmt_cache_vsnprintf(cache, write_pos, remaining,
+                                           format, args);
+        if (written < 0) {
+            return;  // Encoding error
+        }
 
-static void output_handle_all(ulog_event *ev) {
-    // Processing the message for outputs
-    for (auto i = 0; (i < output_total_num); i++) {
-        output_handle_single(ev, &output_data.outputs[i]);
-    }
+        // Update position, capping at buffer end
+        if ((size_t)written >= remaining) {
+            buf->curr_pos = buf->size;
+        } else {
+            buf->curr_pos += written;
+        }
+
+    } else if (tgt->type == PRINT_TARGET_STREAM) {
+        auto written =
+            fmt_cache_vfprintf(cache, tgt->dsc.stream, format, args);
+        stats_stream_written(written);
+    }
+}
+
+static void print_to_target_valist(print_target *tgt, const char *format,
+                                   va_list args) {
+    print_to_target_cached_valist(tgt, nullptr, format, args);
+}
+
+static void print_to_target(print_target *tgt, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    print_to_target_valist(tgt, format, args);
+    va_end(args);
+}
+
+/// @brief Writes raw bytes without format processing
+/// @note Buffer targets keep the same truncation and null termination
+/// semantics as `vsnprintf`
+static void print_to_target_raw(print_target *tgt, const char *data,
+                                size_t size) {
+    if (tgt->type == PRINT_TARGET_BUFFER) {
+        auto buf = &tgt->dsc.buffer;
+
+        if (buf->curr_pos >= buf->size) {
+            return;  // No space available
+        }
+
+        auto remaining = buf->size - buf->curr_pos;
+        if (size >= remaining) {
+            size          = remaining - 1;  // Keep space for the terminator
+            buf->curr_pos = buf->size;
+        } else {
+            buf->curr_pos += size;
+        }
+        memcpy(buf->data + (buf->size - remaining), data, size);
+        buf->data[buf->size - remaining + size] = '\0';
+
+    } else if (tgt->type == PRINT_TARGET_STREAM) {
+        auto written = fwrite(data, 1, size, tgt->dsc.stream);
+        stats_stream_written((int64_t)written);
+    }
+}
+
+/* ============================================================================
+   Core Feature: Events
+   (`event_*`, depends on: Print)
+============================================================================ */
+
+#if ULOG_HAS_TIME
+#include <time.h>
+#endif
+
+// Private
+// ================
+
+static void log_print_message(print_target *tgt, ulog_event *ev);
+
+/// @brief Event structure
+struct ulog_event {
+    const char *message;          // Message format string
+    va_list message_format_args;  // Format arguments
+
+#if ULOG_HAS_TOPICS
+    ulog_topic_id topic;
+    const char *topic_name;  // Resolved with the topic, nullptr if none
+#endif
+
+#if ULOG_HAS_PREFIX
+    bool has_prefix;                      // Whether `prefix` was filled
+    char prefix[ULOG_BUILD_PREFIX_SIZE];  // Written by the prefix function
+#endif
+
+#if ULOG_HAS_TIME
+    struct tm *time;
+    struct tm time_storage;  // Backing storage for `time`
+    int64_t timestamp;       // Seconds since the epoch, same instant as `time`
+#endif
+
+#if ULOG_HAS_THREAD_INFO
+    int64_t thread_id;        // Logging thread
+    const char *thread_name;  // Logging thread's name, "" if it has none
+    int cpu;                  // CPU the event was logged on, -1 if unknown
+#endif
+
+#if ULOG_HAS_SOURCE_LOCATION
+    const char *file;  // Event file name
+    int line;          // Event line number
+#endif                 // ULOG_HAS_SOURCE_LOCATION
+
+    const ulog_kv_field *fields;  // Structured fields, owned by the caller
+    size_t field_count;           // Number of structured fields
+
+#if ULOG_HAS_CONTEXT
+    const ulog_kv_field *context;  // Thread context, comes before `fields`
+    size_t context_count;          // Number of context fields
+#endif
+
+    ulog_format_cache *format_cache;  // Call site format cache or nullptr
+
+#if ULOG_HAS_DYNAMIC_CONFIG
+    uint32_t config;  // Runtime toggles when the event was logged
+#endif
+
+    const ulog_level_descriptor *levels;  // Level names when logged
+    ulog_level level;                     // Event debug level
+};
+
+ulog_status ulog_event_get_message(ulog_event *ev, char *buffer,
+                                   size_t buffer_size) {
+    if (ev == nullptr || buffer == nullptr || buffer_size == 0) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+
+    auto tgt = (print_target){.type       = PRINT_TARGET_BUFFER,
+                              .dsc.buffer = {buffer, 0, buffer_size}};
+
+    // Create a copy of the event to avoid va_list issues
+    auto ev_copy = *ev;
+    va_copy(ev_copy.message_format_args, ev->message_format_args);
+
+    log_print_message(&tgt, &ev_copy);
+
+    va_end(ev_copy.message_format_args);
+    return ULOG_STATUS_OK;
+}
+
+#if ULOG_HAS_TOPICS
+ulog_topic_id ulog_event_get_topic(ulog_event *ev) {
+    if (ev == nullptr) {
+        return ULOG_TOPIC_ID_INVALID;  // Invalid topic
+    }
+    return ev->topic;
+}
+#endif  // ULOG_HAS_TOPICS
+
+#if ULOG_HAS_TIME
+struct tm *ulog_event_get_time(ulog_event *ev) {
+    if (ev == nullptr) {
+        return nullptr;
+    }
+    return ev->time;
+}
+#endif  // ULOG_HAS_TIME
+
+#if ULOG_HAS_THREAD_INFO
+int64_t ulog_event_get_thread_id(ulog_event *ev) {
+    if (ev == nullptr) {
+        return -1;
+    }
+    return ev->thread_id;
+}
+
+const char *ulog_event_get_thread_name(ulog_event *ev) {
+    if (ev == nullptr) {
+        return nullptr;
+    }
+    return ev->thread_name;
+}
+
+int ulog_event_get_cpu(ulog_event *ev) {
+    if (ev == nullptr) {
+        return -1;
+    }
+    return ev->cpu;
+}
+#endif  // ULOG_HAS_THREAD_INFO
+
+#if ULOG_HAS_SOURCE_LOCATION
+const char *ulog_event_get_file(ulog_event *ev) {
+    if (ev == nullptr) {
+        return nullptr;
+    }
+    return ev->file;
+}
+
+int ulog_event_get_line(ulog_event *ev) {
+    if (ev == nullptr) {
+        return -1;
+    }
+    return ev->line;
+}
+#endif  // ULOG_HAS_SOURCE_LOCATION
+
+ulog_level ulog_event_get_level(ulog_event *ev) {
+    if (ev == nullptr) {
+        return ULOG_LEVEL_TRACE;  // Invalid level
+    }
+    return ev->level;
+}
+
+// The thread context is seen as the first fields of the event
+#if ULOG_HAS_CONTEXT
+static inline size_t event_field_count(const ulog_event *ev) {
+    return ev->context_count + ev->field_count;
+}
+
+static inline const ulog_kv_field *event_field(const ulog_event *ev,
+                                               size_t index) {
+    return index < ev->context_count ? &ev->context[index]
+                                     : &ev->fields[index - ev->context_count];
+}
+#else
+#define event_field_count(ev) ((ev)->field_count)
+#define event_field(ev, index) (&(ev)->fields[(index)])
+#endif  // ULOG_HAS_CONTEXT
+
+size_t ulog_event_get_field_count(ulog_event *ev) {
+    if (ev == nullptr) {
+        return 0;
+    }
+    return event_field_count(ev);
+}
+
+const ulog_kv_field *ulog_event_get_field(ulog_event *ev, size_t index) {
+    if (ev == nullptr || index >= event_field_count(ev)) {
+        return nullptr;
+    }
+    return event_field(ev, index);
+}
+
+/* ============================================================================
+   Core Feature: Fields
+   (`field_*`, depends on: Print, Events)
+============================================================================ */
+
+// Private
+// ================
+
+// Doubles keep up to 15 significant digits so that e.g. 0.1 stays 0.1
+static constexpr char field_double_format[] = "%.15g";
+
+/// @brief Checks if a logfmt string value must be quoted
+static bool field_logfmt_needs_quotes(const char *str) {
+    if (str[0] == '\0') {
+        return true;  // Empty value is written as ""
+    }
+    for (auto p = (const unsigned char *)str; *p != '\0'; p++) {
+        if (*p <= ' ' || *p == '=' || *p == '"' || *p == 0x7f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Prints a quoted logfmt string, escaping quotes, backslashes and
+/// control characters. Unescaped spans are copied in one piece.
+static void field_print_logfmt_quoted(print_target *tgt, const char *str) {
+    print_to_target_raw(tgt, "\"", 1);
+    auto span = str;
+    for (auto p = str; *p != '\0'; p++) {
+        auto c = (unsigned char)*p;
+        if (c >= ' ' && c != '"' && c != '\\' && c != 0x7f) {
+            continue;  // Part of the current span
+        }
+        print_to_target_raw(tgt, span, (size_t)(p - span));
+        span = p + 1;
+        switch (c) {
+        case '"':
+            print_to_target_raw(tgt, "\\\"", 2);
+            break;
+        case '\\':
+            print_to_target_raw(tgt, "\\\\", 2);
+            break;
+        case '\n':
+            print_to_target_raw(tgt, "\\n", 2);
+            break;
+        case '\r':
+            print_to_target_raw(tgt, "\\r", 2);
+            break;
+        case '\t':
+            print_to_target_raw(tgt, "\\t", 2);
+            break;
+        default:
+            print_to_target(tgt, "\\u%04x", c);
+            break;
+        }
+    }
+    print_to_target_raw(tgt, span, strlen(span));
+    print_to_target_raw(tgt, "\"", 1);
+}
+
+static void field_print_logfmt_value(print_target *tgt,
+                                     const ulog_kv_field *field) {
+    switch (field->type) {
+    case ULOG_KV_BOOL:
+        field->value.b ? print_to_target_raw(tgt, "true", 4)
+                       : print_to_target_raw(tgt, "false", 5);
+        break;
+    case ULOG_KV_INT:
+        print_to_target(tgt, "%lld", (long long)field->value.i);
+        break;
+    case ULOG_KV_UINT:
+        print_to_target(tgt, "%llu", (unsigned long long)field->value.u);
+        break;
+    case ULOG_KV_DOUBLE:
+        print_to_target(tgt, field_double_format, field->value.d);
+        break;
+    case ULOG_KV_STRING:
+        if (field->value.s == nullptr) {
+            print_to_target_raw(tgt, "null", 4);
+        } else if (field_logfmt_needs_quotes(field->value.s)) {
+            field_print_logfmt_quoted(tgt, field->value.s);
+        } else {
+            print_to_target_raw(tgt, field->value.s,
+                                strlen(field->value.s));
+        }
+        break;
+    default:
+        print_to_target_raw(tgt, "?", 1);
+        break;
+    }
+}
+
+/// @brief Prints event fields as logfmt pairs
+/// @param tgt - Target
+/// @param ev - Event
+/// @param leading_space - Put a space before the first pair
+static void field_print_logfmt(print_target *tgt, ulog_event *ev,
+                               bool leading_space) {
+    for (size_t i = 0; i < event_field_count(ev); i++) {
+        auto field = event_field(ev, i);
+        auto key   = is_str_empty(field->key) ? "?" : field->key;
+        if (i > 0 || leading_space) {
+            print_to_target_raw(tgt, " ", 1);
+        }
+        print_to_target_raw(tgt, key, strlen(key));
+        print_to_target_raw(tgt, "=", 1);
+        field_print_logfmt_value(tgt, field);
+    }
+}
+
+// Public
+// ================
+
+ulog_status ulog_event_fields_to_logfmt(ulog_event *ev, char *out,
+                                        size_t out_size) {
+    if (ev == nullptr || out == nullptr || out_size == 0) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    auto tgt = (print_target){.type       = PRINT_TARGET_BUFFER,
+                              .dsc.buffer = {out, 0, out_size}};
+    out[0]   = '\0';
+    field_print_logfmt(&tgt, ev, false);
+    return ULOG_STATUS_OK;
+}
+
+/* ============================================================================
+   Optional Feature: Context
+   (`context_*`, depends on: Events, Fields)
+============================================================================ */
+#if ULOG_HAS_CONTEXT
+
+enum {
+    context_value_size = 64,  // String values are copied, truncated to this
+};
+
+// Private
+// ================
+
+// Fields of the calling thread, attached to its events without copying.
+// `depth` also counts pushes past the capacity, so pops stay balanced.
+typedef struct {
+    ulog_kv_field fields[ULOG_BUILD_CONTEXT_SIZE];
+    char values[ULOG_BUILD_CONTEXT_SIZE][context_value_size];
+    size_t depth;
+} context_stack_t;
+
+static thread_local context_stack_t context_stack;
+
+// Prototypes
+#if ULOG_HAS_PREFIX
+static void prefix_context_changed();
+#else
+#define prefix_context_changed() (void)0
+#endif  // ULOG_HAS_PREFIX
+
+static void context_fill(ulog_event *ev) {
+    auto depth = context_stack.depth;
+    if (depth > ULOG_BUILD_CONTEXT_SIZE) {
+        depth = ULOG_BUILD_CONTEXT_SIZE;  // Pushed past the capacity
+    }
+    ev->context       = context_stack.fields;
+    ev->context_count = depth;
+}
+
+// Public
+// ================
+
+ulog_status ulog_context_push_field(ulog_kv_field field) {
+    prefix_context_changed();
+    auto index = context_stack.depth++;
+    if (index >= ULOG_BUILD_CONTEXT_SIZE) {
+        return ULOG_STATUS_ERROR;  // Not attached, but popped as usual
+    }
+    if (field.type == ULOG_KV_STRING && field.value.s != nullptr) {
+        auto value = context_stack.values[index];
+        auto len   = strlen(field.value.s);
+        len        = len < context_value_size ? len : context_value_size - 1;
+        memcpy(value, field.value.s, len);
+        value[len]    = '\0';
+        field.value.s = value;
+    }
+    context_stack.fields[index] = field;
+    return ULOG_STATUS_OK;
+}
+
+ulog_status ulog_context_pop() {
+    if (context_stack.depth == 0) {
+        return ULOG_STATUS_NOT_FOUND;
+    }
+    context_stack.depth--;
+    prefix_context_changed();
+    return ULOG_STATUS_OK;
+}
+
+ulog_status ulog_context_clear() {
+    context_stack.depth = 0;
+    prefix_context_changed();
+    return ULOG_STATUS_OK;
+}
+
+#else  // ULOG_HAS_CONTEXT
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+ulog_status ulog_context_push_field(ulog_kv_field field) {
+    (void)(field);
+    warn_not_enabled("ULOG_BUILD_CONTEXT_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_context_pop() {
+    warn_not_enabled("ULOG_BUILD_CONTEXT_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_context_clear() {
+    warn_not_enabled("ULOG_BUILD_CONTEXT_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define context_fill(ev) (void)(ev)
+#endif  // ULOG_HAS_CONTEXT
+
+/* ============================================================================
+   Core Functionality: Lock
+   (`lock_*`, depends on: - )
+============================================================================ */
+
+// Private
+// ================
+typedef struct {
+    ulog_lock_fn function;  // Lock function
+    void *args;             // Argument for the lock function
+} lock_data_t;
+
+// No lock function by default
+static lock_data_t lock_instances[logger_total_num];
+#define lock_data lock_instances[logger_id()]
+
+static ulog_status lock_lock() {
+    if (!logger_pin()) {
+        return ULOG_STATUS_BUSY;  // The selected instance was removed
+    }
+    if (lock_data.function != nullptr) {
+        auto start  = stats_now_ns();
+        auto status = lock_data.function(true, lock_data.args);
+        stats_lock_waited(start);
+        if (status != ULOG_STATUS_OK) {
+            logger_unpin();
+        }
+        return status;
+    }
+    return ULOG_STATUS_OK;
+}
+
+/// @brief Unlocks but keeps the instance pinned for work that reads it past
+/// the lock; `logger_unpin` ends it
+static ulog_status lock_release() {
+    if (lock_data.function != nullptr) {
+        return lock_data.function(false, lock_data.args);
+    }
+    return ULOG_STATUS_OK;
+}
+
+static ulog_status lock_unlock() {
+    auto status = lock_release();
+    logger_unpin();
+    return status;
+}
+
+// Public
+// ================
+
+/// @brief  Sets the lock function and user data
+ulog_status ulog_lock_set_fn(ulog_lock_fn function, void *lock_arg) {
+    if (!logger_pin()) {
+        return ULOG_STATUS_BUSY;  // The selected instance was removed
+    }
+    lock_data.function = function;
+    lock_data.args     = function != nullptr ? lock_arg : nullptr;
+    logger_unpin();
+    return ULOG_STATUS_OK;
+}
+/* ============================================================================
+   Optional Feature: Dynamic Configuration - Config Snapshot
+   (`config_*`, depends on: Lock, Events)
+============================================================================ */
+#if ULOG_HAS_DYNAMIC_CONFIG
+#include <stdatomic.h>
+
+// Private
+// ================
+
+typedef enum {
+    CONFIG_COLOR           = 1 << 0,
+    CONFIG_PREFIX          = 1 << 1,
+    CONFIG_TIME            = 1 << 2,
+    CONFIG_LEVEL_SHORT     = 1 << 3,
+    CONFIG_TOPICS          = 1 << 4,
+    CONFIG_SOURCE_LOCATION = 1 << 5,
+    CONFIG_THREAD_INFO     = 1 << 6,
+} config_flags;
+
+// The runtime toggles fit one word, so a single atomic load is a consistent
+// snapshot and loggers never take the lock to read them. Writers are
+// serialized by the lock. The word has a cache line of its own, so it is only
+// invalidated when the configuration changes.
+typedef struct {
+    alignas(64) _Atomic(uint32_t) flags;  // config_flags
+} config_data_t;
+
+static constexpr uint32_t config_flags_default =
+    (ULOG_HAS_COLOR ? CONFIG_COLOR : 0) |
+    (ULOG_HAS_PREFIX ? CONFIG_PREFIX : 0) |
+    (ULOG_HAS_TIME ? CONFIG_TIME : 0) |
+    (ULOG_HAS_TOPICS ? CONFIG_TOPICS : 0) |
+    (ULOG_HAS_SOURCE_LOCATION ? CONFIG_SOURCE_LOCATION : 0);
+
+static config_data_t config_instances[logger_total_num] = {
+    {.flags = config_flags_default},
+};
+#define config_data config_instances[logger_id()]
+
+/// @brief Restores the toggles of a new instance
+static void config_reset() {
+    atomic_store_explicit(&config_data.flags, config_flags_default,
+                          memory_order_release);
+}
+
+/// @brief Stores the snapshot the event is printed with
+static inline void config_take(ulog_event *ev) {
+    ev->config =
+        atomic_load_explicit(&config_data.flags, memory_order_acquire);
+}
+
+/// @brief Publishes a toggle. Called with the lock held.
+static void config_store(config_flags flag, bool enabled) {
+    if (enabled) {
+        atomic_fetch_or_explicit(&config_data.flags, (uint32_t)flag,
+                                 memory_order_release);
+    } else {
+        atomic_fetch_and_explicit(&config_data.flags, ~(uint32_t)flag,
+                                  memory_order_release);
+    }
+}
+
+static ulog_status config_set(config_flags flag, bool enabled) {
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;  // Failed to acquire lock
+    }
+    config_store(flag, enabled);
+    return lock_unlock();
+}
+
+#else  // ULOG_HAS_DYNAMIC_CONFIG
+
+// Disabled Private
+// ================
+
+#define config_take(ev) (void)(ev)
+#define config_reset() (void)0
+
+#endif  // ULOG_HAS_DYNAMIC_CONFIG
+
+/* ============================================================================
+   Optional Feature: Dynamic Configuration - Color
+   (`color_config_*`, depends on: Config Snapshot)
+============================================================================ */
+#if ULOG_HAS_DYNAMIC_CONFIG
+
+// Private
+// ================
+
+static inline bool color_config_is_enabled(const ulog_event *ev) {
+    return (ev->config & CONFIG_COLOR) != 0;
+}
+
+// Public
+// ================
+
+ulog_status ulog_color_config(bool enabled) {
+    return config_set(CONFIG_COLOR, enabled);
+}
+
+#else  // ULOG_HAS_DYNAMIC_CONFIG
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+ulog_status ulog_color_config(bool enabled) {
+    (void)(enabled);
+    warn_not_enabled("ULOG_BUILD_COLOR");
+    return ULOG_STATUS_DISABLED;
+}
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define color_config_is_enabled(ev) ((void)(ev), ULOG_HAS_COLOR)
+
+#endif  // ULOG_HAS_DYNAMIC_CONFIG
+
+/* ============================================================================
+   Optional Feature: Color
+   (`color_*`, depends on: Print, Color Config)
+============================================================================ */
+#if ULOG_HAS_COLOR
+
+//  Private
+// ================
+
+// From https://en.wikipedia.org/wiki/ANSI_escape_code#8-bit
+// ANSI color codes from least to most attention-grabbing
+static constexpr const char color_levels[][11] = {
+    "\x1b[m",            // LEVEL_0: Color reset (default)
+    "\x1b[36m",          // LEVEL_1: Color (Cyan)
+    "\x1b[32m",          // LEVEL_2: Color (Green)
+    "\x1b[33m",          // LEVEL_3: Color (Yellow)
+    "\x1b[31m",          // LEVEL_4: Color (Red)
+    "\x1b[31m\x1b[47m",  // LEVEL_5: Color (Red on White)
+    "\x1b[43m\x1b[31m",  // LEVEL_6: Color (Yellow on Red)
+    "\x1b[41m\x1b[97m",  // LEVEL_7: Color (White on Red)
+};
+
+static constexpr const char color_terminator[] = "\x1b[0m";
+
+static void color_print_start(print_target *tgt, ulog_event *ev) {
+    if (!color_config_is_enabled(ev)) {
+        return;  // Color is disabled, do not print color codes
+    }
+    print_to_target(tgt, "%s", color_levels[ev->level]);  // color start
+}
+
+static void color_print_end(print_target *tgt, ulog_event *ev) {
+    if (!color_config_is_enabled(ev)) {
+        return;  // Color is disabled, do not print color codes
+    }
+    print_to_target(tgt, "%s", color_terminator);  // color end
+}
+
+#else  // ULOG_HAS_COLOR
+
+// Disabled Private
+// ================
+
+#define color_print_start(tgt, ev) (void)(tgt), (void)(ev)
+#define color_print_end(tgt, ev) (void)(tgt), (void)(ev)
+
+#endif  // ULOG_HAS_COLOR
+
+/* ============================================================================
+   Optional Feature: Dynamic Configuration - Prefix
+   (`prefix_config_*`, depends on: Config Snapshot)
+============================================================================ */
+#if ULOG_HAS_DYNAMIC_CONFIG
+
+// Private
+// ================
+
+static inline bool prefix_config_is_enabled(const ulog_event *ev) {
+    return (ev->config & CONFIG_PREFIX) != 0;
+}
+
+// Public
+// ================
+
+ulog_status ulog_prefix_config(bool enabled) {
+    return config_set(CONFIG_PREFIX, enabled);
+}
+
+#else  // ULOG_HAS_DYNAMIC_CONFIG
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+ulog_status ulog_prefix_config(bool enabled) {
+    (void)(enabled);
+    warn_not_enabled("ULOG_BUILD_DYNAMIC_CONFIG");
+    return ULOG_STATUS_DISABLED;
+}
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define prefix_config_is_enabled(ev) ((void)(ev), ULOG_HAS_PREFIX)
+#endif  // ULOG_HAS_DYNAMIC_CONFIG
+
+/* ============================================================================
+   Optional Feature: Prefix
+   (`prefix_*`, depends on: Print, Prefix Config)
+============================================================================ */
+#if ULOG_HAS_PREFIX
+
+// Private
+// ================
+typedef struct {
+    ulog_prefix_fn function;
+    ulog_prefix_mode mode;
+    uint32_t generation;  // Bumped when cached prefixes go stale
+} prefix_data_t;
+
+static prefix_data_t prefix_instances[logger_total_num] = {
+    {.function = nullptr, .mode = ULOG_PREFIX_MODE_EVENT},
+};
+#define prefix_data prefix_instances[logger_id()]
+
+// Prefix of the thread in ULOG_PREFIX_MODE_THREAD, rendered by the first event
+// after the thread's context or the prefix configuration changed
+typedef struct {
+    bool valid;  // Cleared by `ulog_prefix_invalidate` and context changes
+    ulog_logger_id logger;
+    uint32_t generation;  // `prefix_data.generation` when rendered
+    char prefix[ULOG_BUILD_PREFIX_SIZE];
+} prefix_cache_t;
+
+static thread_local prefix_cache_t prefix_cache;
+
+static void prefix_cached(ulog_event *ev, ulog_prefix_fn function) {
+    if (!prefix_cache.valid || prefix_cache.logger != logger_id() ||
+        prefix_cache.generation != prefix_data.generation) {
+        prefix_cache.prefix[0] = '\0';
+        function(ev, prefix_cache.prefix, ULOG_BUILD_PREFIX_SIZE);
+        prefix_cache.prefix[ULOG_BUILD_PREFIX_SIZE - 1] = '\0';
+        prefix_cache.valid      = true;
+        prefix_cache.logger     = logger_id();
+        prefix_cache.generation = prefix_data.generation;
+    }
+    memcpy(ev->prefix, prefix_cache.prefix, strlen(prefix_cache.prefix) + 1);
+}
+
+// Called by the context functions: the prefix may print the thread's fields
+static void prefix_context_changed() {
+    prefix_cache.valid = false;  // Thread-local, no lock needed
+}
+
+// The prefix is kept in the event, so outputs running outside the global lock
+// print the prefix of their own event. Called with the global lock held.
+/// @return The function to render the prefix with once the lock is released,
+/// nullptr if the event has no prefix or it came from the thread's cache
+static ulog_prefix_fn prefix_update(ulog_event *ev) {
+    auto function = prefix_data.function;
+    if (function == nullptr || !prefix_config_is_enabled(ev)) {
+        return nullptr;
+    }
+    ev->has_prefix = true;
+    if (prefix_data.mode == ULOG_PREFIX_MODE_THREAD) {
+        prefix_cached(ev, function);
+        return nullptr;
+    }
+    return function;
+}
+
+/// @brief Renders the prefix of the event, without the global lock
+static void prefix_render(ulog_event *ev, ulog_prefix_fn function) {
+    ev->prefix[0] = '\0';
+    function(ev, ev->prefix, ULOG_BUILD_PREFIX_SIZE);
+}
+
+static void prefix_print(print_target *tgt, ulog_event *ev) {
+    if (!ev->has_prefix || !prefix_config_is_enabled(ev)) {
+        return;
+    }
+    print_to_target(tgt, "%s", ev->prefix);
+}
+
+// Public
+// ================
+
+ulog_status ulog_prefix_set_fn(ulog_prefix_fn function) {
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    if (function == nullptr) {
+        if (lock_unlock() != ULOG_STATUS_OK) {
+            return ULOG_STATUS_BUSY;
+        }
+        return ULOG_STATUS_INVALID_ARGUMENT;  // Ignore nullptr function
+    }
+    prefix_data.function = function;
+    prefix_data.generation++;
+    return lock_unlock();
+}
+
+ulog_status ulog_prefix_mode_set(ulog_prefix_mode mode) {
+    if (mode != ULOG_PREFIX_MODE_EVENT && mode != ULOG_PREFIX_MODE_THREAD) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    prefix_data.mode = mode;
+    prefix_data.generation++;
+    return lock_unlock();
+}
+
+ulog_status ulog_prefix_invalidate() {
+    prefix_context_changed();
+    return ULOG_STATUS_OK;
+}
+
+#else  // ULOG_HAS_PREFIX
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+ulog_status ulog_prefix_set_fn(ulog_prefix_fn function) {
+    (void)(function);
+    warn_not_enabled("ULOG_BUILD_PREFIX_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_prefix_mode_set(ulog_prefix_mode mode) {
+    (void)(mode);
+    warn_not_enabled("ULOG_BUILD_PREFIX_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_prefix_invalidate() {
+    warn_not_enabled("ULOG_BUILD_PREFIX_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define prefix_print(tgt, ev) ((void)(tgt), (void)(ev))
+#define prefix_update(ev) ((void)(ev), (ulog_prefix_fn)nullptr)
+#define prefix_render(ev, function) ((void)(ev), (void)(function))
+#endif  // ULOG_HAS_PREFIX
+
+/* ============================================================================
+   Optional Feature: Dynamic Configuration - Time
+   (`time_config_*`, depends on: Config Snapshot)
+============================================================================ */
+#if ULOG_HAS_DYNAMIC_CONFIG
+
+// Private
+// ================
+
+static inline bool time_config_is_enabled(const ulog_event *ev) {
+    return (ev->config & CONFIG_TIME) != 0;
+}
+
+// Public
+// ================
+
+ulog_status ulog_time_config(bool enabled) {
+    return config_set(CONFIG_TIME, enabled);
+}
+
+#else  // ULOG_HAS_DYNAMIC_CONFIG
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+ulog_status ulog_time_config(bool enabled) {
+    (void)(enabled);
+    warn_not_enabled("ULOG_BUILD_TIME");
+    return ULOG_STATUS_DISABLED;
+}
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define time_config_is_enabled(ev) ((void)(ev), ULOG_HAS_TIME)
+#endif  // ULOG_HAS_DYNAMIC_CONFIG
+
+/* ============================================================================
+   Optional Feature: Time
+   (`time_*`, depends on: Time, Print)
+============================================================================ */
+#if ULOG_HAS_TIME
+
+#include <time.h>
+
+enum {
+    time_short_buf_size = 10,  // HH:MM:SS(8) + 1 space + null
+    time_full_buf_size  = 21,  // YYYY-MM-DD HH:MM:SS(19) + 1 space + null
+};
+
+// Private
+// ================
+static bool time_print_if_invalid(print_target *tgt, ulog_event *ev) {
+    if (ev->time == nullptr) {
+        print_to_target(tgt, "INVALID_TIME");
+        return true;  // Time is invalid, print error message
+    }
+    return false;  // Time is valid
+}
+
+/// @brief Fills the event time with the current local time
+/// @param ev - Event to fill. Assumed not nullptr
+static void time_fill_current_time(ulog_event *ev) {
+    auto current_time = time(nullptr);  // Get current time
+    // Local clock fields. localtime_r, unlike localtime, does not re-read the
+    // time zone (and allocate) on every call.
+    ev->time      = localtime_r(&current_time, &ev->time_storage);
+    ev->timestamp = (int64_t)current_time;
+}
+
+static void time_print_short(print_target *tgt, ulog_event *ev,
+                             bool append_space) {
+    if (!time_config_is_enabled(ev) || time_print_if_invalid(tgt, ev)) {
+        return;  // If time is not valid or disabled, stop printing
+    }
+    char buf[time_short_buf_size] = {0};
+    auto format                   = append_space ? "%H:%M:%S " : "%H:%M:%S";
+    strftime(buf, time_short_buf_size, format, ev->time);
+    print_to_target(tgt, "%s", buf);
+}
+
+#if ULOG_HAS_EXTRA_OUTPUTS
+static void time_print_full(print_target *tgt, ulog_event *ev,
+                            bool append_space) {
+    if (!time_config_is_enabled(ev) || time_print_if_invalid(tgt, ev)) {
+        return;  // If time is not valid or disabled, stop printing
+    }
+    char buf[time_full_buf_size] = {0};
+    auto format = append_space ? "%Y-%m-%d %H:%M:%S " : "%Y-%m-%d %H:%M:%S";
+    strftime(buf, time_full_buf_size, format, ev->time);
+    print_to_target(tgt, "%s", buf);
+}
+#else
+#define time_print_full(tgt, ev, append_space) (void)(0)
+#endif  // ULOG_HAS_EXTRA_OUTPUTS
+
+#else  // ULOG_HAS_TIME
+
+// Disabled Private
+// ================
+
+#define time_print_short(tgt, ev, append_space) (void)(0)
+#define time_print_full(tgt, ev, append_space) (void)(0)
+#define time_fill_current_time(ev) (void)(ev)
+#endif  // ULOG_HAS_TIME
+
+/* ============================================================================
+   Optional Feature: Dynamic Configuration - Thread Info
+   (`thread_config_*`, depends on: Config Snapshot)
+============================================================================ */
+#if ULOG_HAS_DYNAMIC_CONFIG
+
+// Private
+// ================
+
+// Off by default: unlike the other toggles it adds a column to every line
+static inline bool thread_config_is_enabled(const ulog_event *ev) {
+    return (ev->config & CONFIG_THREAD_INFO) != 0;
+}
+
+// Public
+// ================
+
+ulog_status ulog_thread_info_config(bool enabled) {
+    return config_set(CONFIG_THREAD_INFO, enabled);
+}
+
+#else  // ULOG_HAS_DYNAMIC_CONFIG
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+ulog_status ulog_thread_info_config(bool enabled) {
+    (void)(enabled);
+    warn_not_enabled("ULOG_BUILD_THREAD_INFO");
+    return ULOG_STATUS_DISABLED;
+}
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define thread_config_is_enabled(ev) ((void)(ev), ULOG_HAS_THREAD_INFO)
+#endif  // ULOG_HAS_DYNAMIC_CONFIG
+
+/* ============================================================================
+   Optional Feature: Thread Info
+   (`thread_*`, depends on: Thread Info Config, Print)
+============================================================================ */
+#if ULOG_HAS_THREAD_INFO
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <stdatomic.h>
+#endif
+
+enum {
+    thread_name_size = 16,  // Linux TASK_COMM_LEN, terminator included
+};
+
+// Private
+// ================
+
+// Captured on the thread's first event, so a logger pays for the system calls
+// once, not per event
+typedef struct {
+    bool captured;
+    bool named;  // Set by `ulog_thread_name_set`, kept over the system name
+    int64_t id;
+    char name[thread_name_size];
+} thread_info_t;
+
+static thread_local thread_info_t thread_info;
+
+#ifndef __linux__
+static _Atomic(int64_t) thread_next_id = 1;  // IDs handed out in order
+#endif
+
+#ifdef __linux__
+static pthread_once_t thread_atfork_once = PTHREAD_ONCE_INIT;
+
+// Only the forking thread lives on in the child, and its cached ID is the
+// parent's; capture it again on the child's next event
+static void thread_atfork_child() {
+    thread_info.captured = false;
+}
+
+static void thread_atfork_register() {
+    (void)pthread_atfork(nullptr, nullptr, thread_atfork_child);
+}
+#endif
+
+static void thread_capture() {
+    if (thread_info.captured) {
+        return;
+    }
+#ifdef __linux__
+    (void)pthread_once(&thread_atfork_once, thread_atfork_register);
+    thread_info.id = (int64_t)syscall(SYS_gettid);
+    char name[thread_name_size] = {0};
+    if (!thread_info.named &&
+        prctl(PR_GET_NAME, (unsigned long)name, 0, 0, 0) == 0) {
+        memcpy(thread_info.name, name, thread_name_size - 1);
+    }
+#else
+    thread_info.id = atomic_fetch_add_explicit(&thread_next_id, 1,
+                                               memory_order_relaxed);
+#endif
+    thread_info.captured = true;
+}
+
+/// @brief CPU the calling thread runs on, -1 if unknown. `sched_getcpu` reads
+/// it from the rseq area or the vDSO, without entering the kernel.
+static int thread_cpu() {
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+static void thread_fill(ulog_event *ev) {
+    thread_capture();
+    ev->thread_id   = thread_info.id;
+    ev->thread_name = thread_info.name;
+    ev->cpu         = thread_config_is_enabled(ev) ? thread_cpu() : -1;
+}
+
+static void thread_print(print_target *tgt, ulog_event *ev) {
+    if (!thread_config_is_enabled(ev)) {
+        return;
+    }
+    print_to_target(tgt, "[%lld", (long long)ev->thread_id);
+    if (!is_str_empty(ev->thread_name)) {
+        print_to_target(tgt, " %s", ev->thread_name);
+    }
+    if (ev->cpu >= 0) {
+        print_to_target(tgt, " cpu%d", ev->cpu);
+    }
+    print_to_target(tgt, "] ");
+}
+
+// Public
+// ================
+
+ulog_status ulog_thread_name_set(const char *name) {
+    if (name == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    auto len = strlen(name);
+    len      = len < thread_name_size ? len : thread_name_size - 1;
+    memcpy(thread_info.name, name, len);
+    thread_info.name[len] = '\0';
+    thread_info.named     = true;
+    return ULOG_STATUS_OK;
+}
+
+#else  // ULOG_HAS_THREAD_INFO
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+ulog_status ulog_thread_name_set(const char *name) {
+    (void)(name);
+    warn_not_enabled("ULOG_BUILD_THREAD_INFO");
+    return ULOG_STATUS_DISABLED;
+}
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define thread_fill(ev) (void)(ev)
+#define thread_print(tgt, ev) ((void)(tgt), (void)(ev))
+#endif  // ULOG_HAS_THREAD_INFO
+
+/* ============================================================================
+   Core Feature: Levels
+   (`level_*`, depends on: Levels Config, Print)
+============================================================================ */
+
+// Private
+// ================
+static constexpr ulog_level level_min_value = ULOG_LEVEL_0;
+
+typedef struct {
+    const ulog_level_descriptor *dsc;
+} level_data_t;
+
+static const ulog_level_descriptor level_names_default = {
+    .max_level = ULOG_LEVEL_FATAL,
+#if ULOG_HAS_LEVEL_SHORT && !ULOG_HAS_LEVEL_LONG
+    .names = {"T", "D", "I", "W", "E", "F", nullptr, nullptr},
+#else
+    .names = {"TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "FATAL", nullptr,
+              nullptr},
+#endif
+};
+
+static level_data_t level_instances[logger_total_num] = {
+    {.dsc = &level_names_default},
+};
+#define level_data level_instances[logger_id()]
+
+static bool level_is_allowed(ulog_level msg_level, ulog_level log_verbosity) {
+    if (msg_level < log_verbosity || msg_level < level_min_value) {
+        return false;  // Level is higher than the configured level, not allowed
+    }
+
+    return true;  // Level is allowed
+}
+
+static bool level_is_valid(ulog_level level) {
+    return (level >= level_min_value && level <= level_data.dsc->max_level);
+}
+
+static bool level_descriptor_is_valid(const ulog_level_descriptor *dsc) {
+    if (dsc == nullptr || dsc->max_level < level_min_value ||
+        dsc->max_level >= ULOG_LEVEL_TOTAL) {
+        return false;
+    }
+
+    for (auto i = (int)level_min_value; i <= (int)dsc->max_level; i++) {
+        if (is_str_empty(dsc->names[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Name of the event level among the names it was logged with, so
+/// outputs running after the global lock print the names of that moment
+static const char *level_event_name(const ulog_event *ev) {
+    if (ev->level < level_min_value || ev->level > ev->levels->max_level) {
+        return "?";
+    }
+    return ev->levels->names[ev->level];
+}
+
+static void level_print(print_target *tgt, ulog_event *ev) {
+    print_to_target(tgt, "%s ", level_event_name(ev));
+}
+
+// Public
+// ================
+
+/// @brief Returns the string representation of the level
+const char *ulog_level_to_string(ulog_level level) {
+    if (level < level_min_value || level > level_data.dsc->max_level) {
+        return "?";  // Return a default string for invalid levels
+    }
+
+    return level_data.dsc->names[level];
+}
+
+ulog_status ulog_level_set_new_levels(const ulog_level_descriptor *new_levels) {
+    if (!level_descriptor_is_valid(new_levels)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;  // Invalid argument
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;  // Failed to acquire lock
+    }
+
+    level_data.dsc = new_levels;
+    return lock_unlock();
+}
+
+ulog_status ulog_level_reset_levels() {
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;  // Failed to acquire lock
+    }
+
+    level_data.dsc = &level_names_default;
+    return lock_unlock();
+}
+
+/* ============================================================================
+   Optional Feature: Dynamic Configuration - Level
+   (`level_config_*`, depends on: - )
+============================================================================ */
+#if ULOG_HAS_DYNAMIC_CONFIG
+
+// Private
+// ================
+
+static const ulog_level_descriptor level_names_default_short = {
+    .max_level = ULOG_LEVEL_FATAL,
+    .names     = {"T", "D", "I", "W", "E", "F", nullptr, nullptr},
+};
+
+static inline bool level_config_is_short(const ulog_event *ev) {
+    return (ev->config & CONFIG_LEVEL_SHORT) != 0;
+}
+
+// Public
+// ================
+
+ulog_status ulog_level_config(ulog_level_config_style style) {
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    auto short_style = (style == ULOG_LEVEL_CONFIG_STYLE_SHORT);
+    if (short_style) {
+        level_data.dsc = &level_names_default_short;
+    } else {
+        level_data.dsc = &level_names_default;
+    }
+    config_store(CONFIG_LEVEL_SHORT, short_style);
+    return lock_unlock();
+}
+
+#else  // ULOG_HAS_DYNAMIC_CONFIG
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+
+ulog_status ulog_level_config(ulog_level_config_style style) {
+    (void)(style);
+    warn_not_enabled("ULOG_BUILD_DYNAMIC_CONFIG");
+    return ULOG_STATUS_DISABLED;
+}
+
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define level_config_is_short(ev) ((void)(ev), ULOG_HAS_LEVEL_SHORT)
+#endif  // ULOG_HAS_DYNAMIC_CONFIG
+
+/* ============================================================================
+   Optional Feature: Callsite Registry
+   (`site_*`, depends on: Events, Levels)
+============================================================================ */
+#if ULOG_HAS_CALLSITE_REGISTRY
+#include <limits.h>
+#include <stdatomic.h>
+
+// Private
+// ================
+
+// Code built with ULOG_BUILD_CALLSITE_REGISTRY=1 places the `ulog_site` of
+// every logging macro in the `ulog_sites` section, which the linker brackets
+// with these symbols. Both stay null if the program has no registered site.
+extern ulog_site __start_ulog_sites[] __attribute__((weak));
+extern ulog_site __stop_ulog_sites[] __attribute__((weak));
+
+typedef enum {
+    SITE_ENABLE,   // Sites at the level and above forced on, the rest off
+    SITE_DISABLE,  // Sites at the level and below off
+    SITE_RESTORE,  // Back to the level filters
+} site_action;
+
+// Parsed `file_glob[:first[-last]]`
+typedef struct {
+    const char *glob;  // Not terminated, `glob_size` characters
+    size_t glob_size;
+    int first;  // Line range, inclusive
+    int last;
+} site_pattern;
+
+static bool site_pattern_parse(const char *pattern, site_pattern *out) {
+    *out = (site_pattern){pattern, strlen(pattern), 0, INT_MAX};
+
+    auto colon = strrchr(pattern, ':');
+    if (colon == nullptr) {
+        return true;  // File pattern only
+    }
+    char *end  = nullptr;
+    auto first = strtol(colon + 1, &end, 10);
+    auto last  = first;
+    if (end != colon + 1 && *end == '-') {
+        last = strtol(end + 1, &end, 10);
+    }
+    if (end == colon + 1 || *end != '\0' || first < 0 || last < first ||
+        last > INT_MAX) {
+        return false;
+    }
+    out->glob_size = (size_t)(colon - pattern);
+    out->first     = (int)first;
+    out->last      = (int)last;
+    return true;
+}
+
+/// @brief Matches `str` against a glob where `*` is any run of characters
+/// (slashes included) and `?` any single character
+static bool site_glob_match(const char *glob, size_t size, const char *str) {
+    size_t g         = 0;
+    size_t star      = SIZE_MAX;  // Position after the last `*`
+    const char *back = nullptr;   // Where that `*` resumes in `str`
+
+    while (*str != '\0') {
+        if (g < size && glob[g] == '*') {
+            star = ++g;
+            back = str;
+        } else if (g < size && (glob[g] == '?' || glob[g] == *str)) {
+            g++;
+            str++;
+        } else if (star != SIZE_MAX) {
+            g   = star;  // Let the `*` take one more character
+            str = ++back;
+        } else {
+            return false;
+        }
+    }
+    while (g < size && glob[g] == '*') {
+        g++;
+    }
+    return g == size;
+}
+
+/// @brief Matches the pattern against the whole file name or any part of it
+/// that starts after a `/`, so "net/*.c" finds "src/net/tcp.c"
+static bool site_match(const site_pattern *p, const ulog_site *site) {
+    if (site->line < p->first || site->line > p->last) {
+        return false;
+    }
+    if (p->glob_size == 0) {
+        return true;
+    }
+    for (auto part = site->file; part != nullptr; part = strchr(part, '/')) {
+        part += (*part == '/');
+        if (site_glob_match(p->glob, p->glob_size, part)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief New flags of a matching site, or -1 to keep them
+static int site_action_flags(site_action action, const ulog_site *site,
+                             ulog_level level) {
+    auto known = site->level < ULOG_LEVEL_TOTAL;  // Constant level
+    switch (action) {
+    case SITE_ENABLE:
+        return !known || site->level >= level
+                   ? ULOG_SITE_ENABLED | ULOG_SITE_FORCED
+                   : 0;
+    case SITE_DISABLE:
+        return !known || site->level <= level ? 0 : -1;
+    default:
+        return ULOG_SITE_ENABLED;
+    }
+}
+
+static ulog_status site_update(const char *pattern, site_action action,
+                               ulog_level level) {
+    site_pattern p;
+    if (pattern == nullptr || !site_pattern_parse(pattern, &p)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (action != SITE_RESTORE && !level_is_valid(level)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+
+    auto found = false;
+    for (auto site = __start_ulog_sites; site < __stop_ulog_sites; site++) {
+        if (!site_match(&p, site)) {
+            continue;
+        }
+        auto flags = site_action_flags(action, site, level);
+        if (flags >= 0) {
+            atomic_store_explicit(&site->flags, (uint8_t)flags,
+                                  memory_order_relaxed);
+            found = true;
+        }
+    }
+    return found ? ULOG_STATUS_OK : ULOG_STATUS_NOT_FOUND;
+}
+
+static inline bool site_is_forced(ulog_site *site) {
+    return (atomic_load_explicit(&site->flags, memory_order_relaxed) &
+            ULOG_SITE_FORCED) != 0;
+}
+
+// Public
+// ================
+
+ulog_status ulog_callsite_enable(const char *pattern, ulog_level level) {
+    return site_update(pattern, SITE_ENABLE, level);
+}
+
+ulog_status ulog_callsite_disable(const char *pattern, ulog_level level) {
+    return site_update(pattern, SITE_DISABLE, level);
+}
+
+ulog_status ulog_callsite_restore(const char *pattern) {
+    return site_update(pattern, SITE_RESTORE, ULOG_LEVEL_TOTAL);
+}
+
+ulog_status ulog_callsite_list(FILE *file) {
+    if (file == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    for (auto site = __start_ulog_sites; site < __stop_ulog_sites; site++) {
+        auto flags = atomic_load_explicit(&site->flags, memory_order_relaxed);
+        auto state = (flags & ULOG_SITE_FORCED)    ? "forced"
+                     : (flags & ULOG_SITE_ENABLED) ? "on"
+                                                   : "off";
+        auto level = site->level < ULOG_LEVEL_TOTAL
+                         ? ulog_level_to_string(site->level)
+                         : "*";
+        fprintf(file, "%s:%d %-6s %-6s %s%s%s\"%s\"\n", site->file,
+                site->line, level, state, site->topic ? "[" : "",
+                site->topic ? site->topic : "", site->topic ? "] " : "",
+                site->format ? site->format : "");
+    }
+    return ULOG_STATUS_OK;
+}
+
+#else  // ULOG_HAS_CALLSITE_REGISTRY
+
+// Disabled Private
+// ================
+
+#define site_is_forced(site) ((void)(site), false)
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+
+ulog_status ulog_callsite_enable(const char *pattern, ulog_level level) {
+    (void)(pattern);
+    (void)(level);
+    warn_not_enabled("ULOG_BUILD_CALLSITE_REGISTRY");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_callsite_disable(const char *pattern, ulog_level level) {
+    (void)(pattern);
+    (void)(level);
+    warn_not_enabled("ULOG_BUILD_CALLSITE_REGISTRY");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_callsite_restore(const char *pattern) {
+    (void)(pattern);
+    warn_not_enabled("ULOG_BUILD_CALLSITE_REGISTRY");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_callsite_list(FILE *file) {
+    (void)(file);
+    warn_not_enabled("ULOG_BUILD_CALLSITE_REGISTRY");
+    return ULOG_STATUS_DISABLED;
+}
+
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+#endif  // ULOG_HAS_CALLSITE_REGISTRY
+
+/* ============================================================================
+   Core Feature: Outputs
+   (`output_*`, depends on: Print, Log, Level)
+============================================================================ */
+
+//  Private
+// ================
+#if ULOG_HAS_EXTRA_OUTPUTS
+enum { output_total_num = (1 + ULOG_BUILD_EXTRA_OUTPUTS) };  // stdout + extra
+#else
+enum { output_total_num = 1 };  // Only stdout
+#endif  // ULOG_HAS_EXTRA_OUTPUTS
+
+static constexpr ulog_level output_stdout_default_level = ULOG_LEVEL_TRACE;
+
+// Prototypes
+static void output_stdout_handler(ulog_event *ev, void *arg);
+static void log_print_event(print_target *tgt, ulog_event *ev, bool full_time,
+                            bool color, bool new_line);
+#if ULOG_HAS_OUTPUT_QUEUE
+static bool queue_is_on(ulog_output_id output);
+static bool queue_push(ulog_output_id output, ulog_event *ev);
+static void queue_stop(ulog_output_id output);
+#else
+#define queue_is_on(output) ((void)(output), false)
+#define queue_push(output, ev) ((void)(output), (void)(ev), false)
+#define queue_stop(output) (void)(output)
+#endif  // ULOG_HAS_OUTPUT_QUEUE
+#if ULOG_HAS_TOPICS
+static void topic_route_update_all();
+#else
+#define topic_route_update_all() (void)0
+#endif  // ULOG_HAS_TOPICS
+
+// Set of outputs, bit N is the output with ID N
+typedef uint32_t output_mask;
+
+static_assert(output_total_num <= 32, "ULOG_BUILD_EXTRA_OUTPUTS is above 31");
+
+typedef struct {
+    ulog_output_handler_fn handler;
+    void *arg;
+    ulog_level level;
+    ulog_lock_fn lock;  // Own lock, nullptr to run under the global lock
+    void *lock_arg;
+} output;
+
+typedef struct {
+    output outputs[output_total_num];  // order num = id. 0 is for stdout
+
+    // Dispatch masks, rebuilt by `output_dispatch_update` whenever an output
+    // changes, so an event finds its outputs with one load instead of a level
+    // compare per slot
+    output_mask present;                  // Outputs with a handler
+    output_mask below[ULOG_LEVEL_TOTAL];  // Outputs rejecting the level
+} output_data_t;
+
+static output_data_t output_instances[logger_total_num] = {{
+    .outputs = {{output_stdout_handler, nullptr, output_stdout_default_level,
+                 nullptr, nullptr}},
+    .present = 1 << ULOG_OUTPUT_STDOUT,
+}};
+#define output_data output_instances[logger_id()]
+
+static ulog_status output_lock(ulog_lock_fn lock, void *lock_arg) {
+    auto start  = stats_now_ns();
+    auto status = lock(true, lock_arg);
+    stats_lock_waited(start);
+    return status;
+}
+
+/// @brief Rebuilds the dispatch masks of the outputs and of every topic.
+/// Called with the global lock held after any output change.
+static void output_dispatch_update() {
+    output_mask below[ULOG_LEVEL_TOTAL] = {0};
+    output_mask present                 = 0;
+    for (auto i = 0; i < output_total_num; i++) {
+        if (output_data.outputs[i].handler == nullptr) {
+            continue;
+        }
+        present |= (output_mask)1 << i;
+        for (auto level = 0; level < ULOG_LEVEL_TOTAL; level++) {
+            if (!level_is_allowed(level, output_data.outputs[i].level)) {
+                below[level] |= (output_mask)1 << i;
+            }
+        }
+    }
+    output_data.present = present;
+    memcpy(output_data.below, below, sizeof(below));
+    topic_route_update_all();
+}
+
+/// @brief Outputs accepting the level; a forced call site passes any level
+static inline output_mask output_dispatch(ulog_level level, bool forced) {
+    if (forced) {
+        return output_data.present;
+    }
+    return output_data.present & ~output_data.below[level];
+}
+
+/// @return true if the output accepted the event
+static bool output_handle_single(ulog_event *ev, output *output) {
+    if (output->handler == nullptr) {
+        return false;  // Output has been removed, skip it
+    }
+
+    // Create event copy to avoid va_list issues
+    auto ev_copy = (ulog_event){0};
+    memcpy(&ev_copy, ev, sizeof(ulog_event));
+
+    // Initialize the va_list for the copied event
+    // Note: We use a copy of the va_list to avoid issues with passing it
+    // directly as on some platforms using the same va_list multiple times
+    // can lead to undefined behavior.
+    va_copy(ev_copy.message_format_args, ev->message_format_args);
+    auto bytes = stats_output_begin();
+    auto start = stats_now_ns();
+    output->handler(&ev_copy, output->arg);
+    stats_output_end((int)(output - output_data.outputs), bytes, start);
+    va_end(ev_copy.message_format_args);
+    return true;
+}
+
+/// @brief Handles the event with an output, under `lock` if it is set
+static bool output_run(ulog_event *ev, output *output, ulog_lock_fn lock,
+                       void *lock_arg) {
+    if (lock == nullptr) {
+        return output_handle_single(ev, output);
+    }
+    if (output_lock(lock, lock_arg) != ULOG_STATUS_OK) {
+        stats_dropped();
+        return false;
+    }
+    auto delivered = output_handle_single(ev, output);
+    (void)lock(false, lock_arg);
+    return delivered;
+}
+
+// Where the outputs of an event run. Taken once under the global lock, so an
+// output whose lock or queue changes meanwhile still gets the event once.
+typedef struct {
+    output_mask global;  // Run under the global lock
+    output_mask queued;  // Pushed to the output's queue
+    output_mask own;     // Run under the output's own lock
+    ulog_lock_fn locks[output_total_num];  // Own locks when the route was taken
+    void *lock_args[output_total_num];
+} output_route;
+
+/// @brief Splits the outputs by where they run. Called with the global lock
+/// held.
+/// @param outputs - Outputs that passed the level filters for this event
+static void output_route_take(output_route *route, output_mask outputs) {
+    route->global = 0;
+    route->queued = 0;
+    route->own    = 0;
+    for (auto i = 0; outputs != 0; i++, outputs >>= 1) {
+        if ((outputs & 1) == 0) {
+            continue;
+        }
+        auto bit  = (output_mask)1 << i;
+        auto slot = &output_data.outputs[i];
+        if (queue_is_on(i)) {
+            route->queued |= bit;
+        } else if (slot->lock != nullptr) {
+            route->own |= bit;
+            route->locks[i]     = slot->lock;
+            route->lock_args[i] = slot->lock_arg;
+        } else {
+            route->global |= bit;
+        }
+    }
+}
+
+/// @brief Handles the event with the outputs the route runs under the global
+/// lock. Called with it held.
+static bool output_handle(ulog_event *ev, const output_route *route) {
+    auto delivered = false;
+    auto outputs   = route->global;
+    for (auto i = 0; outputs != 0; i++, outputs >>= 1) {
+        if ((outputs & 1) != 0) {
+            delivered |= output_handle_single(ev, &output_data.outputs[i]);
+        }
+    }
+    return delivered;
+}
+
+/// @brief Handles the event with an output the way it runs now. Called with
+/// the global lock held.
+static bool output_handle_current(ulog_event *ev, ulog_output_id id) {
+    auto output = &output_data.outputs[id];
+    return queue_is_on(id) ? queue_push(id, ev)
+                           : output_run(ev, output, output->lock,
+                                        output->lock_arg);
+}
+
+/// @brief Takes the global lock again for the outputs the route runs under it.
+/// Outputs that got their own lock or a queue meanwhile are handled that way.
+static bool output_handle_relocked(ulog_event *ev, const output_route *route) {
+    auto outputs = route->global;
+    if (outputs == 0) {
+        return false;
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        stats_dropped();
+        return false;
+    }
+    auto delivered = false;
+    for (auto i = 0; outputs != 0; i++, outputs >>= 1) {
+        if ((outputs & 1) != 0) {
+            delivered |= output_handle_current(ev, i);
+        }
+    }
+    (void)lock_unlock();
+    return delivered;
+}
+
+/// @brief Delivers an event whose queue stopped after it was routed there, the
+/// way the output runs now
+static bool output_handle_unqueued(ulog_event *ev, ulog_output_id id) {
+    if (lock_lock() != ULOG_STATUS_OK) {
+        stats_dropped();
+        return false;
+    }
+    auto delivered = output_handle_current(ev, id);
+    (void)lock_unlock();
+    return delivered;
+}
+
+/// @brief Handles the event with the outputs the route runs outside the global
+/// lock. Called without it.
+static bool output_handle_detached(ulog_event *ev, const output_route *route) {
+    auto delivered = false;
+    auto outputs   = route->queued | route->own;
+    for (auto i = 0; outputs != 0; i++, outputs >>= 1) {
+        if ((outputs & 1) == 0) {
+            continue;
+        }
+        if ((route->own & ((output_mask)1 << i)) != 0) {
+            delivered |= output_run(ev, &output_data.outputs[i],
+                                    route->locks[i], route->lock_args[i]);
+        } else if (queue_push(i, ev)) {
+            delivered = true;
+        } else if (!queue_is_on(i)) {
+            delivered |= output_handle_unqueued(ev, i);
+        }
+    }
+    return delivered;
+}
+
+static void output_stdout_handler(ulog_event *ev, void *arg) {
+    (void)(arg);  // Unused
+    auto tgt =
+        (print_target){.type = PRINT_TARGET_STREAM, .dsc.stream = stdout};
+    log_print_event(&tgt, ev, false, true, true);
+}
+
+// Public
+// ================
+
+ulog_status ulog_output_level_set(ulog_output_id output, ulog_level level) {
+    if (!level_is_valid(level)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (output < ULOG_OUTPUT_STDOUT || output >= output_total_num) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    if (output_data.outputs[output].handler == nullptr) {
+        (void)lock_unlock();
+        return ULOG_STATUS_NOT_FOUND;  // Output exists but no handler assigned
+    }
+    output_data.outputs[output].level = level;
+    output_dispatch_update();
+    return lock_unlock();
+}
+
+ulog_status ulog_output_level_set_all(ulog_level level) {
+    if (!level_is_valid(level)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    for (auto i = 0; i < output_total_num; i++) {
+        output_data.outputs[i].level = level;
+    }
+    output_dispatch_update();
+    return lock_unlock();
+}
+
+ulog_status ulog_output_lock_set_fn(ulog_output_id output,
+                                    ulog_lock_fn function, void *lock_arg) {
+    if (output < ULOG_OUTPUT_STDOUT || output >= output_total_num) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    auto slot = &output_data.outputs[output];
+
+    // Wait for a call in progress under the previous lock
+    auto old_lock     = slot->lock;
+    auto old_lock_arg = slot->lock_arg;
+    if (old_lock != nullptr &&
+        output_lock(old_lock, old_lock_arg) != ULOG_STATUS_OK) {
+        (void)lock_unlock();
+        return ULOG_STATUS_BUSY;
+    }
+    slot->lock     = function;
+    slot->lock_arg = function != nullptr ? lock_arg : nullptr;
+    if (old_lock != nullptr) {
+        (void)old_lock(false, old_lock_arg);
+    }
+    return lock_unlock();
+}
+
+/* ============================================================================
+   Optional Feature: Extra Outputs
+   (`output_*` depends on: Outputs)
+============================================================================ */
+#if ULOG_HAS_EXTRA_OUTPUTS
+
+//  Private
+// ================
+static void output_file_handler(ulog_event *ev, void *arg) {
+    auto tgt =
+        (print_target){.type = PRINT_TARGET_STREAM, .dsc.stream = (FILE *)arg};
+    log_print_event(&tgt, ev, true, false, true);
+}
+
+// Public
+// ================
+
+ulog_output_id ulog_output_add(ulog_output_handler_fn handler, void *arg,
+                               ulog_level level) {
+    if (handler == nullptr || !level_is_valid(level)) {
+        return ULOG_OUTPUT_INVALID;
+    }
+
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_OUTPUT_INVALID;
+    }
+    for (auto i = 0; i < output_total_num; i++) {
+        if (output_data.outputs[i].handler == nullptr) {
+            output_data.outputs[i] =
+                (output){handler, arg, level, nullptr, nullptr};
+            output_dispatch_update();
+            stats_output_reset(i);
+            (void)lock_unlock();
+            return i;
+        }
+    }
+    (void)lock_unlock();
+    return ULOG_OUTPUT_INVALID;
+}
+
+/// @brief Add file handler
+ulog_output_id ulog_output_add_file(FILE *file, ulog_level level) {
+    if (file == nullptr) {
+        return ULOG_OUTPUT_INVALID;
+    }
+    return ulog_output_add(output_file_handler, file, level);
+}
+
+/// @brief Remove an output from the logging system
+ulog_status ulog_output_remove(ulog_output_id output) {
+    if (output < 0 || output >= output_total_num) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (output == ULOG_OUTPUT_STDOUT) {
+        return ULOG_STATUS_ERROR;  // Cannot remove stdout output
+    }
+
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    auto slot = &output_data.outputs[output];
+    if (slot->handler == nullptr) {
+        if (lock_unlock() != ULOG_STATUS_OK) {
+            return ULOG_STATUS_BUSY;
+        }
+        return ULOG_STATUS_NOT_FOUND;  // Output not found or already removed
+    }
+
+    // An isolated output hands its last events to the handler first
+    queue_stop(output);
+
+    // An output with its own lock may be running outside the global lock
+    auto own_lock     = slot->lock;
+    auto own_lock_arg = slot->lock_arg;
+    if (own_lock != nullptr &&
+        output_lock(own_lock, own_lock_arg) != ULOG_STATUS_OK) {
+        (void)lock_unlock();
+        return ULOG_STATUS_BUSY;
+    }
+
+    // Mark output as removed by setting handler to nullptr
+    slot->handler  = nullptr;
+    slot->arg      = nullptr;
+    slot->level    = output_stdout_default_level;
+    slot->lock     = nullptr;
+    slot->lock_arg = nullptr;
+    output_dispatch_update();
+
+    if (own_lock != nullptr) {
+        (void)own_lock(false, own_lock_arg);
+    }
+    return lock_unlock();
+}
+
+#else  // ULOG_HAS_EXTRA_OUTPUTS
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+
+ulog_output_id ulog_output_add(ulog_output_handler_fn handler, void *arg,
+                               ulog_level level) {
+    (void)(handler);
+    (void)(arg);
+    (void)(level);
+    warn_not_enabled("ULOG_BUILD_EXTRA_OUTPUTS");
+    return ULOG_OUTPUT_INVALID;
+}
+
+ulog_output_id ulog_output_add_file(FILE *file, ulog_level level) {
+    (void)(file);
+    (void)(level);
+    warn_not_enabled("ULOG_BUILD_EXTRA_OUTPUTS");
+    return ULOG_OUTPUT_INVALID;
+}
+
+ulog_status ulog_output_remove(ulog_output_id output) {
+    (void)(output);
+    warn_not_enabled("ULOG_BUILD_EXTRA_OUTPUTS");
+    return ULOG_STATUS_DISABLED;
+}
+
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+#endif  // ULOG_HAS_EXTRA_OUTPUTS
+
+/* ============================================================================
+   Optional Feature: Output Queue
+   (`queue_*`, depends on: Outputs, Events)
+============================================================================ */
+#if ULOG_HAS_OUTPUT_QUEUE
+#include <stdatomic.h>
+#include <stdint.h>
+#include <threads.h>
+#include <time.h>
+
+// Private
+// ================
+
+// Fields kept per queued event, the rest are dropped
+enum { queue_field_num = 16 };
+
+// A queued event. The message is rendered into `text` and the strings of the
+// fields, the topic name and the thread name are copied after it, so the slot
+// owns everything `ev` points to except the file.
+typedef struct {
+    ulog_event ev;
+    ulog_kv_field fields[queue_field_num];
+    char text[ULOG_BUILD_OUTPUT_QUEUE_SIZE];
+} queue_slot;
+
+typedef struct {
+    atomic_bool on;    // Events go to the queue, read without `mutex`
+    bool initialized;  // `mutex` and the conditions exist
+    bool running;      // The worker accepts events, cleared when it exits
+    bool stopping;     // The worker exits once the queue is empty
+    bool busy;         // The worker is running the handler
+    mtx_t mutex;
+    cnd_t ready;  // Signalled when an event is queued or on stop
+    cnd_t done;   // Signalled when the worker took or finished an event
+    thrd_t thread;
+
+    // The worker swaps the head slot with `spare`, so producers can fill the
+    // ring while it delivers an event
+    queue_slot *slots;  // `capacity` + 1 slots
+    queue_slot **ring;  // `capacity` slot pointers, oldest at `head`
+    queue_slot *spare;
+    size_t capacity;
+    size_t head;
+    size_t count;
+
+    ulog_queue_policy_config policy;  // Kept across restarts
+    ulog_queue_stats stats;  // Counters; capacity and depth are set on read
+} queue_t;
+
+typedef struct {
+    queue_t queues[output_total_num];  // Indexed by output ID
+} queue_data_t;
+
+static queue_data_t queue_instances[logger_total_num];
+#define queue_data queue_instances[logger_id()]
+
+static bool queue_is_on(ulog_output_id output) {
+    return atomic_load_explicit(&queue_data.queues[output].on,
+                                memory_order_acquire);
+}
+
+/// @brief Copies a string after `*pos` in the slot text, truncated to the
+/// space left
+static const char *queue_text_copy(queue_slot *slot, size_t *pos,
+                                   const char *str) {
+    if (str == nullptr) {
+        return nullptr;
+    }
+    auto room = sizeof(slot->text) - *pos;
+    if (room == 0) {
+        return "";
+    }
+    auto len = strlen(str);
+    len      = len < room ? len : room - 1;
+    auto out = slot->text + *pos;
+    memcpy(out, str, len);
+    out[len] = '\0';
+    *pos += len + 1;
+    return out;
+}
+
+/// @brief Copies the event into the slot
+static void queue_slot_fill(queue_slot *slot, ulog_event *ev) {
+    slot->ev      = *ev;
+    slot->text[0] = '\0';
+    if (!is_str_empty(ev->message)) {
+        auto tgt = (print_target){.type       = PRINT_TARGET_BUFFER,
+                                  .dsc.buffer = {slot->text, 0,
+                                                 sizeof(slot->text)}};
+        va_list args;
+        va_copy(args, ev->message_format_args);
+        print_to_target_cached_valist(&tgt, ev->format_cache, ev->message,
+                                      args);
+        va_end(args);
+        slot->ev.message = "%s";  // Delivered with `text` as the argument
+    }
+    slot->ev.format_cache = nullptr;
+#if ULOG_HAS_TIME
+    if (ev->time != nullptr) {
+        slot->ev.time = &slot->ev.time_storage;
+    }
+#endif
+
+    auto pos = strlen(slot->text) + 1;
+#if ULOG_HAS_TOPICS
+    // The logger's string, gone once `ulog_log` returns
+    slot->ev.topic_name = queue_text_copy(slot, &pos, ev->topic_name);
+#endif
+#if ULOG_HAS_THREAD_INFO
+    // The name lives in the logging thread, which may exit before delivery
+    slot->ev.thread_name = queue_text_copy(slot, &pos, ev->thread_name);
+#endif
+    // Context fields are flattened in: the thread may change them meanwhile
+    auto total = event_field_count(ev);
+    auto count = total < queue_field_num ? total : queue_field_num;
+    for (size_t i = 0; i < count; i++) {
+        auto field = *event_field(ev, i);
+        field.key  = queue_text_copy(slot, &pos, field.key);
+        if (field.type == ULOG_KV_STRING) {
+            field.value.s = queue_text_copy(slot, &pos, field.value.s);
+        }
+        slot->fields[i] = field;
+    }
+    slot->ev.fields      = slot->fields;
+    slot->ev.field_count = count;
+#if ULOG_HAS_CONTEXT
+    slot->ev.context_count = 0;
+#endif
+}
+
+/// @brief Passes a queued event to the handler; the message is the argument
+static bool queue_deliver(output *output, ulog_event *ev, ...) {
+    va_start(ev->message_format_args, ev);
+    auto delivered = output_run(ev, output, output->lock, output->lock_arg);
+    va_end(ev->message_format_args);
+    return delivered;
+}
+
+/// @param arg - Logger instance times `output_total_num` plus the output ID
+static int queue_worker(void *arg) {
+    auto key = (int)(intptr_t)arg;
+    auto id  = (ulog_output_id)(key % output_total_num);
+    logger_select(key / output_total_num);  // Deliver with the owner's state
+    auto q = &queue_data.queues[id];
+
+    (void)mtx_lock(&q->mutex);
+    while (true) {
+        while (q->count == 0 && !q->stopping) {
+            (void)cnd_wait(&q->ready, &q->mutex);
+        }
+        if (q->count == 0) {
+            q->running = false;  // Stopped and drained
+            (void)cnd_broadcast(&q->done);
+            break;
+        }
+        auto slot        = q->ring[q->head];
+        q->ring[q->head] = q->spare;
+        q->spare         = slot;
+        q->head          = (q->head + 1) % q->capacity;
+        q->count--;
+        q->busy = true;
+        (void)cnd_broadcast(&q->done);
+        (void)mtx_unlock(&q->mutex);
+
+        auto delivered =
+            queue_deliver(&output_data.outputs[id], &slot->ev, slot->text);
+
+        (void)mtx_lock(&q->mutex);
+        q->busy = false;
+        q->stats.delivered += delivered;
+        (void)cnd_broadcast(&q->done);
+    }
+    (void)mtx_unlock(&q->mutex);
+    return 0;
+}
+
+/// @brief Removes the `index`-th oldest queued event, freeing the tail slot
+static void queue_evict(queue_t *q, size_t index) {
+    auto capacity = q->capacity;
+    auto victim   = q->ring[(q->head + index) % capacity];
+    for (; index > 0; index--) {
+        q->ring[(q->head + index) % capacity] =
+            q->ring[(q->head + index - 1) % capacity];
+    }
+    q->ring[q->head] = victim;
+    q->head          = (q->head + 1) % capacity;
+    q->count--;
+}
+
+/// @brief Waits until the worker frees a slot
+/// @param deadline - Absolute TIME_UTC limit
+/// @return true if a slot is free
+static bool queue_wait(queue_t *q, const struct timespec *deadline) {
+    q->stats.blocked++;
+    while (q->running && q->count == q->capacity) {
+        if (cnd_timedwait(&q->done, &q->mutex, deadline) != thrd_success) {
+            break;  // Timed out
+        }
+    }
+    if (q->running && q->count == q->capacity) {
+        q->stats.timed_out++;
+        return false;
+    }
+    return q->running;
+}
+
+/// @brief Waits for a free slot at most `timeout_ms` milliseconds
+/// @return true if a slot is free
+static bool queue_wait_for(queue_t *q, uint32_t timeout_ms) {
+    struct timespec deadline;
+    (void)timespec_get(&deadline, TIME_UTC);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return queue_wait(q, &deadline);
+}
+
+/// @brief Frees a slot of a full queue as the policy says
+/// @return true if the new event can be queued
+static bool queue_make_room(queue_t *q, ulog_level level) {
+    auto config = q->policy;
+    switch (config.policy) {
+    case ULOG_QUEUE_DROP_OLDEST:
+        queue_evict(q, 0);
+        q->stats.dropped_oldest++;
+        return true;
+    case ULOG_QUEUE_BLOCK:
+        return queue_wait_for(q, config.timeout_ms);
+    case ULOG_QUEUE_DROP_BELOW:
+        if (!level_is_allowed(level, config.level)) {
+            q->stats.dropped_below++;
+            return false;
+        }
+        for (size_t i = 0; i < q->count; i++) {
+            auto queued = q->ring[(q->head + i) % q->capacity];
+            if (!level_is_allowed(queued->ev.level, config.level)) {
+                queue_evict(q, i);
+                q->stats.dropped_below++;
+                return true;
+            }
+        }
+        // Only kept levels are queued; a stalled worker must not hang them
+        return queue_wait_for(q, config.timeout_ms);
+    default:
+        q->stats.dropped_newest++;
+        return false;
+    }
+}
+
+/// @brief Queues the event for the output's worker
+/// @return true if the event was queued
+static bool queue_push(ulog_output_id output, ulog_event *ev) {
+    if (output_data.outputs[output].handler == nullptr) {
+        return false;
+    }
+    auto q = &queue_data.queues[output];
+    (void)mtx_lock(&q->mutex);
+    if (q->running && q->count == q->capacity &&
+        !queue_make_room(q, ev->level)) {
+        (void)mtx_unlock(&q->mutex);
+        return false;
+    }
+    if (!q->running) {
+        (void)mtx_unlock(&q->mutex);
+        return false;  // Stopped while the logger looked at it
+    }
+    queue_slot_fill(q->ring[(q->head + q->count) % q->capacity], ev);
+    q->count++;
+    q->stats.max_depth =
+        q->count > q->stats.max_depth ? q->count : q->stats.max_depth;
+    q->stats.enqueued++;
+    (void)cnd_signal(&q->ready);
+    (void)mtx_unlock(&q->mutex);
+    return true;
+}
+
+/// @brief Starts the worker of an output. Called with the global lock held.
+static ulog_status queue_start(ulog_output_id output, size_t capacity) {
+    auto q = &queue_data.queues[output];
+    if (!q->initialized) {
+        if (mtx_init(&q->mutex, mtx_plain) != thrd_success) {
+            return ULOG_STATUS_ERROR;
+        }
+        if (cnd_init(&q->ready) != thrd_success) {
+            mtx_destroy(&q->mutex);
+            return ULOG_STATUS_ERROR;
+        }
+        if (cnd_init(&q->done) != thrd_success) {
+            cnd_destroy(&q->ready);
+            mtx_destroy(&q->mutex);
+            return ULOG_STATUS_ERROR;
+        }
+        q->initialized = true;  // Kept for the lifetime of the process
+    }
+
+    auto slots = (queue_slot *)calloc(capacity + 1, sizeof(queue_slot));
+    auto ring  = (queue_slot **)malloc(capacity * sizeof(queue_slot *));
+    if (slots == nullptr || ring == nullptr) {
+        free(slots);
+        free(ring);
+        return ULOG_STATUS_ERROR;
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        ring[i] = &slots[i];
+    }
+
+    (void)mtx_lock(&q->mutex);
+    q->slots     = slots;
+    q->ring      = ring;
+    q->spare     = &slots[capacity];
+    q->capacity  = capacity;
+    q->head      = 0;
+    q->count     = 0;
+    q->stats     = (ulog_queue_stats){0};
+    q->stopping  = false;
+    q->running   = true;
+    auto key = logger_id() * output_total_num + output;
+    if (thrd_create(&q->thread, queue_worker, (void *)(intptr_t)key) !=
+        thrd_success) {
+        q->running = false;
+        (void)mtx_unlock(&q->mutex);
+        free(slots);
+        free(ring);
+        return ULOG_STATUS_ERROR;
+    }
+    (void)mtx_unlock(&q->mutex);
+    atomic_store_explicit(&q->on, true, memory_order_release);
+    return ULOG_STATUS_OK;
+}
+
+/// @brief Delivers the queued events and stops the worker of an output.
+/// Called with the global lock held.
+static void queue_stop(ulog_output_id output) {
+    auto q = &queue_data.queues[output];
+    if (!queue_is_on(output)) {
+        return;
+    }
+    (void)mtx_lock(&q->mutex);
+    q->stopping = true;
+    (void)cnd_signal(&q->ready);
+    (void)mtx_unlock(&q->mutex);
+    (void)thrd_join(q->thread, nullptr);
+
+    // The worker cleared `running`: loggers that saw the queue on deliver
+    // their event directly once they get the global lock
+    (void)mtx_lock(&q->mutex);
+    free(q->slots);
+    free(q->ring);
+    q->slots    = nullptr;
+    q->ring     = nullptr;
+    q->spare    = nullptr;
+    q->capacity = 0;
+    (void)mtx_unlock(&q->mutex);
+    atomic_store_explicit(&q->on, false, memory_order_release);
+}
+
+// Public
+// ================
+
+ulog_status ulog_output_isolate(ulog_output_id output, size_t capacity) {
+    if (output < ULOG_OUTPUT_STDOUT || output >= output_total_num) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    if (output_data.outputs[output].handler == nullptr) {
+        (void)lock_unlock();
+        return ULOG_STATUS_NOT_FOUND;
+    }
+    queue_stop(output);
+    auto status = ULOG_STATUS_OK;
+    if (capacity > 0) {
+        status = queue_start(output, capacity);
+    }
+    (void)lock_unlock();
+    return status;
+}
+
+ulog_status ulog_output_drain(ulog_output_id output) {
+    if (output < ULOG_OUTPUT_STDOUT || output >= output_total_num) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (!queue_is_on(output)) {
+        return ULOG_STATUS_NOT_FOUND;
+    }
+    auto q = &queue_data.queues[output];
+    (void)mtx_lock(&q->mutex);
+    while (q->running && (q->count > 0 || q->busy)) {
+        (void)cnd_wait(&q->done, &q->mutex);
+    }
+    (void)mtx_unlock(&q->mutex);
+    return ULOG_STATUS_OK;
+}
+
+ulog_status ulog_output_queue_get(ulog_output_id output,
+                                  ulog_queue_stats *out) {
+    if (output < ULOG_OUTPUT_STDOUT || output >= output_total_num ||
+        out == nullptr) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    *out = (ulog_queue_stats){0};
+    if (!queue_is_on(output)) {
+        return ULOG_STATUS_NOT_FOUND;
+    }
+    auto q = &queue_data.queues[output];
+    (void)mtx_lock(&q->mutex);
+    *out          = q->stats;
+    out->capacity = q->capacity;
+    out->depth    = q->count;
+    out->dropped  = out->dropped_newest + out->dropped_oldest +
+                   out->dropped_below + out->timed_out;
+    (void)mtx_unlock(&q->mutex);
+    return ULOG_STATUS_OK;
 }
 
-static void output_stdout_handler(ulog_event *ev, void *arg) {
-    (void)(arg);  // Unused
-    auto tgt =
-        (print_target){.type = PRINT_TARGET_STREAM, .dsc.stream = stdout};
-    log_print_event(&tgt, ev, false, true, true);
+ulog_status ulog_output_queue_policy_set(ulog_output_id output,
+                                         ulog_queue_policy_config config) {
+    if (output < ULOG_OUTPUT_STDOUT || output >= output_total_num ||
+        config.policy < ULOG_QUEUE_DROP_NEWEST ||
+        config.policy >= ULOG_QUEUE_POLICY_TOTAL ||
+        (config.policy == ULOG_QUEUE_DROP_BELOW &&
+         !level_is_valid(config.level))) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    auto q = &queue_data.queues[output];
+    if (q->initialized) {
+        (void)mtx_lock(&q->mutex);
+        q->policy = config;
+        (void)mtx_unlock(&q->mutex);
+    } else {
+        q->policy = config;
+    }
+    return lock_unlock();
+}
+
+#else  // ULOG_HAS_OUTPUT_QUEUE
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+
+ulog_status ulog_output_isolate(ulog_output_id output, size_t capacity) {
+    (void)(output);
+    (void)(capacity);
+    warn_not_enabled("ULOG_BUILD_OUTPUT_QUEUE_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_output_drain(ulog_output_id output) {
+    (void)(output);
+    warn_not_enabled("ULOG_BUILD_OUTPUT_QUEUE_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_output_queue_get(ulog_output_id output,
+                                  ulog_queue_stats *out) {
+    (void)(output);
+    (void)(out);
+    warn_not_enabled("ULOG_BUILD_OUTPUT_QUEUE_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_output_queue_policy_set(ulog_output_id output,
+                                         ulog_queue_policy_config config) {
+    (void)(output);
+    (void)(config);
+    warn_not_enabled("ULOG_BUILD_OUTPUT_QUEUE_SIZE");
+    return ULOG_STATUS_DISABLED;
+}
+
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+#endif  // ULOG_HAS_OUTPUT_QUEUE
+
+/* ============================================================================
+   Optional Feature: Dynamic Configuration - Topics
+   (`topic_config_*`, depends on: Config Snapshot)
+============================================================================ */
+#if ULOG_HAS_DYNAMIC_CONFIG
+
+// Private
+// ================
+
+static inline bool topic_config_is_enabled(const ulog_event *ev) {
+    return (ev->config & CONFIG_TOPICS) != 0;
+}
+
+// Public
+// ================
+
+ulog_status ulog_topic_config(bool enabled) {
+    return config_set(CONFIG_TOPICS, enabled);
+}
+
+#else  // ULOG_HAS_DYNAMIC_CONFIG
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+
+ulog_status ulog_topic_config(bool enabled) {
+    (void)(enabled);
+    warn_not_enabled("ULOG_BUILD_DYNAMIC_CONFIG");
+    return ULOG_STATUS_DISABLED;
+}
+
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define topic_config_is_enabled(ev) ((void)(ev), ULOG_HAS_TOPICS)
+#endif  // ULOG_HAS_DYNAMIC_CONFIG
+
+/* ============================================================================
+   Optional Feature: Topics
+   (`topic_*`, depends on: Topics Config, Print, Levels)
+============================================================================ */
+
+#if ULOG_HAS_TOPICS
+
+// Private
+// ================
+#ifndef ULOG_BUILD_TOPICS_STATIC_NUM
+/* If static count not provided, default to 0 */
+#define ULOG_BUILD_TOPICS_STATIC_NUM 0
+#endif
+
+/* Dynamic if mode equals DYNAMIC */
+#define TOPIC_IS_DYNAMIC                                                       \
+    (ULOG_BUILD_TOPICS_MODE == ULOG_BUILD_TOPICS_MODE_DYNAMIC)
+enum { topic_static_num = ULOG_BUILD_TOPICS_STATIC_NUM };
+static constexpr ulog_level topic_level_default = ULOG_LEVEL_TRACE;
+
+typedef struct topic_t {
+    ulog_topic_id id;
+    const char *name;
+    ulog_level level;      // Effective level: `own_level` or a matching rule
+    ulog_level own_level;  // Level given to the topic itself
+    ulog_output_id output;  // Output given to `ulog_topic_add`
+
+    // Routing matrix: the topic logs to each output in `routes` at and above
+    // that output's `route_level`. `topic_route_update` compiles it with the
+    // output levels into `dispatch`, so an event finds its outputs with one
+    // load.
+    output_mask routes;
+    ulog_level route_level[output_total_num];
+    output_mask dispatch[ULOG_LEVEL_TOTAL];
+
+#if ULOG_HAS_STATS
+    // Events that passed / were rejected by the topic level, updated without
+    // the configuration lock
+    stats_counter emitted[ULOG_LEVEL_TOTAL];
+    stats_counter filtered[ULOG_LEVEL_TOTAL];
+#endif
+
+#if TOPIC_IS_DYNAMIC
+    struct topic_t *next;  // Pointer to the next topic
+#endif
+
+} topic_t;
+
+enum {
+    topic_rule_num  = 16,  // Level rules kept at a time
+    topic_rule_size = 64,  // Longest rule pattern, terminator included
+};
+
+// A level rule for dotted topic names: `name` for one topic, `prefix.*` for
+// every topic below `prefix`, `*` for every topic. Rules are resolved into
+// `topic_t.level` when a topic is added or the rules change, so logging still
+// compares a single level.
+typedef struct {
+    char pattern[topic_rule_size];  // Empty if the slot is free
+    ulog_level level;
+} topic_rule_t;
+
+typedef struct {
+    bool new_topic_enabled;  // Whether new topics are enabled by default
+    topic_rule_t rules[topic_rule_num];
+
+#if TOPIC_IS_DYNAMIC
+    topic_t *topics;
+#else
+    topic_t topics[topic_static_num];
+#endif
+
+} topic_data_t;
+
+static topic_data_t topic_instances[logger_total_num] = {{
+    .new_topic_enabled = false,  // New topics are disabled by default
+
+#if TOPIC_IS_DYNAMIC
+    .topics = nullptr,  // No topics allocated by default
+#else
+    .topics = {{0}},  // Initialize static topics array to zero
+#endif
+}};
+#define topic_data topic_instances[logger_id()]
+
+// === Implementation specific functions for topics ===========================
+
+/// @brief Converts a topic string to its ID
+/// @param str - Topic string
+/// @return Topic ID or ULOG_TOPIC_ID_INVALID if not found
+static ulog_topic_id topic_str_to_id(const char *str);
+
+/// @brief Gets the topic by ID
+/// @param topic - Topic ID
+/// @return Pointer to the topic if found, nullptr otherwise
+static topic_t *topic_get(ulog_topic_id topic);
+
+/// @brief Add a new topic
+/// @param topic_name - Topic name
+/// @param output - Output id
+static ulog_topic_id topic_add(const char *topic_name, ulog_output_id output);
+
+/// @brief Remove a topic by name
+/// @param topic_name - Topic name
+/// @return ulog_status
+static ulog_status topic_remove(const char *topic_name);
+
+/// @brief Iterates the topics
+/// @param t - Current topic, nullptr to start
+/// @return The next topic, nullptr after the last one
+static topic_t *topic_next(topic_t *t);
+
+// === Common Topic Functions =================================================
+
+static void topic_print(print_target *tgt, ulog_event *ev) {
+    if (!topic_config_is_enabled(ev)) {
+        return;  // Topics are disabled, do nothing
+    }
+
+    if (ev->topic_name != nullptr) {
+        print_to_target(tgt, "[%s] ", ev->topic_name);
+    }
+}
+
+/// @brief Only `*` or a trailing `.*` may be a wildcard
+static bool topic_rule_is_valid(const char *pattern) {
+    auto size = strlen(pattern);
+    if (size == 0 || size >= topic_rule_size) {
+        return false;
+    }
+    auto star = strchr(pattern, '*');
+    return star == nullptr ||
+           (star == pattern + size - 1 && (size == 1 || star[-1] == '.'));
+}
+
+/// @brief How specifically a rule matches a topic name
+/// @return 0 if it does not match; an exact name scores above any wildcard
+/// and a longer prefix above a shorter one
+static size_t topic_rule_score(const char *pattern, const char *name) {
+    auto size = strlen(pattern);
+    if (pattern[size - 1] != '*') {
+        return strcmp(pattern, name) == 0 ? SIZE_MAX : 0;
+    }
+    auto prefix = size - 1;  // "net." of "net.*", nothing of "*"
+    if (strncmp(pattern, name, prefix) != 0 || name[prefix] == '\0') {
+        return 0;
+    }
+    return prefix + 1;
+}
+
+/// @brief Level of the most specific rule matching `name`, `level` if none
+static ulog_level topic_rule_level(const char *name, ulog_level level) {
+    size_t best = 0;
+    for (auto i = 0; i < topic_rule_num; i++) {
+        auto rule = &topic_data.rules[i];
+        if (rule->pattern[0] == '\0') {
+            continue;  // Free slot
+        }
+        auto score = topic_rule_score(rule->pattern, name);
+        if (score > best) {
+            best  = score;
+            level = rule->level;
+        }
+    }
+    return level;
+}
+
+/// @brief Recomputes the effective level of the topic
+static void topic_resolve(topic_t *t) {
+    t->level = topic_rule_level(t->name, t->own_level);
+}
+
+static void topic_resolve_all() {
+    for (auto t = topic_next(nullptr); t != nullptr; t = topic_next(t)) {
+        topic_resolve(t);
+    }
+}
+
+/// @brief Slot of the rule with this pattern, or a free slot if there is none
+static topic_rule_t *topic_rule_find(const char *pattern, bool or_free) {
+    topic_rule_t *free_slot = nullptr;
+    for (auto i = 0; i < topic_rule_num; i++) {
+        auto rule = &topic_data.rules[i];
+        if (strcmp(rule->pattern, pattern) == 0) {
+            return rule;
+        }
+        if (free_slot == nullptr && rule->pattern[0] == '\0') {
+            free_slot = rule;
+        }
+    }
+    return or_free ? free_slot : nullptr;
+}
+
+/// @brief Rebuilds the `[level] -> outputs` table of the topic
+static void topic_route_update(topic_t *t) {
+    for (auto level = 0; level < ULOG_LEVEL_TOTAL; level++) {
+        output_mask allowed = 0;
+        for (auto i = 0; i < output_total_num; i++) {
+            if (level_is_allowed(level, t->route_level[i])) {
+                allowed |= (output_mask)1 << i;
+            }
+        }
+        t->dispatch[level] =
+            t->routes & allowed & output_dispatch(level, false);
+    }
+}
+
+static void topic_route_update_all() {
+    for (auto t = topic_next(nullptr); t != nullptr; t = topic_next(t)) {
+        topic_route_update(t);
+    }
+}
+
+/// @brief Outputs addressed by an output ID, every output for
+/// ULOG_OUTPUT_ALL, none for an invalid ID
+static output_mask topic_route_mask(ulog_output_id output) {
+    if (output == ULOG_OUTPUT_ALL) {
+        return (output_mask)((1ULL << output_total_num) - 1);
+    }
+    if (output >= 0 && output < output_total_num) {
+        return (output_mask)1 << output;
+    }
+    return 0;
+}
+
+/// @brief Routes a new topic to `output` with no route level of its own
+static void topic_route_init(topic_t *t, ulog_output_id output) {
+    t->output = output;
+    t->routes = topic_route_mask(output);
+    for (auto i = 0; i < output_total_num; i++) {
+        t->route_level[i] = level_min_value;
+    }
+    topic_route_update(t);
+}
+
+/// @brief Sets the topic level
+/// @param topic - Topic ID
+/// @param level - Log level to set
+/// @return ULOG_STATUS_OK if success, ULOG_STATUS_NOT_FOUND if topic not found
+static ulog_status topic_set_level(int topic, ulog_level level) {
+    if (!level_is_valid(level)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    auto t = topic_get(topic);
+    if (t != nullptr) {
+        t->own_level = level;
+        topic_resolve(t);
+        return ULOG_STATUS_OK;
+    }
+    return ULOG_STATUS_NOT_FOUND;
+}
+
+/// @brief Checks if the topic is loggable
+/// @param t - Pointer to the topic, nullptr is allowed
+/// @param level - Log level to check against
+/// @param forced - Logged by a forced call site, any level passes
+/// @return true if loggable, false otherwise
+static bool topic_is_loggable(topic_t *t, ulog_level level, bool forced) {
+    if (t == nullptr) {
+        return false;  // Topic not found, cannot log
+    }
+    if (!forced && !level_is_allowed(level, t->level)) {
+        return false;  // Topic is disabled, cannot log
+    }
+    return true;
+}
+
+#if ULOG_HAS_STATS
+static inline void topic_count(topic_t *t, ulog_level level, bool allowed) {
+    if (t != nullptr) {
+        stats_add(allowed ? &t->emitted[level] : &t->filtered[level], 1);
+    }
+}
+
+static void topic_read_counters(topic_t *t, ulog_topic_info *info) {
+    for (auto i = 0; i < ULOG_LEVEL_TOTAL; i++) {
+        info->emitted[i]  = stats_load(&t->emitted[i]);
+        info->filtered[i] = stats_load(&t->filtered[i]);
+    }
+}
+#else
+#define topic_count(t, level, allowed)                                         \
+    ((void)(t), (void)(level), (void)(allowed))
+#define topic_read_counters(t, info) ((void)(t), (void)(info))
+#endif  // ULOG_HAS_STATS
+
+/// @brief Processes the topic
+/// @param topic - Topic name
+/// @param level - Log level
+/// @param forced - Logged by a forced call site, any level passes
+/// @param is_log_allowed - (Output) log allowed
+/// @param topic_id - (Output) topic ID
+/// @param outputs - (Output) outputs the topic routes the event to
+static void topic_process(const char *topic, ulog_level level, bool forced,
+                          bool *is_log_allowed, int *topic_id,
+                          output_mask *outputs) {
+    if (is_log_allowed == nullptr || topic_id == nullptr || outputs == nullptr) {
+        return;  // Invalid arguments, do nothing
+    }
+
+    auto t = topic_get(topic_str_to_id(topic));
+
+    *is_log_allowed = topic_is_loggable(t, level, forced);
+    topic_count(t, level, *is_log_allowed);
+    if (!*is_log_allowed) {
+        return;  // Topic is not loggable, stop processing
+    }
+    *topic_id = t->id;  // Set topic ID
+    *outputs  = forced ? t->routes & output_dispatch(level, true)
+                       : t->dispatch[level];
 }
 
 // Public
 // ================
 
-ulog_status ulog_output_level_set(ulog_output_id output, ulog_level level) {
-    if (!level_is_valid(level)) {
+ulog_status ulog_topic_level_set(const char *topic_name, ulog_level level) {
+    if (is_str_empty(topic_name)) {
         return ULOG_STATUS_INVALID_ARGUMENT;
     }
-    if (output < ULOG_OUTPUT_STDOUT || output >= output_total_num) {
+    auto topic_id = ulog_topic_get_id(topic_name);
+    if (topic_id == ULOG_TOPIC_ID_INVALID) {
+        return ULOG_STATUS_NOT_FOUND;  // Topic not found, do nothing
+    }
+    return topic_set_level(topic_id, level);
+}
+
+ulog_topic_id ulog_topic_get_id(const char *topic_name) {
+    if (is_str_empty(topic_name)) {
+        return ULOG_TOPIC_ID_INVALID;
+    }
+    return topic_str_to_id(topic_name);
+}
+
+ulog_topic_id ulog_topic_add(const char *topic_name, ulog_output_id output,
+                             ulog_level level) {
+    if (is_str_empty(topic_name)) {
+        return ULOG_TOPIC_ID_INVALID;  // Invalid topic name, do nothing
+    }
+    auto id = topic_add(topic_name, output);
+    if (id != ULOG_TOPIC_ID_INVALID) {
+        topic_set_level(id, level);
+    }
+    return id;
+}
+
+ulog_status ulog_topic_remove(const char *topic_name) {
+    if (is_str_empty(topic_name)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;  // Invalid topic name, do nothing
+    }
+    return topic_remove(topic_name);
+}
+
+ulog_status ulog_topic_foreach(ulog_topic_visit_fn visit, void *arg) {
+    if (visit == nullptr) {
         return ULOG_STATUS_INVALID_ARGUMENT;
     }
+    if (lock_lock() != ULOG_STATUS_OK) {  // Topics must not change meanwhile
+        return ULOG_STATUS_BUSY;
+    }
+    for (auto t = topic_next(nullptr); t != nullptr; t = topic_next(t)) {
+        auto info = (ulog_topic_info){
+            .id     = t->id,
+            .name   = t->name,
+            .level  = t->level,
+            .output = t->output,
+            .routes = t->routes,
+        };
+        topic_read_counters(t, &info);
+        visit(&info, arg);
+    }
+    return lock_unlock();
+}
 
-    if (output_data.outputs[output].handler == nullptr) {
-        return ULOG_STATUS_NOT_FOUND;  // Output exists but no handler assigned
+ulog_status ulog_topic_rule_set(const char *pattern, ulog_level level) {
+    if (pattern == nullptr || !topic_rule_is_valid(pattern) ||
+        !level_is_valid(level)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
     }
-    output_data.outputs[output].level = level;
-    return ULOG_STATUS_OK;
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    auto rule = topic_rule_find(pattern, true);
+    if (rule == nullptr) {
+        (void)lock_unlock();
+        return ULOG_STATUS_ERROR;  // Rule table full
+    }
+    memcpy(rule->pattern, pattern, strlen(pattern) + 1);
+    rule->level = level;
+    topic_resolve_all();
+    return lock_unlock();
 }
 
-ulog_status ulog_output_level_set_all(ulog_level level) {
-    if (!level_is_valid(level)) {
+ulog_status ulog_topic_rule_remove(const char *pattern) {
+    if (is_str_empty(pattern)) {
         return ULOG_STATUS_INVALID_ARGUMENT;
     }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    auto rule = topic_rule_find(pattern, false);
+    if (rule == nullptr) {
+        (void)lock_unlock();
+        return ULOG_STATUS_NOT_FOUND;
+    }
+    *rule = (topic_rule_t){0};
+    topic_resolve_all();
+    return lock_unlock();
+}
 
+ulog_status ulog_topic_route_set(const char *topic_name, ulog_output_id output,
+                                 ulog_level level) {
+    auto routes = topic_route_mask(output);
+    if (is_str_empty(topic_name) || routes == 0 || !level_is_valid(level)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    auto t = topic_get(topic_str_to_id(topic_name));
+    if (t == nullptr) {
+        (void)lock_unlock();
+        return ULOG_STATUS_NOT_FOUND;
+    }
     for (auto i = 0; i < output_total_num; i++) {
-        output_data.outputs[i].level = level;
+        if ((routes >> i & 1) != 0) {
+            t->route_level[i] = level;
+        }
     }
-    return ULOG_STATUS_OK;
+    t->routes |= routes;
+    topic_route_update(t);
+    return lock_unlock();
+}
+
+ulog_status ulog_topic_route_remove(const char *topic_name,
+                                    ulog_output_id output) {
+    auto routes = topic_route_mask(output);
+    if (is_str_empty(topic_name) || routes == 0) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {
+        return ULOG_STATUS_BUSY;
+    }
+    auto t = topic_get(topic_str_to_id(topic_name));
+    if (t == nullptr) {
+        (void)lock_unlock();
+        return ULOG_STATUS_NOT_FOUND;
+    }
+    t->routes &= ~routes;
+    topic_route_update(t);
+    return lock_unlock();
+}
+
+#else  // ULOG_HAS_TOPICS
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+
+ulog_status ulog_topic_level_set(const char *topic_name, ulog_level level) {
+    (void)(topic_name);
+    (void)(level);
+    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_topic_id ulog_topic_get_id(const char *topic_name) {
+    (void)(topic_name);
+    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
+    return ULOG_TOPIC_ID_INVALID;
+}
+
+ulog_topic_id ulog_topic_add(const char *topic_name, ulog_output_id output,
+                             ulog_level level) {
+    (void)(topic_name);
+    (void)(output);
+    (void)(level);
+    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
+    return ULOG_TOPIC_ID_INVALID;
+}
+
+ulog_status ulog_topic_remove(const char *topic_name) {
+    (void)(topic_name);
+    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_topic_foreach(ulog_topic_visit_fn visit, void *arg) {
+    (void)(visit);
+    (void)(arg);
+    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_topic_rule_set(const char *pattern, ulog_level level) {
+    (void)(pattern);
+    (void)(level);
+    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_topic_rule_remove(const char *pattern) {
+    (void)(pattern);
+    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_topic_route_set(const char *topic_name, ulog_output_id output,
+                                 ulog_level level) {
+    (void)(topic_name);
+    (void)(output);
+    (void)(level);
+    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_status ulog_topic_route_remove(const char *topic_name,
+                                    ulog_output_id output) {
+    (void)(topic_name);
+    (void)(output);
+    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
+    return ULOG_STATUS_DISABLED;
 }
 
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Disabled Private
+// ================
+
+#define topic_print(tgt, ev) (void)(tgt), (void)(ev)
+#define topic_process(topic, level, forced, is_log_allowed, topic_id,         \
+                      outputs)                                                 \
+    (void)(topic), (void)(level), (void)(forced), (void)(is_log_allowed),      \
+        (void)(topic_id), (void)(outputs)
+
+#endif  // ULOG_HAS_TOPICS
+
 /* ============================================================================
-   Optional Feature: Extra Outputs
-   (`output_*` depends on: Outputs)
+   Optional Feature: Topics - Static Allocation
+   (`topic_*`, depends on: Topics)
 ============================================================================ */
-#if ULOG_HAS_EXTRA_OUTPUTS
+#if ULOG_HAS_TOPICS && TOPIC_IS_DYNAMIC == false
+// Private
+// ================
+
+ulog_topic_id topic_str_to_id(const char *str) {
+    if (is_str_empty(str)) {
+        return ULOG_TOPIC_ID_INVALID;
+    }
+    for (auto i = 0; i < topic_static_num; i++) {
+        if (is_str_empty(topic_data.topics[i].name)) {
+            continue;  // Skip empty slot; continue searching
+        }
+        if (strcmp(topic_data.topics[i].name, str) == 0) {
+            return topic_data.topics[i].id;
+        }
+    }
+    return ULOG_TOPIC_ID_INVALID;  // Not found
+}
+
+static topic_t *topic_get(ulog_topic_id topic) {
+    if (topic < topic_static_num && topic >= 0) {
+        return &topic_data.topics[topic];
+    }
+    return nullptr;
+}
+
+static topic_t *topic_next(topic_t *t) {
+    auto i = t == nullptr ? 0 : (t - topic_data.topics) + 1;
+    for (; i < topic_static_num; i++) {
+        if (!is_str_empty(topic_data.topics[i].name)) {
+            return &topic_data.topics[i];
+        }
+    }
+    return nullptr;
+}
+
+static ulog_topic_id topic_add(const char *topic_name, ulog_output_id output) {
+    if (is_str_empty(topic_name)) {
+        return ULOG_TOPIC_ID_INVALID;
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {  // Lock the configuration
+        return ULOG_TOPIC_ID_INVALID;
+    }
+    for (auto i = 0; i < topic_static_num; i++) {
+        // If there is an empty slot
+        if (is_str_empty(topic_data.topics[i].name)) {
+            topic_data.topics[i].id        = i;
+            topic_data.topics[i].name      = topic_name;
+            topic_data.topics[i].own_level = topic_level_default;
+            topic_resolve(&topic_data.topics[i]);
+            topic_route_init(&topic_data.topics[i], output);
+            (void)lock_unlock();  // Unlock the configuration
+            return i;
+        }
+        // If the topic already exists
+        else if (strcmp(topic_data.topics[i].name, topic_name) == 0) {
+            (void)lock_unlock();  // Unlock the configuration
+            return i;
+        }
+    }
+    (void)lock_unlock();           // Unlock the configuration
+    return ULOG_TOPIC_ID_INVALID;  // No space for new topics
+}
+
+static ulog_status topic_remove(const char *topic_name) {
+    if (is_str_empty(topic_name)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;  // Invalid topic name, do nothing
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {  // Lock the configuration
+        return ULOG_STATUS_BUSY;
+    }
+    for (auto i = 0; i < topic_static_num; i++) {
+        if (is_str_empty(topic_data.topics[i].name)) {
+            continue;  // Skip empty slot; continue search
+        }
+        if (strcmp(topic_data.topics[i].name, topic_name) == 0) {
+            // Clear the topic entry
+            topic_data.topics[i] = (topic_t){0};
+            return lock_unlock();
+        }
+    }
+    if (lock_unlock() != ULOG_STATUS_OK) {  // Unlock the configuration
+        return ULOG_STATUS_BUSY;
+    }
+    return ULOG_STATUS_NOT_FOUND;  // Topic not found
+}
+#endif  // ULOG_HAS_TOPICS && TOPIC_IS_DYNAMIC == false
+
+/* ============================================================================
+   Optional Feature: Topics - Dynamic Allocation
+   (`topic_*`, depends on: Topics)
+============================================================================ */
+
+#if ULOG_HAS_TOPICS && TOPIC_IS_DYNAMIC == true
+// Private
+// ================
+
+static topic_t *topic_get_first() {
+    return topic_data.topics;
+}
+
+static topic_t *topic_get_next(topic_t *t) {
+    return t->next;
+}
 
-//  Private
-// ================
-static void output_file_handler(ulog_event *ev, void *arg) {
-    auto tgt =
-        (print_target){.type = PRINT_TARGET_STREAM, .dsc.stream = (FILE *)arg};
-    log_print_event(&tgt, ev, true, false, true);
+static topic_t *topic_next(topic_t *t) {
+    return t == nullptr ? topic_get_first() : topic_get_next(t);
 }
 
-// Public
-// ================
+static topic_t *topic_get_last() {
+    auto last = topic_data.topics;
+    if (last == nullptr) {
+        return nullptr;  // No topics
+    }
+    while (last->next != nullptr) {
+        last = last->next;
+    }
+    return last;
+}
 
-ulog_output_id ulog_output_add(ulog_output_handler_fn handler, void *arg,
-                               ulog_level level) {
-    if (handler == nullptr || !level_is_valid(level)) {
-        return ULOG_OUTPUT_INVALID;
+ulog_topic_id topic_str_to_id(const char *str) {
+    if (is_str_empty(str)) {
+        return ULOG_TOPIC_ID_INVALID;
+    }
+    for (auto t = topic_get_first(); t != nullptr; t = topic_get_next(t)) {
+        if (!is_str_empty(t->name) && strcmp(t->name, str) == 0) {
+            return t->id;
+        }
     }
+    return ULOG_TOPIC_ID_INVALID;
+}
 
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_OUTPUT_INVALID;
+static topic_t *topic_get(int topic) {
+    if (topic < 0) {
+        return nullptr;  // Invalid topic ID
     }
-    for (auto i = 0; i < output_total_num; i++) {
-        if (output_data.outputs[i].handler == nullptr) {
-            output_data.outputs[i] = (output){handler, arg, level};
-            (void)lock_unlock();
-            return i;
+    for (auto t = topic_get_first(); t != nullptr; t = topic_get_next(t)) {
+        if (t->id == topic) {
+            return t;
         }
     }
-    (void)lock_unlock();
-    return ULOG_OUTPUT_INVALID;
+    return nullptr;
 }
 
-/// @brief Add file handler
-ulog_output_id ulog_output_add_file(FILE *file, ulog_level level) {
-    if (file == nullptr) {
-        return ULOG_OUTPUT_INVALID;
+static topic_t *topic_allocate(int id, const char *topic_name,
+                               ulog_output_id output) {
+    if (is_str_empty(topic_name)) {
+        return nullptr;  // Invalid topic name, do not allocate
     }
-    return ulog_output_add(output_file_handler, file, level);
+    if (id < 0) {
+        return nullptr;  // Invalid ID, do not allocate
+    }
+    // One allocation holds the topic and a copy of its name right after it
+    auto name_len = strlen(topic_name) + 1;
+    auto t        = (topic_t *)calloc(1, sizeof(topic_t) + name_len);
+    if (t != nullptr) {
+        auto name_copy = (char *)(t + 1);
+        memcpy(name_copy, topic_name, name_len);
+
+        t->id        = id;
+        t->name      = name_copy;
+        t->own_level = topic_level_default;
+        t->next      = nullptr;
+        topic_resolve(t);
+        topic_route_init(t, output);
+    }
+    return t;
 }
 
-/// @brief Remove an output from the logging system
-ulog_status ulog_output_remove(ulog_output_id output) {
-    if (output < 0 || output >= output_total_num) {
-        return ULOG_STATUS_INVALID_ARGUMENT;
+static ulog_topic_id topic_add(const char *topic_name, ulog_output_id output) {
+    if (is_str_empty(topic_name)) {
+        return ULOG_TOPIC_ID_INVALID;
     }
 
-    if (output == ULOG_OUTPUT_STDOUT) {
-        return ULOG_STATUS_ERROR;  // Cannot remove stdout output
+    // if exists
+    for (auto t = topic_get_first(); t != nullptr; t = topic_get_next(t)) {
+        if (!is_str_empty(t->name) && strcmp(t->name, topic_name) == 0) {
+            return t->id;
+        }
     }
 
+    // If the beginning is empty
     if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;
+        return ULOG_TOPIC_ID_INVALID;
     }
-    if (output_data.outputs[output].handler == nullptr) {
-        if (lock_unlock() != ULOG_STATUS_OK) {
-            return ULOG_STATUS_BUSY;
+    auto t = topic_get_last();
+    if (t == nullptr) {
+        topic_data.topics = topic_allocate(0, topic_name, output);
+        if (topic_data.topics != nullptr) {
+            (void)lock_unlock();
+            return 0;
         }
-        return ULOG_STATUS_NOT_FOUND;  // Output not found or already removed
+        (void)lock_unlock();
+        return ULOG_TOPIC_ID_INVALID;
     }
 
-    // Mark output as removed by setting handler to nullptr
-    output_data.outputs[output].handler = nullptr;
-    output_data.outputs[output].arg     = nullptr;
-    output_data.outputs[output].level   = output_stdout_default_level;
-
-    return lock_unlock();
+    // If the beginning is not empty
+    t->next = topic_allocate(t->id + 1, topic_name, output);
+    if (t->next) {
+        (void)lock_unlock();
+        return t->id + 1;
+    }
+    (void)lock_unlock();
+    return ULOG_TOPIC_ID_INVALID;
 }
 
-#else  // ULOG_HAS_EXTRA_OUTPUTS
-
-// Disabled Public
-// ================
-
-#if ULOG_HAS_WARN_NOT_ENABLED
+static ulog_status topic_remove(const char *topic_name) {
+    if (is_str_empty(topic_name)) {
+        return ULOG_STATUS_INVALID_ARGUMENT;  // Invalid topic name, do nothing
+    }
+    if (lock_lock() != ULOG_STATUS_OK) {  // Lock the configuration
+        return ULOG_STATUS_BUSY;
+    }
 
-ulog_output_id ulog_output_add(ulog_output_handler_fn handler, void *arg,
-                               ulog_level level) {
-    (void)(handler);
-    (void)(arg);
-    (void)(level);
-    warn_not_enabled("ULOG_BUILD_EXTRA_OUTPUTS");
-    return ULOG_OUTPUT_INVALID;
-}
+    auto t          = topic_get_first();
+    topic_t *t_prev = nullptr;
 
-ulog_output_id ulog_output_add_file(FILE *file, ulog_level level) {
-    (void)(file);
-    (void)(level);
-    warn_not_enabled("ULOG_BUILD_EXTRA_OUTPUTS");
-    return ULOG_OUTPUT_INVALID;
-}
+    while (t != nullptr) {
+        if (!is_str_empty(t->name) && strcmp(t->name, topic_name) == 0) {
+            // Found the topic to remove
+            if (t_prev == nullptr) {
+                // Removing the first topic
+                topic_data.topics = t->next;
+            } else {
+                t_prev->next = t->next;
+            }
+            free(t);  // The name is stored in the same allocation
+            return lock_unlock();
+        }
+        t_prev = t;
+        t      = t->next;
+    }
 
-ulog_status ulog_output_remove(ulog_output_id output) {
-    (void)(output);
-    warn_not_enabled("ULOG_BUILD_EXTRA_OUTPUTS");
-    return ULOG_STATUS_DISABLED;
+    if (lock_unlock() != ULOG_STATUS_OK) {  // Unlock the configuration
+        return ULOG_STATUS_BUSY;
+    }
+    return ULOG_STATUS_NOT_FOUND;  // Topic not found
 }
 
-#endif  // ULOG_HAS_WARN_NOT_ENABLED
-
-#endif  // ULOG_HAS_EXTRA_OUTPUTS
+#endif  // ULOG_HAS_TOPICS && TOPIC_IS_DYNAMIC == true
 
 /* ============================================================================
-   Optional Feature: Dynamic Configuration - Topics
-   (`topic_config_*`, depends on: - )
+   Optional Feature: Dynamic Configuration - Source Location
+   (`src_loc_config_*`, depends on: Config Snapshot)
 ============================================================================ */
 #if ULOG_HAS_DYNAMIC_CONFIG
 
-typedef struct {
-    bool enabled;
-} topic_config;
-
-static topic_config topic_cfg = {
-    .enabled = (bool)ULOG_HAS_TOPICS,
-};
-
 // Private
 // ================
 
-bool topic_config_is_enabled() {
-    return topic_cfg.enabled;
+static inline bool src_loc_config_is_enabled(const ulog_event *ev) {
+    return (ev->config & CONFIG_SOURCE_LOCATION) != 0;
 }
 
 // Public
 // ================
 
-ulog_status ulog_topic_config(bool enabled) {
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;
-    }
-    topic_cfg.enabled = enabled;
-    return lock_unlock();
+ulog_status ulog_source_location_config(bool enabled) {
+    return config_set(CONFIG_SOURCE_LOCATION, enabled);
 }
 
 #else  // ULOG_HAS_DYNAMIC_CONFIG
@@ -1173,9 +5504,9 @@ ulog_status ulog_topic_config(bool enabled) {
 
 #if ULOG_HAS_WARN_NOT_ENABLED
 
-ulog_status ulog_topic_config(bool enabled) {
+ulog_status ulog_source_location_config(bool enabled) {
     (void)(enabled);
-    warn_not_enabled("ULOG_BUILD_DYNAMIC_CONFIG");
+    warn_not_enabled("ULOG_BUILD_SOURCE_LOCATION");
     return ULOG_STATUS_DISABLED;
 }
 
@@ -1184,523 +5515,897 @@ ulog_status ulog_topic_config(bool enabled) {
 // Disabled Private
 // ================
 
-#define topic_config_is_enabled() (ULOG_HAS_TOPICS)
+#define src_loc_config_is_enabled(ev) ((void)(ev), ULOG_HAS_SOURCE_LOCATION)
 #endif  // ULOG_HAS_DYNAMIC_CONFIG
 
 /* ============================================================================
-   Optional Feature: Topics
-   (`topic_*`, depends on: Topics Config, Print, Levels)
+   Optional Feature: JSON Output
+   (`json_*`, depends on: Extra Outputs, Fields, Levels, Topics, Time,
+                          Source Location)
 ============================================================================ */
+#if ULOG_HAS_JSON_OUTPUT
 
-#if ULOG_HAS_TOPICS
-
-// Private
-// ================
-#ifndef ULOG_BUILD_TOPICS_STATIC_NUM
-/* If static count not provided, default to 0 */
-#define ULOG_BUILD_TOPICS_STATIC_NUM 0
-#endif
-
-/* Dynamic if mode equals DYNAMIC */
-#define TOPIC_IS_DYNAMIC                                                       \
-    (ULOG_BUILD_TOPICS_MODE == ULOG_BUILD_TOPICS_MODE_DYNAMIC)
-enum { topic_static_num = ULOG_BUILD_TOPICS_STATIC_NUM };
-static constexpr ulog_level topic_level_default = ULOG_LEVEL_TRACE;
-
-typedef struct topic_t {
-    ulog_topic_id id;
-    const char *name;
-    ulog_level level;
-    ulog_output_id output;
-
-#if TOPIC_IS_DYNAMIC
-    struct topic_t *next;  // Pointer to the next topic
-#endif
-
-} topic_t;
-
-typedef struct {
-    bool new_topic_enabled;  // Whether new topics are enabled by default
+#include <math.h>
 
-#if TOPIC_IS_DYNAMIC
-    topic_t *topics;
-#else
-    topic_t topics[topic_static_num];
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
 #endif
 
-} topic_data_t;
-
-static topic_data_t topic_data = {
-    .new_topic_enabled = false,  // New topics are disabled by default
+// Private
+// ================
 
-#if TOPIC_IS_DYNAMIC
-    .topics = nullptr,  // No topics allocated by default
-#else
-    .topics = {{0}},  // Initialize static topics array to zero
-#endif
+enum {
+    json_line_size = 1024,  // One JSON object per line, longer is truncated
+    json_time_size = 20,    // YYYY-MM-DDTHH:MM:SS + null
+    json_utf8_tail = 3,     // Continuation bytes of a UTF-8 character
 };
 
-// === Implementation specific functions for topics ===========================
-
-/// @brief Converts a topic string to its ID
-/// @param str - Topic string
-/// @return Topic ID or ULOG_TOPIC_ID_INVALID if not found
-static ulog_topic_id topic_str_to_id(const char *str);
+/// @brief Line being built, written to the stream in one piece
+typedef struct {
+    char data[json_line_size];
+    size_t pos;
+    size_t limit;    // Room for the closing "}\n" is kept behind the limit
+    bool truncated;  // Some output did not fit
+} json_line;
+
+/// @brief Checks if a byte must be escaped in a JSON string
+static inline bool json_needs_escape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
 
-/// @brief Gets the topic by ID
-/// @param topic - Topic ID
-/// @return Pointer to the topic if found, nullptr otherwise
-static topic_t *topic_get(ulog_topic_id topic);
+/// @brief Finds the first byte that must be escaped in a JSON string
+/// @details Checks 32 (AVX2) or 16 (SSE2) bytes per step, the tail and other
+/// targets use the scalar loop.
+/// @return Index of the byte, or `size` if nothing has to be escaped
+NOT_VERY_STATIC size_t json_escape_find(const char *str, size_t size) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    auto quote_32     = _mm256_set1_epi8('"');
+    auto backslash_32 = _mm256_set1_epi8('\\');
+    auto control_32   = _mm256_set1_epi8(0x1f);
+    for (; i + 32 <= size; i += 32) {
+        auto v = _mm256_loadu_si256((const __m256i *)(str + i));
+        // max_epu8(v, 0x1f) == 0x1f holds for unsigned v <= 0x1f
+        auto ctl = _mm256_cmpeq_epi8(_mm256_max_epu8(v, control_32), control_32);
+        auto hit = _mm256_or_si256(_mm256_or_si256(ctl, _mm256_cmpeq_epi8(v, quote_32)),
+                                   _mm256_cmpeq_epi8(v, backslash_32));
+        auto mask = (unsigned)_mm256_movemask_epi8(hit);
+        if (mask != 0) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif  // __AVX2__
+
+#if defined(__SSE2__)
+    auto quote_16     = _mm_set1_epi8('"');
+    auto backslash_16 = _mm_set1_epi8('\\');
+    auto control_16   = _mm_set1_epi8(0x1f);
+    for (; i + 16 <= size; i += 16) {
+        auto v    = _mm_loadu_si128((const __m128i *)(str + i));
+        auto ctl  = _mm_cmpeq_epi8(_mm_max_epu8(v, control_16), control_16);
+        auto hit  = _mm_or_si128(_mm_or_si128(ctl, _mm_cmpeq_epi8(v, quote_16)),
+                                 _mm_cmpeq_epi8(v, backslash_16));
+        auto mask = (unsigned)_mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif  // __SSE2__
 
-/// @brief Add a new topic
-/// @param topic_name - Topic name
-/// @param output - Output id
-static ulog_topic_id topic_add(const char *topic_name, ulog_output_id output);
+    for (; i < size; i++) {
+        if (json_needs_escape((unsigned char)str[i])) {
+            return i;
+        }
+    }
+    return size;
+}
 
-/// @brief Remove a topic by name
-/// @param topic_name - Topic name
-/// @return ulog_status
-static ulog_status topic_remove(const char *topic_name);
+/// @brief Escapes a string for JSON without splitting escape sequences or
+/// UTF-8 characters
+/// @param out - Output buffer, not null terminated
+/// @param out_size - Size of the output buffer
+/// @param str - Input string
+/// @param size - Input size
+/// @param consumed - (Output, optional) number of input bytes escaped
+/// @return Number of bytes written to `out`
+NOT_VERY_STATIC size_t json_escape(char *out, size_t out_size, const char *str,
+                                   size_t size, size_t *consumed) {
+    static constexpr char hex[] = "0123456789abcdef";
+    size_t written              = 0;
+    auto start                  = str;
+
+    while (size > 0) {
+        auto span = json_escape_find(str, size);
+        if (span > out_size - written) {
+            span = out_size - written;  // Copy what fits and stop
+            // Cut before the character whose continuation byte did not fit
+            for (unsigned i = 0; i < json_utf8_tail && span > 0 &&
+                                 ((unsigned char)str[span] & 0xC0) == 0x80;
+                 i++) {
+                span--;
+            }
+            size = span;
+        }
+        memcpy(out + written, str, span);
+        written += span;
+        str += span;
+        size -= span;
+        if (size == 0) {
+            break;
+        }
 
-// === Common Topic Functions =================================================
+        auto c   = (unsigned char)*str;
+        auto esc = (char)0;
+        switch (c) {
+        case '"':
+            esc = '"';
+            break;
+        case '\\':
+            esc = '\\';
+            break;
+        case '\n':
+            esc = 'n';
+            break;
+        case '\r':
+            esc = 'r';
+            break;
+        case '\t':
+            esc = 't';
+            break;
+        case '\b':
+            esc = 'b';
+            break;
+        case '\f':
+            esc = 'f';
+            break;
+        default:
+            break;
+        }
 
-static void topic_print(print_target *tgt, ulog_event *ev) {
-    if (!topic_config_is_enabled()) {
-        return;  // Topics are disabled, do nothing
+        auto esc_size = (esc != 0) ? 2U : 6U;
+        if (out_size - written < esc_size) {
+            break;  // Escape sequence does not fit
+        }
+        out[written] = '\\';
+        if (esc != 0) {
+            out[written + 1] = esc;
+        } else {
+            memcpy(out + written + 1, "u00", 3);
+            out[written + 4] = hex[c >> 4];
+            out[written + 5] = hex[c & 0xf];
+        }
+        written += esc_size;
+        str++;
+        size--;
+    }
+    if (consumed != nullptr) {
+        *consumed = (size_t)(str - start);
     }
+    return written;
+}
 
-    auto t = topic_get(ev->topic);
-    if (t != nullptr) {
-        print_to_target(tgt, "[%s] ", t->name);
+static bool json_raw(json_line *line, const char *data, size_t size) {
+    if (line->truncated || size > line->limit - line->pos) {
+        line->truncated = true;
+        return false;
     }
+    memcpy(line->data + line->pos, data, size);
+    line->pos += size;
+    return true;
 }
 
-/// @brief Sets the topic level
-/// @param topic - Topic ID
-/// @param level - Log level to set
-/// @return ULOG_STATUS_OK if success, ULOG_STATUS_NOT_FOUND if topic not found
-static ulog_status topic_set_level(int topic, ulog_level level) {
-    if (!level_is_valid(level)) {
-        return ULOG_STATUS_INVALID_ARGUMENT;
+/// @brief Appends a quoted string; the content may be cut but the closing
+/// quote is always written
+static bool json_string(json_line *line, const char *str, size_t size) {
+    if (line->truncated || line->limit - line->pos < 2) {
+        line->truncated = true;
+        return false;
     }
-    auto t = topic_get(topic);
-    if (t != nullptr) {
-        t->level = level;
-        return ULOG_STATUS_OK;
+    line->data[line->pos++] = '"';
+    auto room               = line->limit - line->pos - 1;
+    auto consumed           = (size_t)0;
+    line->pos += json_escape(line->data + line->pos, room, str, size, &consumed);
+    line->data[line->pos++] = '"';
+    if (consumed < size) {
+        line->truncated = true;  // String was cut
     }
-    return ULOG_STATUS_NOT_FOUND;
+    return !line->truncated;
 }
 
-/// @brief Checks if the topic is loggable
-/// @param t - Pointer to the topic, nullptr is allowed
-/// @param level - Log level to check against
-/// @return true if loggable, false otherwise
-static bool topic_is_loggable(topic_t *t, ulog_level level) {
-    if (t == nullptr) {
-        return false;  // Topic not found, cannot log
-    }
-    if (!level_is_allowed(level, t->level)) {
-        return false;  // Topic is disabled, cannot log
+/// @brief Appends `,"key":` with the key escaped
+static bool json_key(json_line *line, const char *key) {
+    return json_raw(line, ",", 1) && json_string(line, key, strlen(key)) &&
+           json_raw(line, ":", 1);
+}
+
+static bool json_number(json_line *line, const char *format, ...) {
+    char buf[32];
+    va_list args;
+    va_start(args, format);
+    auto size = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (size < 0 || (size_t)size >= sizeof(buf)) {
+        return json_raw(line, "null", 4);
     }
-    return true;
+    return json_raw(line, buf, (size_t)size);
 }
 
-/// @brief Processes the topic
-/// @param topic - Topic name
-/// @param level - Log level
-/// @param is_log_allowed - (Output) log allowed
-/// @param topic_id - (Output) topic ID
-/// @param output - (Output) topic output ID
-static void topic_process(const char *topic, ulog_level level,
-                          bool *is_log_allowed, int *topic_id,
-                          ulog_output_id *output) {
-    if (is_log_allowed == nullptr || topic_id == nullptr || output == nullptr) {
-        return;  // Invalid arguments, do nothing
+static bool json_field_value(json_line *line, const ulog_kv_field *field) {
+    switch (field->type) {
+    case ULOG_KV_BOOL:
+        return field->value.b ? json_raw(line, "true", 4)
+                              : json_raw(line, "false", 5);
+    case ULOG_KV_INT:
+        return json_number(line, "%lld", (long long)field->value.i);
+    case ULOG_KV_UINT:
+        return json_number(line, "%llu", (unsigned long long)field->value.u);
+    case ULOG_KV_DOUBLE:
+        if (!isfinite(field->value.d)) {
+            return json_raw(line, "null", 4);  // JSON has no inf/nan
+        }
+        return json_number(line, field_double_format, field->value.d);
+    case ULOG_KV_STRING:
+        if (field->value.s == nullptr) {
+            return json_raw(line, "null", 4);
+        }
+        return json_string(line, field->value.s, strlen(field->value.s));
+    default:
+        return json_raw(line, "null", 4);
     }
+}
 
-    auto t = topic_get(topic_str_to_id(topic));
+/// @brief Appends all fields; a field that does not fit is rolled back so
+/// the line stays valid JSON
+static void json_fields(json_line *line, ulog_event *ev) {
+    for (size_t i = 0; i < event_field_count(ev); i++) {
+        auto field      = event_field(ev, i);
+        auto checkpoint = line->pos;
+        auto key        = is_str_empty(field->key) ? "?" : field->key;
+        if (!json_key(line, key) || !json_field_value(line, field)) {
+            line->pos = checkpoint;
+            return;
+        }
+    }
+}
 
-    *is_log_allowed = topic_is_loggable(t, level);
-    if (!*is_log_allowed) {
-        return;  // Topic is not loggable, stop processing
+static void json_level(json_line *line, ulog_event *ev) {
+    auto name = level_event_name(ev);
+    auto size = strlen(name);
+    while (size > 0 && name[size - 1] == ' ') {
+        size--;  // Level names are padded for text alignment
     }
-    *topic_id = t->id;      // Set topic ID
-    *output   = t->output;  // Set topic output
+    (void)json_raw(line, "\"level\":", 8);
+    (void)json_string(line, name, size);
 }
 
-// Public
-// ================
+static void json_time(json_line *line, ulog_event *ev) {
+#if ULOG_HAS_TIME
+    if (!time_config_is_enabled(ev) || ev->time == nullptr) {
+        return;
+    }
+    char buf[json_time_size] = {0};
+    auto size = strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", ev->time);
+    (void)json_raw(line, "\"time\":", 7);
+    (void)json_string(line, buf, size);
+    (void)json_raw(line, ",", 1);
+#else
+    (void)line, (void)ev;
+#endif  // ULOG_HAS_TIME
+}
 
-ulog_status ulog_topic_level_set(const char *topic_name, ulog_level level) {
-    if (is_str_empty(topic_name)) {
-        return ULOG_STATUS_INVALID_ARGUMENT;
+static void json_topic(json_line *line, ulog_event *ev) {
+#if ULOG_HAS_TOPICS
+    if (!topic_config_is_enabled(ev)) {
+        return;
     }
-    auto topic_id = ulog_topic_get_id(topic_name);
-    if (topic_id == ULOG_TOPIC_ID_INVALID) {
-        return ULOG_STATUS_NOT_FOUND;  // Topic not found, do nothing
+    if (!is_str_empty(ev->topic_name)) {
+        auto checkpoint = line->pos;
+        if (!json_raw(line, ",\"topic\":", 9) ||
+            !json_string(line, ev->topic_name, strlen(ev->topic_name))) {
+            line->pos       = checkpoint;  // Left out, the message may fit
+            line->truncated = false;
+        }
     }
-    return topic_set_level(topic_id, level);
+#else
+    (void)line, (void)ev;
+#endif  // ULOG_HAS_TOPICS
 }
 
-ulog_topic_id ulog_topic_get_id(const char *topic_name) {
-    if (is_str_empty(topic_name)) {
-        return ULOG_TOPIC_ID_INVALID;
+static void json_source_location(json_line *line, ulog_event *ev) {
+#if ULOG_HAS_SOURCE_LOCATION
+    if (!src_loc_config_is_enabled(ev) || ev->file == nullptr) {
+        return;
     }
-    return topic_str_to_id(topic_name);
+    auto checkpoint = line->pos;
+    if (!json_raw(line, ",\"file\":", 8) ||
+        !json_string(line, ev->file, strlen(ev->file)) ||
+        !json_raw(line, ",\"line\":", 8) ||
+        !json_number(line, "%d", ev->line)) {
+        line->pos       = checkpoint;  // Left out, the message may fit
+        line->truncated = false;
+    }
+#else
+    (void)line, (void)ev;
+#endif  // ULOG_HAS_SOURCE_LOCATION
 }
 
-ulog_topic_id ulog_topic_add(const char *topic_name, ulog_output_id output,
-                             ulog_level level) {
-    if (is_str_empty(topic_name)) {
-        return ULOG_TOPIC_ID_INVALID;  // Invalid topic name, do nothing
+static void json_message(json_line *line, ulog_event *ev) {
+    char msg[json_line_size];
+    auto tgt = (print_target){.type       = PRINT_TARGET_BUFFER,
+                              .dsc.buffer = {msg, 0, sizeof(msg)}};
+    msg[0]   = '\0';
+    if (!is_str_empty(ev->message)) {
+        va_list args;
+        va_copy(args, ev->message_format_args);
+        print_to_target_cached_valist(&tgt, ev->format_cache, ev->message,
+                                      args);
+        va_end(args);
     }
-    auto id = topic_add(topic_name, output);
-    if (id != ULOG_TOPIC_ID_INVALID) {
-        topic_set_level(id, level);
+    auto checkpoint = line->pos;
+    if (!json_raw(line, ",\"msg\":", 7)) {
+        line->pos = checkpoint;
+        return;
+    }
+    auto value = line->pos;
+    if (!json_string(line, msg, strlen(msg)) && line->pos == value) {
+        line->pos = checkpoint;  // Not even a cut message fits
     }
-    return id;
 }
 
-ulog_status ulog_topic_remove(const char *topic_name) {
-    if (is_str_empty(topic_name)) {
-        return ULOG_STATUS_INVALID_ARGUMENT;  // Invalid topic name, do nothing
+/// @brief Writes an event as a single line JSON object:
+/// {"time":..,"level":..,"topic":..,"file":..,"line":..,"msg":..,<fields>}
+static void output_json_handler(ulog_event *ev, void *arg) {
+    json_line line;
+    line.pos       = 0;
+    line.limit     = sizeof(line.data) - 2;  // Keep room for "}\n"
+    line.truncated = false;
+
+    (void)json_raw(&line, "{", 1);
+    json_time(&line, ev);
+    json_level(&line, ev);
+    json_topic(&line, ev);
+    json_source_location(&line, ev);
+    json_message(&line, ev);
+    json_fields(&line, ev);
+
+    line.limit     = sizeof(line.data);
+    line.truncated = false;
+    (void)json_raw(&line, "}\n", 2);
+    auto written = fwrite(line.data, 1, line.pos, (FILE *)arg);
+    stats_stream_written((int64_t)written);
+}
+
+// Public
+// ================
+
+ulog_output_id ulog_output_add_json_file(FILE *file, ulog_level level) {
+    if (file == nullptr) {
+        return ULOG_OUTPUT_INVALID;
     }
-    return topic_remove(topic_name);
+    return ulog_output_add(output_json_handler, file, level);
 }
 
-#else  // ULOG_HAS_TOPICS
+#else  // ULOG_HAS_JSON_OUTPUT
 
 // Disabled Public
 // ================
 
 #if ULOG_HAS_WARN_NOT_ENABLED
-
-ulog_status ulog_topic_level_set(const char *topic_name, ulog_level level) {
-    (void)(topic_name);
+ulog_output_id ulog_output_add_json_file(FILE *file, ulog_level level) {
+    (void)(file);
     (void)(level);
-    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
-    return ULOG_STATUS_DISABLED;
-}
-
-ulog_topic_id ulog_topic_get_id(const char *topic_name) {
-    (void)(topic_name);
-    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
-    return ULOG_TOPIC_ID_INVALID;
+    warn_not_enabled("ULOG_BUILD_JSON_OUTPUT");
+    return ULOG_OUTPUT_INVALID;
 }
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
 
-ulog_topic_id ulog_topic_add(const char *topic_name, ulog_output_id output,
-                             ulog_level level) {
-    (void)(topic_name);
-    (void)(output);
-    (void)(level);
-    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
-    return ULOG_TOPIC_ID_INVALID;
-}
+#endif  // ULOG_HAS_JSON_OUTPUT
 
-ulog_status ulog_topic_remove(const char *topic_name) {
-    (void)(topic_name);
-    warn_not_enabled("ULOG_BUILD_TOPICS_MODE");
-    return ULOG_STATUS_DISABLED;
-}
+/* ============================================================================
+   Optional Feature: Binary Output
+   (`binary_*`, depends on: Extra Outputs, Fields, Levels, Topics, Time,
+                            Source Location)
+============================================================================ */
+#if ULOG_HAS_BINARY_OUTPUT
 
-#endif  // ULOG_HAS_WARN_NOT_ENABLED
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 
-// Disabled Private
+// Private
 // ================
 
-#define topic_print(tgt, ev) (void)(tgt), (void)(ev)
-#define topic_process(topic, level, is_log_allowed, topic_id, output)          \
-    (void)(topic), (void)(level), (void)(is_log_allowed), (void)(topic_id),    \
-        (void)(output)
+// Stream layout (see tools/ulog_binary_convert.c for the reader):
+//
+//   stream header: 0x00 "ULOGB" version
+//   record:        varint body_size | body | crc32c(body), 4 bytes LE
+//   body:          type byte followed by the type specific payload
+//
+// Integers are LEB128 varints, signed ones zigzag encoded. File names and
+// topics are announced once per stream with a definition record and then
+// referenced by id. A zero record size marks a (new) stream header, so
+// appending to an existing file is valid.
+enum {
+    binary_version        = 1,
+    binary_record_size    = 1024,  // Largest record, longer is truncated
+    binary_files_max      = 64,    // Interned file names per stream
+    binary_topics_max     = 32,    // Interned topic ids per stream
+    binary_topic_name_max = 64,    // Longer topic names are sent inline
+    binary_varint_max     = 10,    // Bytes of a 64-bit varint
+    binary_msg_size_bytes = 2,     // Message size is always a 2 byte varint
+    binary_inline_max     = 256,   // Longer inline names are left out
+};
 
-#endif  // ULOG_HAS_TOPICS
+typedef enum {
+    BINARY_RECORD_FILE   = 1,  // varint id, string
+    BINARY_RECORD_TOPIC  = 2,  // varint id, string
+    BINARY_RECORD_LEVELS = 3,  // u8 count, count strings
+    BINARY_RECORD_EVENT  = 4,  // see binary_event_encode
+} binary_record_type;
 
-/* ============================================================================
-   Optional Feature: Topics - Static Allocation
-   (`topic_*`, depends on: Topics)
-============================================================================ */
-#if ULOG_HAS_TOPICS && TOPIC_IS_DYNAMIC == false
-// Private
-// ================
+typedef enum {
+    BINARY_EVENT_HAS_TIME  = 1 << 0,
+    BINARY_EVENT_HAS_TOPIC = 1 << 1,
+    BINARY_EVENT_HAS_FILE  = 1 << 2,
+} binary_event_flags;
 
-ulog_topic_id topic_str_to_id(const char *str) {
-    if (is_str_empty(str)) {
-        return ULOG_TOPIC_ID_INVALID;
-    }
-    for (auto i = 0; i < topic_static_num; i++) {
-        if (is_str_empty(topic_data.topics[i].name)) {
-            continue;  // Skip empty slot; continue searching
-        }
-        if (strcmp(topic_data.topics[i].name, str) == 0) {
-            return topic_data.topics[i].id;
-        }
-    }
-    return ULOG_TOPIC_ID_INVALID;  // Not found
-}
+// Topic and file references: 0 - string follows inline, n - interned id n-1
+static constexpr uint64_t binary_ref_inline = 0;
 
-static topic_t *topic_get(ulog_topic_id topic) {
-    if (topic < topic_static_num && topic >= 0) {
-        return &topic_data.topics[topic];
+// Field type byte is the ulog_kv_type, or this value for a null string
+static constexpr uint8_t binary_field_null = 0xff;
+
+/// @brief Per-stream state, one per possible extra output
+typedef struct {
+    FILE *file;
+    const ulog_level_descriptor *levels;  // Last announced level names
+    size_t file_count;
+    const char *files[binary_files_max];
+    // Announced name per id, copied: events carry the logger's string, which
+    // is a different pointer per call site and per queued event
+    char topic_names[binary_topics_max][binary_topic_name_max];
+    uint32_t topic_hashes[binary_topics_max];  // Checked before the names
+} binary_stream;
+
+typedef struct {
+    uint8_t data[binary_record_size];
+    size_t pos;
+    size_t limit;  // Room for the CRC is kept behind the limit
+    bool truncated;
+} binary_record;
+
+enum { binary_body_start = 2 };  // Body size varint fits in 2 bytes
+
+typedef struct {
+    binary_stream streams[ULOG_BUILD_EXTRA_OUTPUTS];
+} binary_data_t;
+
+// Streams are only ever picked by outputs of the same instance
+static binary_data_t binary_instances[logger_total_num];
+#define binary_streams binary_instances[logger_id()].streams
+
+static void output_binary_handler(ulog_event *ev, void *arg);
+
+/// @brief CRC32C (Castagnoli), computed with the SSE4.2 or ARMv8 CRC
+/// instructions when available
+NOT_VERY_STATIC uint32_t binary_crc32c(const uint8_t *data, size_t size) {
+    uint32_t crc = 0xffffffffU;
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t chunk;
+        memcpy(&chunk, data, sizeof(chunk));
+        crc64 = _mm_crc32_u64(crc64, chunk);
     }
-    return nullptr;
-}
+    crc = (uint32_t)crc64;
+#endif
 
-static ulog_topic_id topic_add(const char *topic_name, ulog_output_id output) {
-    if (is_str_empty(topic_name)) {
-        return ULOG_TOPIC_ID_INVALID;
+#if defined(__SSE4_2__)
+    for (; size > 0; size--, data++) {
+        crc = _mm_crc32_u8(crc, *data);
     }
-    if (lock_lock() != ULOG_STATUS_OK) {  // Lock the configuration
-        return ULOG_TOPIC_ID_INVALID;
+#elif defined(__ARM_FEATURE_CRC32)
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t chunk;
+        memcpy(&chunk, data, sizeof(chunk));
+        crc = __crc32cd(crc, chunk);
     }
-    for (auto i = 0; i < topic_static_num; i++) {
-        // If there is an empty slot
-        if (is_str_empty(topic_data.topics[i].name)) {
-            topic_data.topics[i].id     = i;
-            topic_data.topics[i].name   = topic_name;
-            topic_data.topics[i].level  = topic_level_default;
-            topic_data.topics[i].output = output;
-            (void)lock_unlock();  // Unlock the configuration
-            return i;
-        }
-        // If the topic already exists
-        else if (strcmp(topic_data.topics[i].name, topic_name) == 0) {
-            (void)lock_unlock();  // Unlock the configuration
-            return i;
+    for (; size > 0; size--, data++) {
+        crc = __crc32cb(crc, *data);
+    }
+#else
+    for (; size > 0; size--, data++) {
+        crc ^= *data;
+        for (auto bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0x82f63b78U & (0U - (crc & 1U)));
         }
     }
-    (void)lock_unlock();           // Unlock the configuration
-    return ULOG_TOPIC_ID_INVALID;  // No space for new topics
+#endif
+
+    return crc ^ 0xffffffffU;
 }
 
-static ulog_status topic_remove(const char *topic_name) {
-    if (is_str_empty(topic_name)) {
-        return ULOG_STATUS_INVALID_ARGUMENT;  // Invalid topic name, do nothing
-    }
-    if (lock_lock() != ULOG_STATUS_OK) {  // Lock the configuration
-        return ULOG_STATUS_BUSY;
-    }
-    for (auto i = 0; i < topic_static_num; i++) {
-        if (is_str_empty(topic_data.topics[i].name)) {
-            continue;  // Skip empty slot; continue search
-        }
-        if (strcmp(topic_data.topics[i].name, topic_name) == 0) {
-            // Clear the topic entry
-            topic_data.topics[i] = (topic_t){0};
-            return lock_unlock();
-        }
-    }
-    if (lock_unlock() != ULOG_STATUS_OK) {  // Unlock the configuration
-        return ULOG_STATUS_BUSY;
+static bool binary_bytes(binary_record *rec, const void *data, size_t size) {
+    if (rec->truncated || size > rec->limit - rec->pos) {
+        rec->truncated = true;
+        return false;
     }
-    return ULOG_STATUS_NOT_FOUND;  // Topic not found
+    memcpy(rec->data + rec->pos, data, size);
+    rec->pos += size;
+    return true;
 }
-#endif  // ULOG_HAS_TOPICS && TOPIC_IS_DYNAMIC == false
 
-/* ============================================================================
-   Optional Feature: Topics - Dynamic Allocation
-   (`topic_*`, depends on: Topics)
-============================================================================ */
+static bool binary_u8(binary_record *rec, uint8_t value) {
+    return binary_bytes(rec, &value, 1);
+}
 
-#if ULOG_HAS_TOPICS && TOPIC_IS_DYNAMIC == true
-// Private
-// ================
+static bool binary_varint(binary_record *rec, uint64_t value) {
+    uint8_t buf[binary_varint_max];
+    size_t size = 0;
+    do {
+        buf[size] = (uint8_t)(value & 0x7f);
+        value >>= 7;
+        buf[size++] |= (value != 0) ? 0x80 : 0;
+    } while (value != 0);
+    return binary_bytes(rec, buf, size);
+}
 
-static topic_t *topic_get_first() {
-    return topic_data.topics;
+static bool binary_zigzag(binary_record *rec, int64_t value) {
+    return binary_varint(rec,
+                         ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
 }
 
-static topic_t *topic_get_next(topic_t *t) {
-    return t->next;
+static bool binary_string(binary_record *rec, const char *str) {
+    auto size = strlen(str);
+    return binary_varint(rec, size) && binary_bytes(rec, str, size);
 }
 
-static topic_t *topic_get_last() {
-    auto last = topic_data.topics;
-    if (last == nullptr) {
-        return nullptr;  // No topics
+static void binary_record_begin(binary_record *rec, binary_record_type type) {
+    rec->pos       = binary_body_start;
+    rec->limit     = sizeof(rec->data) - sizeof(uint32_t);
+    rec->truncated = false;
+    (void)binary_u8(rec, (uint8_t)type);
+}
+
+/// @brief Adds the size prefix and CRC, then writes the record in one piece
+static void binary_record_write(binary_record *rec, FILE *file) {
+    auto body      = rec->data + binary_body_start;
+    auto body_size = rec->pos - binary_body_start;
+    auto crc       = binary_crc32c(body, body_size);
+    for (auto i = 0; i < 4; i++) {
+        rec->data[rec->pos++] = (uint8_t)(crc >> (8 * i));
     }
-    while (last->next != nullptr) {
-        last = last->next;
+
+    auto start = (size_t)binary_body_start;
+    if (body_size < 0x80) {
+        rec->data[--start] = (uint8_t)body_size;
+    } else {
+        rec->data[--start] = (uint8_t)(body_size >> 7);
+        rec->data[--start] = (uint8_t)(0x80 | (body_size & 0x7f));
     }
-    return last;
+    auto written = fwrite(rec->data + start, 1, rec->pos - start, file);
+    stats_stream_written((int64_t)written);
 }
 
-ulog_topic_id topic_str_to_id(const char *str) {
-    if (is_str_empty(str)) {
-        return ULOG_TOPIC_ID_INVALID;
+static void binary_stream_start(binary_stream *stream, FILE *file) {
+    static constexpr uint8_t header[] = {0x00, 'U', 'L', 'O', 'G', 'B',
+                                         binary_version};
+    *stream      = (binary_stream){0};
+    stream->file = file;
+    fwrite(header, 1, sizeof(header), file);
+}
+
+static void binary_levels_announce(binary_stream *stream,
+                                   const ulog_level_descriptor *levels) {
+    if (stream->levels == levels) {
+        return;
     }
-    for (auto t = topic_get_first(); t != nullptr; t = topic_get_next(t)) {
-        if (!is_str_empty(t->name) && strcmp(t->name, str) == 0) {
-            return t->id;
+    binary_record rec;
+    binary_record_begin(&rec, BINARY_RECORD_LEVELS);
+    (void)binary_u8(&rec, (uint8_t)(levels->max_level + 1));
+    for (auto i = 0; i <= (int)levels->max_level; i++) {
+        (void)binary_string(&rec, levels->names[i]);
+    }
+    if (!rec.truncated) {
+        binary_record_write(&rec, stream->file);
+        stream->levels = levels;
+    }
+}
+
+/// @brief Returns the file reference, announcing the file name if needed
+static uint64_t binary_file_ref(binary_stream *stream, const char *file) {
+    for (size_t i = 0; i < stream->file_count; i++) {
+        if (stream->files[i] == file || strcmp(stream->files[i], file) == 0) {
+            return i + 1;
         }
     }
-    return ULOG_TOPIC_ID_INVALID;
-}
+    if (stream->file_count >= binary_files_max) {
+        return binary_ref_inline;  // Table is full
+    }
 
-static topic_t *topic_get(int topic) {
-    if (topic < 0) {
-        return nullptr;  // Invalid topic ID
+    binary_record rec;
+    binary_record_begin(&rec, BINARY_RECORD_FILE);
+    (void)binary_varint(&rec, stream->file_count);
+    (void)binary_string(&rec, file);
+    if (rec.truncated) {
+        return binary_ref_inline;
     }
-    for (auto t = topic_get_first(); t != nullptr; t = topic_get_next(t)) {
-        if (t->id == topic) {
-            return t;
-        }
+    binary_record_write(&rec, stream->file);
+    stream->files[stream->file_count] = file;
+    return ++stream->file_count;
+}
+
+#if ULOG_HAS_TOPICS
+static uint32_t binary_hash(const char *str) {
+    uint32_t hash = 2166136261U;  // FNV-1a
+    for (; *str != '\0'; str++) {
+        hash = (hash ^ (uint8_t)*str) * 16777619U;
     }
-    return nullptr;
+    return hash;
 }
 
-static topic_t *topic_allocate(int id, const char *topic_name,
-                               ulog_output_id output) {
-    if (is_str_empty(topic_name)) {
-        return nullptr;  // Invalid topic name, do not allocate
+/// @brief Returns the topic reference, announcing the topic name if needed
+static uint64_t binary_topic_ref(binary_stream *stream, ulog_topic_id id,
+                                 const char *name) {
+    if (id < 0 || id >= binary_topics_max) {
+        return binary_ref_inline;
     }
-    if (id < 0) {
-        return nullptr;  // Invalid ID, do not allocate
+    auto hash = binary_hash(name);
+    if (stream->topic_hashes[id] == hash &&
+        strcmp(stream->topic_names[id], name) == 0) {
+        return (uint64_t)id + 1;
+    }
+    auto len = strlen(name);
+    if (len >= binary_topic_name_max) {
+        return binary_ref_inline;  // Too long to keep a copy of
     }
-    auto t = (topic_t *)calloc(1, sizeof(topic_t));
-    if (t != nullptr) {
-        // Allocate memory for the topic name and copy it
-        auto name_len  = strlen(topic_name) + 1;
-        auto name_copy = (char *)calloc(name_len, sizeof(char));
-        if (name_copy == nullptr) {
-            free(t);
-            return nullptr;  // Failed to allocate memory for name
-        }
-        memcpy(name_copy, topic_name, name_len);
 
-        t->id     = id;
-        t->name   = name_copy;
-        t->level  = topic_level_default;
-        t->output = output;
-        t->next   = nullptr;
+    binary_record rec;
+    binary_record_begin(&rec, BINARY_RECORD_TOPIC);
+    (void)binary_varint(&rec, (uint64_t)id);
+    (void)binary_string(&rec, name);
+    if (rec.truncated) {
+        return binary_ref_inline;
     }
-    return t;
+    binary_record_write(&rec, stream->file);
+    memcpy(stream->topic_names[id], name, len + 1);
+    stream->topic_hashes[id] = hash;
+    return (uint64_t)id + 1;
 }
+#endif  // ULOG_HAS_TOPICS
 
-static ulog_topic_id topic_add(const char *topic_name, ulog_output_id output) {
-    if (is_str_empty(topic_name)) {
-        return ULOG_TOPIC_ID_INVALID;
+/// @brief Formats the message in place behind a fixed 2 byte size varint. One
+/// byte is kept behind it for the field count, so a cut message still ends
+/// in a (zero) field count.
+static void binary_message(binary_record *rec, ulog_event *ev) {
+    if (rec->truncated || rec->limit - rec->pos < binary_msg_size_bytes + 2) {
+        rec->truncated = true;
+        return;
+    }
+    auto size_pos = rec->pos;
+    auto room     = rec->limit - rec->pos - binary_msg_size_bytes - 1;
+    if (room > 0x3fff + 1) {
+        room = 0x3fff + 1;  // Largest size of a 2 byte varint + terminator
+    }
+    auto msg = (char *)rec->data + size_pos + binary_msg_size_bytes;
+    auto tgt = (print_target){.type       = PRINT_TARGET_BUFFER,
+                              .dsc.buffer = {msg, 0, room}};
+    msg[0]   = '\0';
+    if (!is_str_empty(ev->message)) {
+        va_list args;
+        va_copy(args, ev->message_format_args);
+        print_to_target_cached_valist(&tgt, ev->format_cache, ev->message,
+                                      args);
+        va_end(args);
     }
 
-    // if exists
-    for (auto t = topic_get_first(); t != nullptr; t = topic_get_next(t)) {
-        if (!is_str_empty(t->name) && strcmp(t->name, topic_name) == 0) {
-            return t->id;
-        }
+    auto size = strlen(msg);
+    // Non-minimal varint keeps the size field at 2 bytes
+    rec->data[size_pos]     = (uint8_t)(0x80 | (size & 0x7f));
+    rec->data[size_pos + 1] = (uint8_t)(size >> 7);
+    rec->pos += binary_msg_size_bytes + size;
+    if (size + 1 >= room) {
+        // Message was cut: skip the fields, the reserved byte counts none
+        rec->data[rec->pos++] = 0;
+        rec->truncated        = true;
     }
+}
 
-    // If the beginning is empty
-    if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_TOPIC_ID_INVALID;
+static bool binary_field(binary_record *rec, const ulog_kv_field *field) {
+    auto key = is_str_empty(field->key) ? "?" : field->key;
+    if (!binary_string(rec, key)) {
+        return false;
     }
-    auto t = topic_get_last();
-    if (t == nullptr) {
-        topic_data.topics = topic_allocate(0, topic_name, output);
-        if (topic_data.topics != nullptr) {
-            (void)lock_unlock();
-            return 0;
+    if (field->type == ULOG_KV_STRING && field->value.s == nullptr) {
+        return binary_u8(rec, binary_field_null);
+    }
+    if (!binary_u8(rec, (uint8_t)field->type)) {
+        return false;
+    }
+    switch (field->type) {
+    case ULOG_KV_BOOL:
+        return binary_u8(rec, field->value.b ? 1 : 0);
+    case ULOG_KV_INT:
+        return binary_zigzag(rec, field->value.i);
+    case ULOG_KV_UINT:
+        return binary_varint(rec, field->value.u);
+    case ULOG_KV_DOUBLE: {
+        uint64_t bits;
+        memcpy(&bits, &field->value.d, sizeof(bits));
+        uint8_t le[8];
+        for (auto i = 0; i < 8; i++) {
+            le[i] = (uint8_t)(bits >> (8 * i));
         }
-        (void)lock_unlock();
-        return ULOG_TOPIC_ID_INVALID;
+        return binary_bytes(rec, le, sizeof(le));
     }
-
-    // If the beginning is not empty
-    t->next = topic_allocate(t->id + 1, topic_name, output);
-    if (t->next) {
-        (void)lock_unlock();
-        return t->id + 1;
+    case ULOG_KV_STRING:
+        return binary_string(rec, field->value.s);
+    default:
+        return false;
     }
-    (void)lock_unlock();
-    return ULOG_TOPIC_ID_INVALID;
 }
 
-static ulog_status topic_remove(const char *topic_name) {
-    if (is_str_empty(topic_name)) {
-        return ULOG_STATUS_INVALID_ARGUMENT;  // Invalid topic name, do nothing
+/// @brief Appends fields; stops at the first one that does not fit
+static void binary_fields(binary_record *rec, ulog_event *ev) {
+    auto count_pos = rec->pos;
+    if (!binary_u8(rec, 0)) {
+        return;
     }
-    if (lock_lock() != ULOG_STATUS_OK) {  // Lock the configuration
-        return ULOG_STATUS_BUSY;
+    uint8_t count = 0;
+    for (size_t i = 0; i < event_field_count(ev) && count < 0x7f; i++) {
+        auto checkpoint = rec->pos;
+        if (!binary_field(rec, event_field(ev, i))) {
+            rec->pos       = checkpoint;
+            rec->truncated = false;
+            break;
+        }
+        count++;
     }
+    rec->data[count_pos] = count;  // Single byte varint, count < 128
+}
 
-    auto t          = topic_get_first();
-    topic_t *t_prev = nullptr;
+/// @brief Event body: flags, [time], level, [topic], [file, line], message,
+/// fields
+static void binary_event_encode(binary_stream *stream, binary_record *rec,
+                                ulog_event *ev) {
+    uint8_t flags  = 0;
+    int64_t time   = 0;
+    auto topic_ref = binary_ref_inline;
+    auto topic     = (const char *)nullptr;
+    auto file_ref  = binary_ref_inline;
+    auto file      = (const char *)nullptr;
+    auto line      = 0;
 
-    while (t != nullptr) {
-        if (!is_str_empty(t->name) && strcmp(t->name, topic_name) == 0) {
-            // Found the topic to remove
-            if (t_prev == nullptr) {
-                // Removing the first topic
-                topic_data.topics = t->next;
-            } else {
-                t_prev->next = t->next;
+#if ULOG_HAS_TIME
+    if (time_config_is_enabled(ev) && ev->time != nullptr) {
+        flags |= BINARY_EVENT_HAS_TIME;
+        time = ev->timestamp;
+    }
+#endif  // ULOG_HAS_TIME
+
+#if ULOG_HAS_TOPICS
+    if (topic_config_is_enabled(ev)) {
+        if (!is_str_empty(ev->topic_name)) {
+            topic_ref = binary_topic_ref(stream, ev->topic, ev->topic_name);
+            topic     = ev->topic_name;
+            if (topic_ref != binary_ref_inline ||
+                strlen(topic) <= binary_inline_max) {
+                flags |= BINARY_EVENT_HAS_TOPIC;
             }
-            free((void *)t->name);  // Free the allocated topic name
-            free(t);                // Free the topic memory
-            return lock_unlock();
         }
-        t_prev = t;
-        t      = t->next;
     }
+#endif  // ULOG_HAS_TOPICS
 
-    if (lock_unlock() != ULOG_STATUS_OK) {  // Unlock the configuration
-        return ULOG_STATUS_BUSY;
+#if ULOG_HAS_SOURCE_LOCATION
+    if (src_loc_config_is_enabled(ev) && ev->file != nullptr) {
+        file_ref = binary_file_ref(stream, ev->file);
+        file     = ev->file;
+        line     = ev->line;
+        if (file_ref != binary_ref_inline ||
+            strlen(file) <= binary_inline_max) {
+            flags |= BINARY_EVENT_HAS_FILE;  // Else the message would not fit
+        }
     }
-    return ULOG_STATUS_NOT_FOUND;  // Topic not found
-}
-
-#endif  // ULOG_HAS_TOPICS && TOPIC_IS_DYNAMIC == true
-
-/* ============================================================================
-   Optional Feature: Dynamic Configuration - Source Location
-   (`src_loc_config_*`, depends on: - )
-============================================================================ */
-#if ULOG_HAS_DYNAMIC_CONFIG
+#endif  // ULOG_HAS_SOURCE_LOCATION
 
-typedef struct {
-    bool enabled;
-} src_loc_config;
+    binary_record_begin(rec, BINARY_RECORD_EVENT);
+    (void)binary_u8(rec, flags);
+    if (flags & BINARY_EVENT_HAS_TIME) {
+        (void)binary_zigzag(rec, time);
+    }
+    (void)binary_u8(rec, (uint8_t)ev->level);
+    if (flags & BINARY_EVENT_HAS_TOPIC) {
+        (void)binary_varint(rec, topic_ref);
+        if (topic_ref == binary_ref_inline) {
+            (void)binary_string(rec, topic);
+        }
+    }
+    if (flags & BINARY_EVENT_HAS_FILE) {
+        (void)binary_varint(rec, file_ref);
+        if (file_ref == binary_ref_inline) {
+            (void)binary_string(rec, file);
+        }
+        (void)binary_zigzag(rec, line);
+    }
+    binary_message(rec, ev);
+    binary_fields(rec, ev);
+}
 
-static src_loc_config src_loc_cfg = {
-    .enabled = (bool)ULOG_HAS_SOURCE_LOCATION,
-};
+static void output_binary_handler(ulog_event *ev, void *arg) {
+    auto stream = (binary_stream *)arg;
+    binary_levels_announce(stream, ev->levels);
 
-// Private
-// ================
+    binary_record rec;
+    binary_event_encode(stream, &rec, ev);
+    binary_record_write(&rec, stream->file);
+}
 
-bool src_loc_config_is_enabled() {
-    return src_loc_cfg.enabled;
+/// @brief Finds a stream that is not used by any output
+static binary_stream *binary_stream_find_free() {
+    for (auto i = 0; i < ULOG_BUILD_EXTRA_OUTPUTS; i++) {
+        auto in_use = false;
+        for (auto o = 0; o < output_total_num; o++) {
+            if (output_data.outputs[o].handler == output_binary_handler &&
+                output_data.outputs[o].arg == &binary_streams[i]) {
+                in_use = true;
+                break;
+            }
+        }
+        if (!in_use) {
+            return &binary_streams[i];
+        }
+    }
+    return nullptr;
 }
 
 // Public
 // ================
 
-ulog_status ulog_source_location_config(bool enabled) {
+ulog_output_id ulog_output_add_binary_file(FILE *file, ulog_level level) {
+    if (file == nullptr || !level_is_valid(level)) {
+        return ULOG_OUTPUT_INVALID;
+    }
     if (lock_lock() != ULOG_STATUS_OK) {
-        return ULOG_STATUS_BUSY;
+        return ULOG_OUTPUT_INVALID;
     }
-    src_loc_cfg.enabled = enabled;
-    return lock_unlock();
+    auto stream = binary_stream_find_free();
+    if (stream == nullptr) {
+        (void)lock_unlock();
+        return ULOG_OUTPUT_INVALID;
+    }
+    for (auto i = 0; i < output_total_num; i++) {
+        if (output_data.outputs[i].handler == nullptr) {
+            binary_stream_start(stream, file);
+            output_data.outputs[i] = (output){output_binary_handler, stream,
+                                              level, nullptr, nullptr};
+            output_dispatch_update();
+            (void)lock_unlock();
+            return i;
+        }
+    }
+    (void)lock_unlock();
+    return ULOG_OUTPUT_INVALID;
 }
 
-#else  // ULOG_HAS_DYNAMIC_CONFIG
+#else  // ULOG_HAS_BINARY_OUTPUT
 
 // Disabled Public
 // ================
 
 #if ULOG_HAS_WARN_NOT_ENABLED
-
-ulog_status ulog_source_location_config(bool enabled) {
-    (void)(enabled);
-    warn_not_enabled("ULOG_BUILD_SOURCE_LOCATION");
-    return ULOG_STATUS_DISABLED;
+ulog_output_id ulog_output_add_binary_file(FILE *file, ulog_level level) {
+    (void)(file);
+    (void)(level);
+    warn_not_enabled("ULOG_BUILD_BINARY_OUTPUT");
+    return ULOG_OUTPUT_INVALID;
 }
-
 #endif  // ULOG_HAS_WARN_NOT_ENABLED
 
-// Disabled Private
-// ================
-
-#define src_loc_config_is_enabled() (ULOG_HAS_SOURCE_LOCATION)
-#endif  // ULOG_HAS_DYNAMIC_CONFIG
+#endif  // ULOG_HAS_BINARY_OUTPUT
 
 /* ============================================================================
    Core Feature: Log
@@ -1716,14 +6421,14 @@ ulog_status ulog_source_location_config(bool enabled) {
 static void log_print_message(print_target *tgt, ulog_event *ev) {
 
 #if ULOG_HAS_SOURCE_LOCATION
-    if (src_loc_config_is_enabled() && ev->file != nullptr) {
+    if (src_loc_config_is_enabled(ev) && ev->file != nullptr) {
         print_to_target(tgt, "%s:%d: ", ev->file, ev->line);  // file and line
     }
 #endif  // ULOG_HAS_SOURCE_LOCATION
 
     if (!is_str_empty(ev->message)) {
-        print_to_target_valist(tgt, ev->message,
-                               ev->message_format_args);  // message
+        print_to_target_cached_valist(tgt, ev->format_cache, ev->message,
+                                      ev->message_format_args);  // message
     } else {
         print_to_target(tgt, "nullptr");  // message
     }
@@ -1732,9 +6437,9 @@ static void log_print_message(print_target *tgt, ulog_event *ev) {
 /// @brief Writes a formatted message
 /// @details The message is formatted as follows:
 ///
-/// [Time][Prefix][Topic]Level [File: ]Message
+/// [Time][Prefix][Topic]Level [File: ]Message[ key=value...]
 /// or
-/// [Time ][Topic ]Level [File: ]Message
+/// [Time ][Topic ]Level [File: ]Message[ key=value...]
 ///
 /// where [Entry] is an optional part
 ///
@@ -1751,7 +6456,7 @@ static void log_print_event(print_target *tgt, ulog_event *ev, bool full_time,
     auto append_space = true;
     (void)append_space;  // May be unused if no prefix and time
 #if ULOG_HAS_PREFIX
-    if (prefix_data.function != nullptr && prefix_config_is_enabled()) {
+    if (ev->has_prefix && prefix_config_is_enabled(ev)) {
         append_space = false;  // Prefix does not need leading space
     }
 #endif
@@ -1759,23 +6464,31 @@ static void log_print_event(print_target *tgt, ulog_event *ev, bool full_time,
     full_time ? time_print_full(tgt, ev, append_space)
               : time_print_short(tgt, ev, append_space);
 
-    prefix_print(tgt);
+    prefix_print(tgt, ev);
+    thread_print(tgt, ev);
     level_print(tgt, ev);
     topic_print(tgt, ev);
     log_print_message(tgt, ev);
+    field_print_logfmt(tgt, ev, true);
 
-    color ? color_print_end(tgt) : (void)0;
+    color ? color_print_end(tgt, ev) : (void)0;
     new_line ? print_to_target(tgt, "\n") : (void)0;
 }
 
 void log_fill_event(ulog_event *ev, const char *message, ulog_level level,
-                    const char *file, int line, int topic_id) {
+                    const char *file, int line, int topic_id,
+                    const char *topic_name, const ulog_kv_field *fields,
+                    size_t field_count) {
     if (ev == nullptr) {
         return;  // Invalid event, do nothing
     }
 
-    ev->message = message;
-    ev->level   = level;
+    ev->message     = message;
+    ev->level       = level;
+    ev->levels      = level_data.dsc;
+    ev->fields      = fields;
+    ev->field_count = (fields != nullptr) ? field_count : 0;
+    context_fill(ev);
 
 #if ULOG_HAS_SOURCE_LOCATION
     ev->file = file;
@@ -1785,16 +6498,19 @@ void log_fill_event(ulog_event *ev, const char *message, ulog_level level,
 #endif  // ULOG_HAS_SOURCE_LOCATION
 
 #if ULOG_HAS_TOPICS
-    ev->topic = topic_id;
+    ev->topic      = topic_id;
+    ev->topic_name = topic_name;
 #else
-    (void)(topic_id);  // Unused if topics are disabled
+    (void)(topic_id), (void)(topic_name);  // Unused if topics are disabled
 #endif
 
 #if ULOG_HAS_TIME
     ev->time = nullptr;  // Time will be filled later
 #endif
 
+    config_take(ev);  // Before anything that depends on the toggles
     time_fill_current_time(ev);  // Fill time with current value
+    thread_fill(ev);
 }
 
 // Public
@@ -1817,46 +6533,127 @@ ulog_status ulog_event_to_cstr(ulog_event *ev, char *out, size_t out_size) {
     return ULOG_STATUS_OK;
 }
 
-void ulog_log(ulog_level level, const char *file, int line, const char *topic,
-              const char *message, ...) {
+/// @brief Common path of `ulog_log` and `ulog_log_kv`
+/// @param forced - Logged by a forced call site, passes every level filter
+static void log_handle(ulog_format_cache *cache, ulog_level level,
+                       const char *file, int line, const char *topic,
+                       bool forced, const ulog_kv_field *fields,
+                       size_t field_count, const char *message,
+                       va_list args) {
+    auto site = callsite_get(file, line);
+
     if (lock_lock() != ULOG_STATUS_OK) {
+        stats_dropped();
         return;  // Failed to acquire lock, drop log
     }
 
     if (!level_is_valid(level)) {
+        stats_event(level, false);
+        callsite_filtered(site);
         (void)lock_unlock();
         return;  // Invalid level for current configuration
     }
 
     // Try to get topic ID, outputs and check if logging is allowed for this
     // topic
-    auto output   = ULOG_OUTPUT_ALL;
-    auto topic_id = -1;
+    auto outputs           = output_dispatch(level, forced);
+    auto topic_id          = -1;
+    const char *topic_name = nullptr;
     if (!is_str_empty(topic)) {
         auto is_log_allowed = false;
-        topic_process(topic, level, &is_log_allowed, &topic_id, &output);
+        topic_process(topic, level, forced, &is_log_allowed, &topic_id,
+                      &outputs);
         if (!is_log_allowed) {
+            stats_filtered_topic();
+            callsite_filtered(site);
             (void)lock_unlock();
             return;  // Topic is not enabled or level is lower than topic level
         }
+        // Same text as the topic's name, which `ulog_topic_remove` may free
+        // while outputs outside the global lock still print it
+        topic_name = topic;
     }
 
     auto ev = (ulog_event){0};
-    log_fill_event(&ev, message, level, file, line, topic_id);
-    va_start(ev.message_format_args, message);
-
-    prefix_update(&ev);
-
-    // Handle output routing
-    if (output == ULOG_OUTPUT_ALL) {
-        output_handle_all(&ev);
+    log_fill_event(&ev, message, level, file, line, topic_id, topic_name,
+                   fields, field_count);
+    va_copy(ev.message_format_args, args);
+    ev.format_cache = cache;
+
+    auto prefix_fn = prefix_update(&ev);
+
+    // Handle output routing: outputs without their own lock run under the
+    // global lock, the others after it is released, each under its own lock
+    // or through its queue. The event only refers to the caller's data, so it
+    // stays valid without the global lock; the instance stays pinned until
+    // the last output is done.
+    output_route route;
+    output_route_take(&route, outputs);
+    auto bytes     = stats_output_begin();
+    auto delivered = false;
+    if (prefix_fn == nullptr) {
+        delivered = output_handle(&ev, &route);
+        (void)lock_release();
     } else {
-        output_handle_by_id(&ev, output);
+        // The prefix function runs without the global lock, which is taken
+        // again only if some output needs it
+        (void)lock_release();
+        prefix_render(&ev, prefix_fn);
+        delivered = output_handle_relocked(&ev, &route);
     }
+    delivered |= output_handle_detached(&ev, &route);
+
+    stats_event(level, delivered);
+    callsite_event(site, delivered, stats_output_begin() - bytes);
+    logger_unpin();
 
     va_end(ev.message_format_args);
+}
 
-    (void)lock_unlock();
+void ulog_log(ulog_level level, const char *file, int line, const char *topic,
+              const char *message, ...) {
+    va_list args;
+    va_start(args, message);
+    log_handle(nullptr, level, file, line, topic, false, nullptr, 0, message,
+               args);
+    va_end(args);
+}
+
+void ulog_log_cached(ulog_format_cache *cache, ulog_level level,
+                     const char *file, int line, const char *topic,
+                     const char *message, ...) {
+    va_list args;
+    va_start(args, message);
+    log_handle(cache, level, file, line, topic, false, nullptr, 0, message,
+               args);
+    va_end(args);
+}
+
+void ulog_log_site(ulog_site *site, ulog_level level, const char *topic,
+                   const char *message, ...) {
+    va_list args;
+    va_start(args, message);
+    log_handle(site->cache, level, site->file, site->line, topic,
+               site_is_forced(site), nullptr, 0, message, args);
+    va_end(args);
+}
+
+void ulog_log_desc(const ulog_site_desc *site, ...) {
+    va_list args;
+    va_start(args, site);
+    log_handle(site->cache, site->level, site->file, site->line, site->topic,
+               false, nullptr, 0, site->format, args);
+    va_end(args);
+}
+
+void ulog_log_kv(ulog_level level, const char *file, int line,
+                 const char *topic, const ulog_kv_field *fields,
+                 size_t field_count, const char *message, ...) {
+    va_list args;
+    va_start(args, message);
+    log_handle(nullptr, level, file, line, topic, false, fields, field_count,
+               message, args);
+    va_end(args);
 }
 
 /* ============================================================================
@@ -1867,23 +6664,21 @@ void ulog_log(ulog_level level, const char *file, int line, const char *topic,
 // Public
 // ================
 
-ulog_status ulog_cleanup() {
-    if (lock_lock() != ULOG_STATUS_OK) {  // Lock the configuration
-        return ULOG_STATUS_BUSY;
-    }
+/// @brief Resets the selected logger instance. Called with its lock held.
+static void cleanup_instance() {
     // Cleanup Topics
 
     // TODO: this section can be improved with topic_remove_all() function
 #if ULOG_HAS_TOPICS
-    // Reset new-topic default enable flag
+    // Reset new-topic default enable flag and the level rules
     topic_data.new_topic_enabled = false;
+    memset(topic_data.rules, 0, sizeof(topic_data.rules));
 #if TOPIC_IS_DYNAMIC
     // Free linked list of dynamically allocated topics
     auto t = topic_data.topics;
     while (t != nullptr) {
         auto next = t->next;
-        free((void *)t->name);  // Free the allocated topic name
-        free(t);
+        free(t);  // The name is stored in the same allocation
         t = next;
     }
     topic_data.topics = nullptr;
@@ -1893,23 +6688,214 @@ ulog_status ulog_cleanup() {
 #endif
 #endif  // ULOG_HAS_TOPICS
 
+#if ULOG_HAS_OUTPUT_QUEUE
+    // Stop the output workers after delivering their queued events
+    for (auto i = 0; i < output_total_num; i++) {
+        queue_stop(i);
+        queue_data.queues[i].policy = (ulog_queue_policy_config){0};
+    }
+#endif  // ULOG_HAS_OUTPUT_QUEUE
+
     // Cleanup Outputs (keep stdout (index 0) registered but reset its level)
     output_data.outputs[ULOG_OUTPUT_STDOUT].level = output_stdout_default_level;
+    output_data.outputs[ULOG_OUTPUT_STDOUT].lock  = nullptr;
 #if ULOG_HAS_EXTRA_OUTPUTS
     for (auto i = 1; i < output_total_num; i++) {
         output_data.outputs[i].handler = nullptr;
         output_data.outputs[i].arg     = nullptr;
         output_data.outputs[i].level   = output_stdout_default_level;
+        output_data.outputs[i].lock    = nullptr;
     }
 #endif  // ULOG_HAS_EXTRA_OUTPUTS
+    output_dispatch_update();
 
 #if ULOG_HAS_PREFIX
     // Reset prefix state
     prefix_data.function = nullptr;
-    memset(prefix_data.prefix, 0, sizeof(prefix_data.prefix));
+    prefix_data.mode     = ULOG_PREFIX_MODE_EVENT;
+    prefix_data.generation++;
 #endif
 
+    // Reset statistics
+    stats_reset();
+}
+
+ulog_status ulog_cleanup() {
+    if (lock_lock() != ULOG_STATUS_OK) {  // Lock the configuration
+        return ULOG_STATUS_BUSY;
+    }
+    cleanup_instance();
+    callsite_reset();
     return lock_unlock();
 }
 
+/* ============================================================================
+   Optional Feature: Logger Instances
+   (`logger_*`, depends on: Clean up, Lock, Levels, Outputs)
+============================================================================ */
+#if ULOG_HAS_LOGGERS
+#if !defined(__STDC_NO_THREADS__)
+#include <threads.h>
+#endif
+
+// Private
+// ================
+
+/// @brief Gives the selected instance the state of a fresh process. Its
+/// topics, queues, prefix and statistics are clear already: the slot is
+/// either unused or was cleaned up by `ulog_logger_remove`. No lock needed:
+/// the slot is owned by the caller, so no other thread can pin it.
+static void logger_reset() {
+    lock_data  = (lock_data_t){0};
+    level_data = (level_data_t){.dsc = &level_names_default};
+    config_reset();
+    output_data.outputs[ULOG_OUTPUT_STDOUT] =
+        (output){output_stdout_handler, nullptr, output_stdout_default_level,
+                 nullptr, nullptr};
+    output_dispatch_update();
+}
+
+/// @brief Waits until the calls that pinned the instance before it was owned
+/// are done
+static void logger_wait_unpinned(logger_slot_t *slot) {
+    // Sequentially consistent, like `logger_pin`: either the pin sees the new
+    // state or this sees the pin
+    while (atomic_load_explicit(&slot->users, memory_order_seq_cst) != 0) {
+#if !defined(__STDC_NO_THREADS__)
+        thrd_yield();
+#endif
+    }
+}
+
+// Public
+// ================
+
+ulog_logger_id ulog_logger_add() {
+    for (auto i = 1; i < logger_total_num; i++) {
+        auto slot  = &logger_slots[i];
+        auto state = atomic_load_explicit(&slot->state, memory_order_acquire);
+        if ((state & logger_state_phase) != logger_state_free ||
+            !atomic_compare_exchange_strong_explicit(
+                &slot->state, &state, state | logger_state_owned,
+                memory_order_acq_rel, memory_order_acquire)) {
+            continue;
+        }
+        auto previous = logger_current;
+        logger_select(i);
+        logger_reset();
+        logger_current = previous;
+        atomic_store_explicit(&slot->state,
+                              (state + logger_state_step) | logger_state_live,
+                              memory_order_release);
+        return i;
+    }
+    return ULOG_LOGGER_INVALID;  // All instances taken
+}
+
+ulog_status ulog_logger_remove(ulog_logger_id logger) {
+    if (logger == ULOG_LOGGER_DEFAULT) {
+        return ULOG_STATUS_ERROR;  // Cannot remove the default instance
+    }
+    if (logger < 0 || logger >= logger_total_num) {
+        return ULOG_STATUS_INVALID_ARGUMENT;
+    }
+    auto slot  = &logger_slots[logger];
+    auto state = atomic_load_explicit(&slot->state, memory_order_acquire);
+    auto owned = (state & ~(uint32_t)logger_state_phase) | logger_state_owned;
+    if ((state & logger_state_phase) != logger_state_live ||
+        !atomic_compare_exchange_strong_explicit(&slot->state, &state, owned,
+                                                 memory_order_seq_cst,
+                                                 memory_order_acquire)) {
+        return ULOG_STATUS_NOT_FOUND;
+    }
+
+    // New pins fail from here on; the calls inside finish before the cleanup
+    logger_wait_unpinned(slot);
+    auto previous = logger_current;
+    logger_select(logger);
+    cleanup_instance();
+    logger_current = previous;
+    if (previous.id == logger) {
+        logger_select(ULOG_LOGGER_DEFAULT);
+    }
+    atomic_store_explicit(&slot->state, owned - logger_state_owned,
+                          memory_order_release);
+    return ULOG_STATUS_OK;
+}
+
+ulog_logger_id ulog_logger_use(ulog_logger_id logger) {
+    auto previous = logger_id();
+    if (logger == ULOG_LOGGER_DEFAULT) {
+        logger_select(ULOG_LOGGER_DEFAULT);
+        return previous;
+    }
+    if (logger < 0 || logger >= logger_total_num) {
+        return ULOG_LOGGER_INVALID;
+    }
+    auto state = atomic_load_explicit(&logger_slots[logger].state,
+                                      memory_order_acquire);
+    if ((state & logger_state_phase) != logger_state_live) {
+        return ULOG_LOGGER_INVALID;  // Not added
+    }
+    logger_current = (logger_selection_t){logger, state};
+    return previous;
+}
+
+void ulog_logger_log(ulog_logger_id logger, ulog_level level, const char *file,
+                     int line, const char *topic, const char *message, ...) {
+    auto previous = logger_current;
+    if (ulog_logger_use(logger) == ULOG_LOGGER_INVALID) {
+        return;  // Not added, drop the event
+    }
+    va_list args;
+    va_start(args, message);
+    log_handle(nullptr, level, file, line, topic, false, nullptr, 0, message,
+               args);
+    va_end(args);
+    logger_current = previous;
+}
+
+#else  // ULOG_HAS_LOGGERS
+
+// Disabled Public
+// ================
+
+#if ULOG_HAS_WARN_NOT_ENABLED
+
+ulog_logger_id ulog_logger_add() {
+    warn_not_enabled("ULOG_BUILD_LOGGERS");
+    return ULOG_LOGGER_INVALID;
+}
+
+ulog_status ulog_logger_remove(ulog_logger_id logger) {
+    (void)(logger);
+    warn_not_enabled("ULOG_BUILD_LOGGERS");
+    return ULOG_STATUS_DISABLED;
+}
+
+ulog_logger_id ulog_logger_use(ulog_logger_id logger) {
+    if (logger == ULOG_LOGGER_DEFAULT) {
+        return ULOG_LOGGER_DEFAULT;  // The only instance there is
+    }
+    warn_not_enabled("ULOG_BUILD_LOGGERS");
+    return ULOG_LOGGER_INVALID;
+}
+
+#endif  // ULOG_HAS_WARN_NOT_ENABLED
+
+// Logging to the default instance works without the feature
+void ulog_logger_log(ulog_logger_id logger, ulog_level level, const char *file,
+                     int line, const char *topic, const char *message, ...) {
+    if (logger != ULOG_LOGGER_DEFAULT) {
+        return;  // Only the default instance exists
+    }
+    va_list args;
+    va_start(args, message);
+    log_handle(nullptr, level, file, line, topic, false, nullptr, 0, message,
+               args);
+    va_end(args);
+}
+
+#endif  // ULOG_HAS_LOGGERS
+
 #endif  // ULOG_BUILD_DISABLED
@@ -0,0 +1,497 @@
+// Converts a ulog binary stream (see `ulog_output_add_binary_file`) to text
+// or JSON lines. Records with a bad CRC are reported on stderr and skipped;
+// a truncated tail stops the conversion.
+//
+// Usage: ulog_binary_convert [--text|--json] [file]   (stdin if no file)
+//
+// Build (see `zig build` or `just cc-binary-convert`):
+//   cc -std=c23 tools/ulog_binary_convert.c -o ulog_binary_convert
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Mirrors the writer in src/ulog.c
+enum {
+    convert_version    = 1,
+    convert_files_max  = 64,
+    convert_topics_max = 32,
+    convert_levels_max = 256,
+    convert_body_max   = 16 * 1024,  // Writer never exceeds 1024
+};
+
+enum {
+    RECORD_FILE   = 1,
+    RECORD_TOPIC  = 2,
+    RECORD_LEVELS = 3,
+    RECORD_EVENT  = 4,
+};
+
+enum {
+    EVENT_HAS_TIME  = 1 << 0,
+    EVENT_HAS_TOPIC = 1 << 1,
+    EVENT_HAS_FILE  = 1 << 2,
+};
+
+enum {
+    FIELD_BOOL   = 0,
+    FIELD_INT    = 1,
+    FIELD_UINT   = 2,
+    FIELD_DOUBLE = 3,
+    FIELD_STRING = 4,
+    FIELD_NULL   = 0xff,
+};
+
+static constexpr uint8_t stream_magic[] = {'U', 'L', 'O', 'G', 'B'};
+
+typedef enum {
+    FORMAT_TEXT,
+    FORMAT_JSON,
+} output_format;
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+    bool error;
+} reader;
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+} bytes;
+
+typedef struct {
+    char *files[convert_files_max];
+    char *topics[convert_topics_max];
+    char *levels[convert_levels_max];
+    size_t level_count;
+} tables;
+
+static uint32_t crc32c(const uint8_t *data, size_t size) {
+    uint32_t crc = 0xffffffffU;
+    for (; size > 0; size--, data++) {
+        crc ^= *data;
+        for (auto bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0x82f63b78U & (0U - (crc & 1U)));
+        }
+    }
+    return crc ^ 0xffffffffU;
+}
+
+static uint8_t read_u8(reader *r) {
+    if (r->error || r->pos >= r->size) {
+        r->error = true;
+        return 0;
+    }
+    return r->data[r->pos++];
+}
+
+static uint64_t read_varint(reader *r) {
+    uint64_t value = 0;
+    for (auto shift = 0; shift < 64; shift += 7) {
+        auto byte = read_u8(r);
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    r->error = true;
+    return 0;
+}
+
+static int64_t read_zigzag(reader *r) {
+    auto value = read_varint(r);
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static bytes read_bytes(reader *r) {
+    auto size = read_varint(r);
+    if (r->error || size > r->size - r->pos) {
+        r->error = true;
+        return (bytes){nullptr, 0};
+    }
+    auto result = (bytes){r->data + r->pos, (size_t)size};
+    r->pos += (size_t)size;
+    return result;
+}
+
+static char *bytes_dup(bytes b) {
+    auto str = (char *)malloc(b.size + 1);
+    if (str != nullptr) {
+        memcpy(str, b.data, b.size);
+        str[b.size] = '\0';
+    }
+    return str;
+}
+
+static void tables_reset(tables *t) {
+    for (auto i = 0; i < convert_files_max; i++) {
+        free(t->files[i]);
+    }
+    for (auto i = 0; i < convert_topics_max; i++) {
+        free(t->topics[i]);
+    }
+    for (auto i = 0; i < convert_levels_max; i++) {
+        free(t->levels[i]);
+    }
+    *t = (tables){0};
+}
+
+static void table_set(char **table, size_t table_size, uint64_t id,
+                      bytes name) {
+    if (id < table_size) {
+        free(table[id]);
+        table[id] = bytes_dup(name);
+    }
+}
+
+static const char *table_get(char **table, size_t table_size, uint64_t id) {
+    return (id < table_size && table[id] != nullptr) ? table[id] : "?";
+}
+
+static void print_json_string(FILE *out, const uint8_t *str, size_t size) {
+    fputc('"', out);
+    for (size_t i = 0; i < size; i++) {
+        auto c = str[i];
+        switch (c) {
+        case '"':
+            fputs("\\\"", out);
+            break;
+        case '\\':
+            fputs("\\\\", out);
+            break;
+        case '\n':
+            fputs("\\n", out);
+            break;
+        case '\r':
+            fputs("\\r", out);
+            break;
+        case '\t':
+            fputs("\\t", out);
+            break;
+        default:
+            if (c < 0x20 || c == 0x7f) {
+                fprintf(out, "\\u%04x", c);
+            } else {
+                fputc(c, out);
+            }
+            break;
+        }
+    }
+    fputc('"', out);
+}
+
+static void print_logfmt_string(FILE *out, const uint8_t *str, size_t size) {
+    auto quote = (size == 0);
+    for (size_t i = 0; i < size && !quote; i++) {
+        quote = str[i] <= ' ' || str[i] == '"' || str[i] == '=' ||
+                str[i] == 0x7f;
+    }
+    if (!quote) {
+        fwrite(str, 1, size, out);
+        return;
+    }
+    print_json_string(out, str, size);  // Same escapes as the text output
+}
+
+static size_t trimmed_size(const char *str) {
+    auto size = strlen(str);
+    while (size > 0 && str[size - 1] == ' ') {
+        size--;
+    }
+    return size;
+}
+
+static bool convert_fields(reader *r, FILE *out, output_format format) {
+    auto count = read_varint(r);
+    for (uint64_t i = 0; i < count && !r->error; i++) {
+        auto key  = read_bytes(r);
+        auto type = read_u8(r);
+        if (format == FORMAT_JSON) {
+            fputc(',', out);
+            print_json_string(out, key.data, key.size);
+            fputc(':', out);
+        } else {
+            fputc(' ', out);
+            fwrite(key.data, 1, key.size, out);
+            fputc('=', out);
+        }
+        switch (type) {
+        case FIELD_BOOL:
+            fputs(read_u8(r) ? "true" : "false", out);
+            break;
+        case FIELD_INT:
+            fprintf(out, "%" PRId64, read_zigzag(r));
+            break;
+        case FIELD_UINT:
+            fprintf(out, "%" PRIu64, read_varint(r));
+            break;
+        case FIELD_DOUBLE: {
+            uint64_t bits = 0;
+            for (auto b = 0; b < 8; b++) {
+                bits |= (uint64_t)read_u8(r) << (8 * b);
+            }
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            if (format == FORMAT_JSON && !isfinite(value)) {
+                fputs("null", out);
+            } else {
+                fprintf(out, "%.15g", value);
+            }
+            break;
+        }
+        case FIELD_STRING: {
+            auto str = read_bytes(r);
+            format == FORMAT_JSON ? print_json_string(out, str.data, str.size)
+                                  : print_logfmt_string(out, str.data,
+                                                        str.size);
+            break;
+        }
+        case FIELD_NULL:
+            fputs("null", out);
+            break;
+        default:
+            r->error = true;
+            break;
+        }
+    }
+    return !r->error;
+}
+
+static bool convert_event(reader *r, tables *t, FILE *out,
+                          output_format format) {
+    auto flags     = read_u8(r);
+    int64_t stamp  = (flags & EVENT_HAS_TIME) ? read_zigzag(r) : 0;
+    auto level     = read_u8(r);
+    auto topic     = (bytes){nullptr, 0};
+    auto file      = (bytes){nullptr, 0};
+    int64_t line   = 0;
+    auto interned  = (const char *)nullptr;
+
+    if (flags & EVENT_HAS_TOPIC) {
+        auto ref = read_varint(r);
+        if (ref == 0) {
+            topic = read_bytes(r);
+        } else {
+            interned = table_get(t->topics, convert_topics_max, ref - 1);
+            topic    = (bytes){(const uint8_t *)interned, strlen(interned)};
+        }
+    }
+    if (flags & EVENT_HAS_FILE) {
+        auto ref = read_varint(r);
+        if (ref == 0) {
+            file = read_bytes(r);
+        } else {
+            interned = table_get(t->files, convert_files_max, ref - 1);
+            file     = (bytes){(const uint8_t *)interned, strlen(interned)};
+        }
+        line = read_zigzag(r);
+    }
+    auto message = read_bytes(r);
+    if (r->error) {
+        return false;
+    }
+
+    char time_buf[32] = {0};
+    if (flags & EVENT_HAS_TIME) {
+        auto seconds = (time_t)stamp;
+        auto tm      = localtime(&seconds);
+        if (tm != nullptr) {
+            strftime(time_buf, sizeof(time_buf),
+                     format == FORMAT_JSON ? "%Y-%m-%dT%H:%M:%S"
+                                           : "%Y-%m-%d %H:%M:%S",
+                     tm);
+        }
+    }
+    auto level_name =
+        level < t->level_count && t->levels[level] != nullptr ? t->levels[level]
+                                                              : "?";
+
+    if (format == FORMAT_JSON) {
+        fputc('{', out);
+        if (flags & EVENT_HAS_TIME) {
+            fprintf(out, "\"time\":\"%s\",", time_buf);
+        }
+        fputs("\"level\":", out);
+        print_json_string(out, (const uint8_t *)level_name,
+                          trimmed_size(level_name));
+        if (flags & EVENT_HAS_TOPIC) {
+            fputs(",\"topic\":", out);
+            print_json_string(out, topic.data, topic.size);
+        }
+        if (flags & EVENT_HAS_FILE) {
+            fputs(",\"file\":", out);
+            print_json_string(out, file.data, file.size);
+            fprintf(out, ",\"line\":%" PRId64, line);
+        }
+        fputs(",\"msg\":", out);
+        print_json_string(out, message.data, message.size);
+    } else {
+        if (flags & EVENT_HAS_TIME) {
+            fprintf(out, "%s ", time_buf);
+        }
+        fprintf(out, "%s ", level_name);
+        if (flags & EVENT_HAS_TOPIC) {
+            fprintf(out, "[%.*s] ", (int)topic.size, (const char *)topic.data);
+        }
+        if (flags & EVENT_HAS_FILE) {
+            fprintf(out, "%.*s:%" PRId64 ": ", (int)file.size,
+                    (const char *)file.data, line);
+        }
+        fwrite(message.data, 1, message.size, out);
+    }
+
+    auto fields_ok = convert_fields(r, out, format);
+    fputs(format == FORMAT_JSON ? "}\n" : "\n", out);
+    return fields_ok;
+}
+
+static bool convert_record(const uint8_t *body, size_t size, tables *t,
+                           FILE *out, output_format format) {
+    auto r = (reader){body, size, 0, false};
+    switch (read_u8(&r)) {
+    case RECORD_FILE: {
+        auto id = read_varint(&r);
+        table_set(t->files, convert_files_max, id, read_bytes(&r));
+        break;
+    }
+    case RECORD_TOPIC: {
+        auto id = read_varint(&r);
+        table_set(t->topics, convert_topics_max, id, read_bytes(&r));
+        break;
+    }
+    case RECORD_LEVELS: {
+        auto count = read_u8(&r);
+        for (size_t i = 0; i < count && !r.error; i++) {
+            table_set(t->levels, convert_levels_max, i, read_bytes(&r));
+        }
+        t->level_count = count;
+        break;
+    }
+    case RECORD_EVENT:
+        return convert_event(&r, t, out, format);
+    default:
+        break;  // Unknown record types are skipped
+    }
+    return !r.error;
+}
+
+/// @brief Reads the stream header that follows a zero record size
+static bool convert_header(FILE *in) {
+    uint8_t header[sizeof(stream_magic) + 1];
+    if (fread(header, 1, sizeof(header), in) != sizeof(header) ||
+        memcmp(header, stream_magic, sizeof(stream_magic)) != 0) {
+        fprintf(stderr, "ulog_binary_convert: not a ulog binary stream\n");
+        return false;
+    }
+    if (header[sizeof(stream_magic)] != convert_version) {
+        fprintf(stderr, "ulog_binary_convert: unsupported version %u\n",
+                header[sizeof(stream_magic)]);
+        return false;
+    }
+    return true;
+}
+
+static bool read_size(FILE *in, size_t *size, bool *eof) {
+    uint64_t value = 0;
+    for (auto shift = 0; shift < 64; shift += 7) {
+        auto c = fgetc(in);
+        if (c == EOF) {
+            *eof = (shift == 0);
+            return false;
+        }
+        value |= (uint64_t)(c & 0x7f) << shift;
+        if ((c & 0x80) == 0) {
+            *size = (size_t)value;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int convert(FILE *in, FILE *out, output_format format) {
+    static uint8_t body[convert_body_max + 4];
+    auto t          = (tables){0};
+    auto started    = false;
+    size_t bad_crcs = 0;
+
+    for (;;) {
+        size_t size = 0;
+        auto eof    = false;
+        if (!read_size(in, &size, &eof)) {
+            if (!eof) {
+                fprintf(stderr, "ulog_binary_convert: truncated record\n");
+            }
+            break;
+        }
+        if (size == 0) {
+            if (!convert_header(in)) {
+                tables_reset(&t);
+                return 1;
+            }
+            tables_reset(&t);  // New stream, ids start over
+            started = true;
+            continue;
+        }
+        if (!started) {
+            fprintf(stderr, "ulog_binary_convert: missing stream header\n");
+            return 1;
+        }
+        if (size > convert_body_max ||
+            fread(body, 1, size + 4, in) != size + 4) {
+            fprintf(stderr, "ulog_binary_convert: truncated record\n");
+            break;
+        }
+        auto crc = (uint32_t)body[size] | (uint32_t)body[size + 1] << 8 |
+                   (uint32_t)body[size + 2] << 16 |
+                   (uint32_t)body[size + 3] << 24;
+        if (crc != crc32c(body, size)) {
+            bad_crcs++;
+            continue;
+        }
+        if (!convert_record(body, size, &t, out, format)) {
+            fprintf(stderr, "ulog_binary_convert: malformed record\n");
+        }
+    }
+
+    tables_reset(&t);
+    if (bad_crcs > 0) {
+        fprintf(stderr, "ulog_binary_convert: %zu record(s) with bad CRC\n",
+                bad_crcs);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    auto format = FORMAT_TEXT;
+    auto path   = (const char *)nullptr;
+    for (auto i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            format = FORMAT_JSON;
+        } else if (strcmp(argv[i], "--text") == 0) {
+            format = FORMAT_TEXT;
+        } else if (path == nullptr && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s [--text|--json] [file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    auto in = path != nullptr ? fopen(path, "rb") : stdin;
+    if (in == nullptr) {
+        perror(path);
+        return 1;
+    }
+    auto result = convert(in, stdout, format);
+    if (in != stdin) {
+        fclose(in);
+    }
+    return result;
+}